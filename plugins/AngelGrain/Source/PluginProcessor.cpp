@@ -129,9 +129,13 @@ void AngelGrainAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBl
     float delayTimeMs = delayTimeParam->load();
     nextGrainInterval = static_cast<int>((delayTimeMs / 1000.0f) * sampleRate);
 
-    // Pre-allocate stereo buffers for real-time safety
-    wetBuffer.setSize(2, samplesPerBlock);
-    dryBuffer.setSize(2, samplesPerBlock);
+    // Pre-allocate the stereo wet buffer for real-time safety, carved from the arena
+    bufferArena.beginLayout();
+    auto wetRegion = bufferArena.reserve<float>(2, samplesPerBlock);
+    bufferArena.commit();
+    bufferArena.attach(wetBuffer, wetRegion);
+
+    DBG("AngelGrain: arena footprint " << (int) bufferArena.getFootprintBytes() << " bytes");
 }
 
 void AngelGrainAudioProcessor::releaseResources()
@@ -145,12 +149,10 @@ void AngelGrainAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, ju
 
     const int numSamples = buffer.getNumSamples();
 
-    // Ensure buffers are large enough (in case host uses different block size)
+    // Ensure the wet buffer is large enough (in case host uses different block size).
+    // This moves it off the arena onto its own heap storage until the next prepareToPlay.
     if (wetBuffer.getNumSamples() < numSamples)
-    {
         wetBuffer.setSize(2, numSamples, false, false, true);
-        dryBuffer.setSize(2, numSamples, false, false, true);
-    }
 
     // Read parameters atomically
     auto* delayTimeParam = parameters.getRawParameterValue("delayTime");
@@ -205,16 +207,9 @@ void AngelGrainAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, ju
     const float* inputL = buffer.getReadPointer(0);
     const float* inputR = buffer.getNumChannels() > 1 ? buffer.getReadPointer(1) : buffer.getReadPointer(0);
 
-    // Clear wet buffer
+    // Clear wet buffer (buffer itself keeps the dry signal until the final mix)
     wetBuffer.clear();
 
-    // Store dry signal for later mixing (preserve stereo field)
-    for (int i = 0; i < numSamples; ++i)
-    {
-        dryBuffer.setSample(0, i, inputL[i]);
-        dryBuffer.setSample(1, i, inputR[i]);
-    }
-
     // Process sample by sample
     for (int sample = 0; sample < numSamples; ++sample)
     {
@@ -309,15 +304,12 @@ void AngelGrainAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, ju
     float dryGain = 1.0f - mixValue;  // 1.0 at 0%, 0.0 at 100%
     float wetGain = mixValue;          // 0.0 at 0%, 1.0 at 100%
 
-    for (int i = 0; i < numSamples; ++i)
+    // In place, through the shared SIMD kernels
+    for (int channel = 0; channel < 2; ++channel)
     {
-        float dryL = dryBuffer.getSample(0, i);
-        float dryR = dryBuffer.getSample(1, i);
-        float wetL = wetBuffer.getSample(0, i);
-        float wetR = wetBuffer.getSample(1, i);
-
-        buffer.setSample(0, i, dryL * dryGain + wetL * wetGain);
-        buffer.setSample(1, i, dryR * dryGain + wetR * wetGain);
+        float* output = buffer.getWritePointer(channel);
+        pfs::dsp::multiplyByGain(output, dryGain, numSamples);
+        pfs::dsp::addWithGain(output, wetBuffer.getReadPointer(channel), wetGain, numSamples);
     }
 }
 
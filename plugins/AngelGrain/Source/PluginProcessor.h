@@ -1,6 +1,8 @@
 #pragma once
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
+#include "PfsDspKernels.h"
+#include "PfsInstanceArena.h"
 
 // Grain voice structure for polyphonic grain management
 struct GrainVoice
@@ -75,9 +77,9 @@ private:
     // Current sample rate for calculations
     double currentSampleRate = 44100.0;
 
-    // Pre-allocated buffers for real-time safety
+    // Pre-allocated wet buffer for real-time safety (lives in an aligned arena block)
+    pfs::InstanceArena bufferArena;
     juce::AudioBuffer<float> wetBuffer;
-    juce::AudioBuffer<float> dryBuffer;
 
     // Feedback buffer for feedback loop (stereo)
     float feedbackSampleL = 0.0f;
@@ -54,37 +54,70 @@ void AutoClipAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBloc
 
     lookaheadSamples = static_cast<int>(0.005 * sampleRate);  // 5ms in samples
 
-    lookaheadDelayL.prepare(spec);
-    lookaheadDelayR.prepare(spec);
-    lookaheadDelayL.setMaximumDelayInSamples(lookaheadSamples);
-    lookaheadDelayR.setMaximumDelayInSamples(lookaheadSamples);
-    lookaheadDelayL.reset();
-    lookaheadDelayR.reset();
+    // Both precisions are prepared so the host may pick either one;
+    // their clip-solo buffers share one arena block
+    const int numChannels = getTotalNumOutputChannels();
+    bufferArena.beginLayout();
+    const auto floatRegion = bufferArena.reserve<float>(numChannels, samplesPerBlock);
+    const auto doubleRegion = bufferArena.reserve<double>(numChannels, samplesPerBlock);
+    bufferArena.commit();
+
+    prepareSampleState(floatState, floatRegion);
+    prepareSampleState(doubleState, doubleRegion);
+
+    DBG("AutoClip: arena footprint " << (int) bufferArena.getFootprintBytes() << " bytes");
 
     // Phase 4.2: Prepare gain smoothing (50ms time constant)
     smoothedGain.reset(sampleRate, 0.05);  // 50ms smoothing
     smoothedGain.setCurrentAndTargetValue(1.0f);  // Default gain = 1.0
+}
 
-    // Phase 4.3: Preallocate original buffer for clip solo
-    originalBuffer.setSize(getTotalNumOutputChannels(), samplesPerBlock);
-    originalBuffer.clear();
+template <typename SampleType>
+void AutoClipAudioProcessor::prepareSampleState(SampleState<SampleType>& state, const pfs::InstanceArena::Region& originalRegion)
+{
+    state.lookaheadDelayL.prepare(spec);
+    state.lookaheadDelayR.prepare(spec);
+    state.lookaheadDelayL.setMaximumDelayInSamples(lookaheadSamples);
+    state.lookaheadDelayR.setMaximumDelayInSamples(lookaheadSamples);
+    state.lookaheadDelayL.reset();
+    state.lookaheadDelayR.reset();
+
+    // Phase 4.3: Preallocate original buffer for clip solo (arena memory, already zeroed)
+    bufferArena.attach(state.originalBuffer, originalRegion);
 }
 
 void AutoClipAudioProcessor::releaseResources()
 {
     // Release large buffers to save memory when plugin not in use
-    originalBuffer.setSize(0, 0);
+    floatState.originalBuffer.setSize(0, 0);
+    doubleState.originalBuffer.setSize(0, 0);
+    bufferArena.release();
 }
 
 void AutoClipAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
     juce::ignoreUnused(midiMessages);
+    processSamples(buffer);
+}
+
+void AutoClipAudioProcessor::processBlock(juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages)
+{
+    juce::ScopedNoDenormals noDenormals;
+    juce::ignoreUnused(midiMessages);
+    processSamples(buffer);
+}
+
+template <typename SampleType>
+void AutoClipAudioProcessor::processSamples(juce::AudioBuffer<SampleType>& buffer)
+{
+    auto& state = getSampleState<SampleType>();
+    auto& originalBuffer = state.originalBuffer;
 
     // Read parameters (atomic, real-time safe)
     auto* clipThresholdParam = parameters.getRawParameterValue("clipThreshold");
     float clipThresholdPercent = clipThresholdParam->load();
-    float clipThreshold = clipThresholdPercent * 0.01f;  // Convert 0-100% to 0.0-1.0
+    auto clipThreshold = static_cast<SampleType>(clipThresholdPercent * 0.01f);  // Convert 0-100% to 0.0-1.0
 
     auto* soloClippedParam = parameters.getRawParameterValue("soloClipped");
     bool soloClipped = soloClippedParam->load() > 0.5f;
@@ -93,7 +126,10 @@ void AutoClipAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce
     const int numChannels = buffer.getNumChannels();
 
     // Phase 4.3: Store original signal before processing
-    originalBuffer.setSize(numChannels, numSamples, false, false, true);
+    // (only grow: shrinking a buffer that refers into the arena would re-allocate it)
+    if (originalBuffer.getNumChannels() < numChannels || originalBuffer.getNumSamples() < numSamples)
+        originalBuffer.setSize(numChannels, numSamples, false, false, true);
+
     for (int channel = 0; channel < numChannels; ++channel)
     {
         originalBuffer.copyFrom(channel, 0, buffer, channel, 0, numSamples);
@@ -103,7 +139,7 @@ void AutoClipAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce
     for (int channel = 0; channel < numChannels; ++channel)
     {
         auto* channelData = buffer.getWritePointer(channel);
-        auto& delayLine = (channel == 0) ? lookaheadDelayL : lookaheadDelayR;
+        auto& delayLine = (channel == 0) ? state.lookaheadDelayL : state.lookaheadDelayR;
 
         // Reset peak detectors for this block
         inputPeak = 0.0f;
@@ -117,14 +153,14 @@ void AutoClipAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce
 
             // Phase 4.2: Analyze input peak from lookahead buffer (before clipping)
             // Get delayed sample from lookahead
-            float delayedSample = delayLine.popSample(channel, lookaheadSamples);
-            inputPeak = juce::jmax(inputPeak, std::abs(delayedSample));
+            SampleType delayedSample = delayLine.popSample(channel, static_cast<SampleType>(lookaheadSamples));
+            inputPeak = juce::jmax(inputPeak, static_cast<float>(std::abs(delayedSample)));
 
             // Phase 4.1: Apply hard clipping
-            float clippedSample = juce::jlimit(-clipThreshold, clipThreshold, delayedSample);
+            SampleType clippedSample = juce::jlimit(-clipThreshold, clipThreshold, delayedSample);
 
             // Phase 4.2: Analyze output peak from clipped signal
-            outputPeak = juce::jmax(outputPeak, std::abs(clippedSample));
+            outputPeak = juce::jmax(outputPeak, static_cast<float>(std::abs(clippedSample)));
 
             // Store clipped sample (will apply gain in second pass)
             channelData[sample] = clippedSample;
@@ -144,6 +180,16 @@ void AutoClipAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce
     {
         auto* channelData = buffer.getWritePointer(channel);
 
+        // Once settled the gain is one constant, so the float path takes the SIMD kernel
+        if constexpr (std::is_same_v<SampleType, float>)
+        {
+            if (!smoothedGain.isSmoothing())
+            {
+                pfs::dsp::multiplyByGain(channelData, smoothedGain.getCurrentValue(), numSamples);
+                continue;
+            }
+        }
+
         for (int sample = 0; sample < numSamples; ++sample)
         {
             float currentGain = smoothedGain.getNextValue();
@@ -1,6 +1,8 @@
 #pragma once
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
+#include "PfsDspKernels.h"
+#include "PfsInstanceArena.h"
 
 class AutoClipAudioProcessor : public juce::AudioProcessor
 {
@@ -11,6 +13,8 @@ public:
     void prepareToPlay(double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock(juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override { return true; }
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -37,10 +41,38 @@ private:
     // Parameter layout creation
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+    // Shared float/double processing path (64-bit hosts call the double overload)
+    template <typename SampleType>
+    void processSamples(juce::AudioBuffer<SampleType>& buffer);
+
+    // Per-precision sample state: lookahead delays + clip-solo copy of the input
+    template <typename SampleType>
+    struct SampleState
+    {
+        juce::dsp::DelayLine<SampleType> lookaheadDelayL { 48000 };  // Max 1 second at 48kHz
+        juce::dsp::DelayLine<SampleType> lookaheadDelayR { 48000 };
+
+        // Phase 4.3: Clip Solo (Delta Monitoring)
+        juce::AudioBuffer<SampleType> originalBuffer;
+    };
+
+    template <typename SampleType>
+    void prepareSampleState(SampleState<SampleType>& state, const pfs::InstanceArena::Region& originalRegion);
+
+    template <typename SampleType>
+    SampleState<SampleType>& getSampleState()
+    {
+        if constexpr (std::is_same_v<SampleType, double>)
+            return doubleState;
+        else
+            return floatState;
+    }
+
     // DSP Components (Phase 4.1: Core Processing)
     juce::dsp::ProcessSpec spec;
-    juce::dsp::DelayLine<float> lookaheadDelayL { 48000 };  // Max 1 second at 48kHz
-    juce::dsp::DelayLine<float> lookaheadDelayR { 48000 };
+    SampleState<float> floatState;
+    SampleState<double> doubleState;
+    pfs::InstanceArena bufferArena;  // backs both originalBuffers (one aligned block)
     int lookaheadSamples = 0;
 
     // Phase 4.2: Automatic Gain Matching
@@ -48,8 +80,5 @@ private:
     float inputPeak = 0.0f;
     float outputPeak = 0.0f;
 
-    // Phase 4.3: Clip Solo (Delta Monitoring)
-    juce::AudioBuffer<float> originalBuffer;
-
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AutoClipAudioProcessor)
 };
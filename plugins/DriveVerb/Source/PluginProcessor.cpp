@@ -84,30 +84,63 @@ void DriveVerbAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlo
     // Prepare reverb
     reverb.prepare(spec);
 
+    // Double-precision hosts: reverb input/output converted through this buffer
+    scratchArena.beginLayout();
+    const auto scratchRegion = scratchArena.reserve<float>(static_cast<int>(spec.numChannels), samplesPerBlock);
+    scratchArena.commit();
+    scratchArena.attach(reverbScratch, scratchRegion);
+    DBG("DriveVerb: arena footprint " << (int) scratchArena.getFootprintBytes() << " bytes");
+
+    // Both precisions are prepared so the host may pick either one
+    preparePath(floatPath, spec);
+    preparePath(doublePath, spec);
+}
+
+template <typename SampleType>
+void DriveVerbAudioProcessor::preparePath(SamplePath<SampleType>& path, const juce::dsp::ProcessSpec& spec)
+{
     // Prepare dry/wet mixer
-    dryWetMixer.prepare(spec);
-    dryWetMixer.setMixingRule(juce::dsp::DryWetMixingRule::balanced); // Equal-power mixing
+    path.dryWetMixer.prepare(spec);
+    path.dryWetMixer.setMixingRule(juce::dsp::DryWetMixingRule::balanced); // Equal-power mixing
 
     // Prepare drive waveshaper with tanh transfer function (Stage 4.2)
-    driveShaper.prepare(spec);
-    driveShaper.functionToUse = [](float sample) { return std::tanh(sample); };
+    path.driveShaper.prepare(spec);
+    path.driveShaper.functionToUse = [](SampleType sample) { return std::tanh(sample); };
 
     // Prepare DJ-style filter (Stage 4.3)
-    filterProcessor.prepare(spec);
+    path.filterProcessor.prepare(spec);
 }
 
 void DriveVerbAudioProcessor::releaseResources()
 {
     reverb.reset();
-    dryWetMixer.reset();
-    driveShaper.reset();
-    filterProcessor.reset();
+
+    floatPath.dryWetMixer.reset();
+    floatPath.driveShaper.reset();
+    floatPath.filterProcessor.reset();
+    doublePath.dryWetMixer.reset();
+    doublePath.driveShaper.reset();
+    doublePath.filterProcessor.reset();
 }
 
 void DriveVerbAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
     juce::ignoreUnused(midiMessages);
+    processSamples(buffer);
+}
+
+void DriveVerbAudioProcessor::processBlock(juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages)
+{
+    juce::ScopedNoDenormals noDenormals;
+    juce::ignoreUnused(midiMessages);
+    processSamples(buffer);
+}
+
+template <typename SampleType>
+void DriveVerbAudioProcessor::processSamples(juce::AudioBuffer<SampleType>& buffer)
+{
+    auto& dryWetMixer = getPath<SampleType>().dryWetMixer;
 
     // Get current parameter values (atomic reads, real-time safe)
     auto* sizeParam = parameters.getRawParameterValue("size");
@@ -144,14 +177,14 @@ void DriveVerbAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juc
     dryWetMixer.setWetMixProportion(dryWetValue / 100.0f);
 
     // Create audio block for DSP processing
-    juce::dsp::AudioBlock<float> block(buffer);
-    juce::dsp::ProcessContextReplacing<float> context(block);
+    juce::dsp::AudioBlock<SampleType> block(buffer);
+    juce::dsp::ProcessContextReplacing<SampleType> context(block);
 
     // Push dry signal into mixer
     dryWetMixer.pushDrySamples(block);
 
     // Process reverb
-    reverb.process(context);
+    processReverb(block);
 
     // Stage 4.4: PRE/POST routing - apply drive and filter in different orders
     // PRE mode (filterPosition=0.0): Filter → Drive
@@ -174,7 +207,57 @@ void DriveVerbAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juc
     dryWetMixer.mixWetSamples(block);
 }
 
-void DriveVerbAudioProcessor::applyDrive(juce::dsp::AudioBlock<float>& block, juce::dsp::ProcessContextReplacing<float>& context, float driveValue)
+template <typename SampleType>
+void DriveVerbAudioProcessor::processReverb(juce::dsp::AudioBlock<SampleType>& block)
+{
+    if constexpr (std::is_same_v<SampleType, float>)
+    {
+        juce::dsp::ProcessContextReplacing<float> context(block);
+        reverb.process(context);
+    }
+    else
+    {
+        // Reverb runs wet-only (dryLevel = 0), so only the reverb itself sees
+        // float precision — the dry path, drive and filter stay double
+        // reverbScratch holds one prepared block, so longer host blocks go through
+        // it in chunks; the reverb's state carries over between them
+        const auto numChannels = juce::jmin(block.getNumChannels(), static_cast<size_t>(reverbScratch.getNumChannels()));
+        const auto numSamples = block.getNumSamples();
+        const auto chunkSize = static_cast<size_t>(reverbScratch.getNumSamples());
+
+        for (size_t start = 0; start < numSamples && chunkSize > 0; start += chunkSize)
+        {
+            const auto count = juce::jmin(chunkSize, numSamples - start);
+
+            for (size_t channel = 0; channel < numChannels; ++channel)
+            {
+                const auto* source = block.getChannelPointer(channel) + start;
+                auto* scratch = reverbScratch.getWritePointer(static_cast<int>(channel));
+
+                for (size_t sample = 0; sample < count; ++sample)
+                    scratch[sample] = static_cast<float>(source[sample]);
+            }
+
+            auto scratchBlock = juce::dsp::AudioBlock<float>(reverbScratch)
+                                    .getSubsetChannelBlock(0, numChannels)
+                                    .getSubBlock(0, count);
+            juce::dsp::ProcessContextReplacing<float> context(scratchBlock);
+            reverb.process(context);
+
+            for (size_t channel = 0; channel < numChannels; ++channel)
+            {
+                const auto* scratch = reverbScratch.getReadPointer(static_cast<int>(channel));
+                auto* destination = block.getChannelPointer(channel) + start;
+
+                for (size_t sample = 0; sample < count; ++sample)
+                    destination[sample] = static_cast<SampleType>(scratch[sample]);
+            }
+        }
+    }
+}
+
+template <typename SampleType>
+void DriveVerbAudioProcessor::applyDrive(juce::dsp::AudioBlock<SampleType>& block, juce::dsp::ProcessContextReplacing<SampleType>& context, float driveValue)
 {
     // Apply drive to wet signal (Stage 4.2)
     // Convert dB to linear gain: gain = 10^(dB/20)
@@ -184,23 +267,39 @@ void DriveVerbAudioProcessor::applyDrive(juce::dsp::AudioBlock<float>& block, ju
     for (size_t channel = 0; channel < block.getNumChannels(); ++channel)
     {
         auto* channelData = block.getChannelPointer(channel);
-        for (size_t sample = 0; sample < block.getNumSamples(); ++sample)
+
+        if constexpr (std::is_same_v<SampleType, float>)
         {
-            channelData[sample] *= driveGain;
+            pfs::dsp::multiplyByGain(channelData, driveGain, static_cast<int>(block.getNumSamples()));
+        }
+        else
+        {
+            for (size_t sample = 0; sample < block.getNumSamples(); ++sample)
+            {
+                channelData[sample] *= driveGain;
+            }
         }
     }
 
     // Apply tanh waveshaping (tape-like saturation)
-    driveShaper.process(context);
+    getPath<SampleType>().driveShaper.process(context);
 
     // Measure output level for VU meter (after waveshaping)
     float maxLevel = 0.0f;
     for (size_t channel = 0; channel < block.getNumChannels(); ++channel)
     {
-        const float* channelData = block.getChannelPointer(channel);
-        for (size_t sample = 0; sample < block.getNumSamples(); ++sample)
+        const SampleType* channelData = block.getChannelPointer(channel);
+
+        if constexpr (std::is_same_v<SampleType, float>)
         {
-            maxLevel = std::max(maxLevel, std::abs(channelData[sample]));
+            maxLevel = std::max(maxLevel, pfs::dsp::peakAbs(channelData, static_cast<int>(block.getNumSamples())));
+        }
+        else
+        {
+            for (size_t sample = 0; sample < block.getNumSamples(); ++sample)
+            {
+                maxLevel = std::max(maxLevel, static_cast<float>(std::abs(channelData[sample])));
+            }
         }
     }
 
@@ -211,8 +310,11 @@ void DriveVerbAudioProcessor::applyDrive(juce::dsp::AudioBlock<float>& block, ju
     driveOutputLevelDB.store(levelDB);
 }
 
-void DriveVerbAudioProcessor::applyFilter(juce::dsp::AudioBlock<float>& block, juce::dsp::ProcessContextReplacing<float>& context, float filterValue)
+template <typename SampleType>
+void DriveVerbAudioProcessor::applyFilter(juce::dsp::AudioBlock<SampleType>& block, juce::dsp::ProcessContextReplacing<SampleType>& context, float filterValue)
 {
+    auto& filterProcessor = getPath<SampleType>().filterProcessor;
+
     // Apply DJ-style filter (Stage 4.3)
     // Center bypass zone: ±0.5% = no filtering (prevents filter artifacts at bypass)
     if (std::abs(filterValue) > 0.5f)
@@ -235,7 +337,7 @@ void DriveVerbAudioProcessor::applyFilter(juce::dsp::AudioBlock<float>& block, j
             float normalizedValue = std::abs(filterValue) / 100.0f; // 0.0 to 1.0
             float cutoffHz = 20000.0f * std::pow(10.0f, -normalizedValue * std::log10(20000.0f / 200.0f));
 
-            *filterProcessor.state = *juce::dsp::IIR::Coefficients<float>::makeLowPass(
+            *filterProcessor.state = *juce::dsp::IIR::Coefficients<SampleType>::makeLowPass(
                 sampleRate, juce::jlimit(200.0f, 20000.0f, cutoffHz), 0.707f
             );
         }
@@ -246,7 +348,7 @@ void DriveVerbAudioProcessor::applyFilter(juce::dsp::AudioBlock<float>& block, j
             float normalizedValue = filterValue / 100.0f; // 0.0 to 1.0
             float cutoffHz = 20.0f * std::pow(10.0f, normalizedValue * std::log10(10000.0f / 20.0f));
 
-            *filterProcessor.state = *juce::dsp::IIR::Coefficients<float>::makeHighPass(
+            *filterProcessor.state = *juce::dsp::IIR::Coefficients<SampleType>::makeHighPass(
                 sampleRate, juce::jlimit(20.0f, 10000.0f, cutoffHz), 0.707f
             );
         }
@@ -1,6 +1,8 @@
 #pragma once
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
+#include "PfsDspKernels.h"
+#include "PfsInstanceArena.h"
 
 class DriveVerbAudioProcessor : public juce::AudioProcessor
 {
@@ -11,6 +13,8 @@ public:
     void prepareToPlay(double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock(juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override { return true; }
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -41,20 +45,52 @@ private:
     // Parameter layout creation
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
-    // DSP Components (Stage 4.1: Core reverb + dry/wet mixing)
-    juce::dsp::Reverb reverb;
-    juce::dsp::DryWetMixer<float> dryWetMixer;
+    // Shared float/double processing path (64-bit hosts call the double overload)
+    template <typename SampleType>
+    void processSamples(juce::AudioBuffer<SampleType>& buffer);
+
+    // Sample-carrying DSP, one instance per processing precision
+    template <typename SampleType>
+    struct SamplePath
+    {
+        juce::dsp::DryWetMixer<SampleType> dryWetMixer;
+
+        // Stage 4.2: Drive saturation
+        juce::dsp::WaveShaper<SampleType> driveShaper;
+
+        // Stage 4.3: DJ-style filter (low-pass/high-pass with center bypass)
+        juce::dsp::ProcessorDuplicator<juce::dsp::IIR::Filter<SampleType>, juce::dsp::IIR::Coefficients<SampleType>> filterProcessor;
+    };
 
-    // Stage 4.2: Drive saturation
-    juce::dsp::WaveShaper<float> driveShaper;
+    template <typename SampleType>
+    void preparePath(SamplePath<SampleType>& path, const juce::dsp::ProcessSpec& spec);
 
-    // Stage 4.3: DJ-style filter (low-pass/high-pass with center bypass)
-    juce::dsp::ProcessorDuplicator<juce::dsp::IIR::Filter<float>, juce::dsp::IIR::Coefficients<float>> filterProcessor;
+    template <typename SampleType>
+    SamplePath<SampleType>& getPath()
+    {
+        if constexpr (std::is_same_v<SampleType, double>)
+            return doublePath;
+        else
+            return floatPath;
+    }
+
+    // DSP Components (Stage 4.1: Core reverb + dry/wet mixing)
+    // juce::dsp::Reverb is float-only: the double path runs it on reverbScratch
+    juce::dsp::Reverb reverb;
+    juce::AudioBuffer<float> reverbScratch;
+    pfs::InstanceArena scratchArena;  // aligned storage behind reverbScratch
+    SamplePath<float> floatPath;
+    SamplePath<double> doublePath;
     bool previousWasLowPass = false;  // Track filter type transitions
 
+    template <typename SampleType>
+    void processReverb(juce::dsp::AudioBlock<SampleType>& block);
+
     // Stage 4.4: Helper methods for PRE/POST routing
-    void applyDrive(juce::dsp::AudioBlock<float>& block, juce::dsp::ProcessContextReplacing<float>& context, float driveValue);
-    void applyFilter(juce::dsp::AudioBlock<float>& block, juce::dsp::ProcessContextReplacing<float>& context, float filterValue);
+    template <typename SampleType>
+    void applyDrive(juce::dsp::AudioBlock<SampleType>& block, juce::dsp::ProcessContextReplacing<SampleType>& context, float driveValue);
+    template <typename SampleType>
+    void applyFilter(juce::dsp::AudioBlock<SampleType>& block, juce::dsp::ProcessContextReplacing<SampleType>& context, float filterValue);
 
     // VU meter - drive output level
     std::atomic<float> driveOutputLevelDB { -60.0f };
@@ -1,4 +1,5 @@
 #include "DrumRouletteVoice.h"
+#include "PfsDspKernels.h"
 #include <juce_audio_formats/juce_audio_formats.h>
 
 DrumRouletteVoice::DrumRouletteVoice(int slotNum)
@@ -165,62 +166,69 @@ void DrumRouletteVoice::renderNextBlock(juce::AudioBuffer<float>& outputBuffer,
     const bool renderToMix = shouldRenderToMainMix();
     const float soloMuteGain = renderToMix ? 1.0f : 0.0f;
 
-    const int numChannels = juce::jmin(outputBuffer.getNumChannels(), sampleBuffer.getNumChannels());
+    const int numChannels = juce::jmin(outputBuffer.getNumChannels(), sampleBuffer.getNumChannels(), maxRenderChannels);
     const int sampleLength = sampleBuffer.getNumSamples();
 
-    for (int sample = 0; sample < numSamples; ++sample)
-    {
-        const int intPosition = static_cast<int>(currentPosition);
-
-        // Check if sample finished playing
-        if (intPosition >= sampleLength - 1)
-        {
-            isActive = false;
-            clearCurrentNote();
-            break;
-        }
+    // Pitched reads go through the shared SIMD kernel a chunk at a time. The
+    // envelope and tilt filters after them are recursive, so they stay per sample.
+    float interpolated[maxRenderChannels][renderChunkSize];
 
-        // Get envelope value for this sample (Phase 4.2)
-        const float envelopeValue = envelope.getNextSample();
+    for (int chunkStart = 0; chunkStart < numSamples; chunkStart += renderChunkSize)
+    {
+        const int chunkLength = juce::jmin(renderChunkSize, numSamples - chunkStart);
 
         // Linear interpolation for pitch shifting (Phase 4.2)
-        const float frac = currentPosition - static_cast<float>(intPosition);
-
         for (int channel = 0; channel < numChannels; ++channel)
         {
-            const float sample0 = sampleBuffer.getSample(channel, intPosition);
-            const float sample1 = sampleBuffer.getSample(channel, intPosition + 1);
-
-            // Interpolate between adjacent samples
-            float interpolatedSample = sample0 + frac * (sample1 - sample0);
+            pfs::dsp::linearInterpolate(interpolated[channel], sampleBuffer.getReadPointer(channel), sampleLength,
+                                        currentPosition, pitchRatio, chunkLength);
+        }
 
-            // Apply velocity and envelope
-            float outputValue = interpolatedSample * noteVelocity * envelopeValue;
+        for (int sample = 0; sample < chunkLength; ++sample)
+        {
+            const int intPosition = static_cast<int>(currentPosition);
 
-            // Apply tilt filter (Phase 4.3)
-            if (tiltFilterParam != nullptr)
+            // Check if sample finished playing
+            if (intPosition >= sampleLength - 1)
             {
-                // Process single sample through filters
-                outputValue = lowShelfFilter.processSample(outputValue);
-                outputValue = highShelfFilter.processSample(outputValue);
+                isActive = false;
+                clearCurrentNote();
+                return;
             }
 
-            // Apply volume control (Phase 4.3)
-            if (volumeParam != nullptr)
+            // Get envelope value for this sample (Phase 4.2)
+            const float envelopeValue = envelope.getNextSample();
+
+            for (int channel = 0; channel < numChannels; ++channel)
             {
-                float volumeDb = volumeParam->load();
-                float volumeGainValue = juce::Decibels::decibelsToGain(volumeDb, -100.0f);
-                outputValue *= volumeGainValue;
+                // Apply velocity and envelope
+                float outputValue = interpolated[channel][sample] * noteVelocity * envelopeValue;
+
+                // Apply tilt filter (Phase 4.3)
+                if (tiltFilterParam != nullptr)
+                {
+                    // Process single sample through filters
+                    outputValue = lowShelfFilter.processSample(outputValue);
+                    outputValue = highShelfFilter.processSample(outputValue);
+                }
+
+                // Apply volume control (Phase 4.3)
+                if (volumeParam != nullptr)
+                {
+                    float volumeDb = volumeParam->load();
+                    float volumeGainValue = juce::Decibels::decibelsToGain(volumeDb, -100.0f);
+                    outputValue *= volumeGainValue;
+                }
+
+                // Phase 4.4: Apply solo/mute gain to main mix
+                outputValue *= soloMuteGain;
+
+                outputBuffer.addSample(channel, startSample + chunkStart + sample, outputValue);
             }
 
-            // Phase 4.4: Apply solo/mute gain to main mix
-            outputValue *= soloMuteGain;
-
-            outputBuffer.addSample(channel, startSample + sample, outputValue);
+            // Advance position by pitch ratio (Phase 4.2)
+            currentPosition += pitchRatio;
         }
-
-        // Advance position by pitch ratio (Phase 4.2)
-        currentPosition += pitchRatio;
     }
 }
 
@@ -26,6 +26,10 @@ public:
     bool shouldRenderToMainMix() const;
 
 private:
+    // renderNextBlock() interpolates this many samples per kernel call, on the stack
+    static constexpr int maxRenderChannels = 2;   // the main output is stereo
+    static constexpr int renderChunkSize = 64;
+
     int slotNumber;
     juce::AudioSampleBuffer sampleBuffer;
     double currentPosition = 0.0;
@@ -91,34 +91,50 @@ void FlutterVerbAudioProcessor::prepareToPlay(double sampleRate, int samplesPerB
     spec.maximumBlockSize = static_cast<juce::uint32>(samplesPerBlock);
     spec.numChannels = static_cast<juce::uint32>(getTotalNumOutputChannels());
 
-    // Phase 4.1: Prepare core reverb processing components
-    dryWetMixer.prepare(spec);
-    dryWetMixer.reset();
-
-    // Fix 2: Set wet path latency compensation for modulation delay (50ms base delay)
-    float baseDelayMs = 50.0f;
-    int latencySamples = static_cast<int>((baseDelayMs / 1000.0f) * sampleRate);
-    dryWetMixer.setWetLatency(latencySamples);
-
     // Prepare reverb with ProcessSpec
     reverb.prepare(spec);
     reverb.reset();
 
-    // Phase 4.2: Prepare modulation system
-    modulationDelay.prepare(spec);
-    modulationDelay.reset();
-    modulationDelay.setMaximumDelayInSamples(static_cast<int>(sampleRate * 0.2)); // 200ms max
+    // Double-precision hosts: reverb input/output converted through this buffer
+    scratchArena.beginLayout();
+    const auto scratchRegion = scratchArena.reserve<float>(static_cast<int>(spec.numChannels), samplesPerBlock);
+    scratchArena.commit();
+    scratchArena.attach(reverbScratch, scratchRegion);
+    DBG("FlutterVerb: arena footprint " << (int) scratchArena.getFootprintBytes() << " bytes");
+
+    // Both precisions are prepared so the host may pick either one
+    preparePath(floatPath);
+    preparePath(doublePath);
 
     // Initialize per-channel LFO phase tracking
     wowPhase.resize(spec.numChannels, 0.0f);
     flutterPhase.resize(spec.numChannels, 0.0f);
 
-    // Phase 4.3: Prepare filter
-    toneFilter.prepare(spec);
-    toneFilter.reset();
     currentFilterType = FilterType::None;
 }
 
+template <typename SampleType>
+void FlutterVerbAudioProcessor::preparePath(SamplePath<SampleType>& path)
+{
+    // Phase 4.1: Prepare core reverb processing components
+    path.dryWetMixer.prepare(spec);
+    path.dryWetMixer.reset();
+
+    // Fix 2: Set wet path latency compensation for modulation delay (50ms base delay)
+    float baseDelayMs = 50.0f;
+    int latencySamples = static_cast<int>((baseDelayMs / 1000.0f) * spec.sampleRate);
+    path.dryWetMixer.setWetLatency(static_cast<SampleType>(latencySamples));
+
+    // Phase 4.2: Prepare modulation system
+    path.modulationDelay.prepare(spec);
+    path.modulationDelay.reset();
+    path.modulationDelay.setMaximumDelayInSamples(static_cast<int>(spec.sampleRate * 0.2)); // 200ms max
+
+    // Phase 4.3: Prepare filter
+    path.toneFilter.prepare(spec);
+    path.toneFilter.reset();
+}
+
 void FlutterVerbAudioProcessor::releaseResources()
 {
     // DSP cleanup will be added in Stage 4
@@ -128,6 +144,23 @@ void FlutterVerbAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, j
 {
     juce::ScopedNoDenormals noDenormals;
     juce::ignoreUnused(midiMessages);
+    processSamples(buffer);
+}
+
+void FlutterVerbAudioProcessor::processBlock(juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages)
+{
+    juce::ScopedNoDenormals noDenormals;
+    juce::ignoreUnused(midiMessages);
+    processSamples(buffer);
+}
+
+template <typename SampleType>
+void FlutterVerbAudioProcessor::processSamples(juce::AudioBuffer<SampleType>& buffer)
+{
+    auto& path = getPath<SampleType>();
+    auto& dryWetMixer = path.dryWetMixer;
+    auto& modulationDelay = path.modulationDelay;
+    auto& toneFilter = path.toneFilter;
 
     // Clear unused channels
     for (int i = getTotalNumInputChannels(); i < getTotalNumOutputChannels(); ++i)
@@ -182,7 +215,7 @@ void FlutterVerbAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, j
     dryWetMixer.setWetMixProportion(mixValue);
 
     // Process audio with DSP pipeline
-    juce::dsp::AudioBlock<float> block(buffer);
+    juce::dsp::AudioBlock<SampleType> block(buffer);
 
     // Phase 4.4: Define modulation processing function (reusable for both routing modes)
     auto applyModulation = [&]() {
@@ -223,15 +256,16 @@ void FlutterVerbAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, j
                     totalModulation *= scaledAge;
 
                     // Calculate modulated delay time in samples
-                    float baseDelaySamples = (baseDelayMs / 1000.0f) * static_cast<float>(currentSampleRate);
-                    float modulationAmount = baseDelaySamples * maxModDepth * totalModulation;  // ±20% depth
-                    float delayTimeSamples = baseDelaySamples + modulationAmount;
+                    // (in SampleType so the double path keeps a 64-bit read position)
+                    const auto baseDelaySamples = static_cast<SampleType>(baseDelayMs / 1000.0f) * static_cast<SampleType>(currentSampleRate);
+                    const auto modulationAmount = baseDelaySamples * static_cast<SampleType>(maxModDepth * totalModulation);  // ±20% depth
+                    SampleType delayTimeSamples = baseDelaySamples + modulationAmount;
 
                     // Ensure delay time is within valid range
-                    delayTimeSamples = juce::jlimit(1.0f, static_cast<float>(currentSampleRate * 0.2), delayTimeSamples);
+                    delayTimeSamples = juce::jlimit(static_cast<SampleType>(1), static_cast<SampleType>(currentSampleRate * 0.2), delayTimeSamples);
 
                     // Set delay time for this channel
-                    modulationDelay.setDelay(static_cast<float>(delayTimeSamples));
+                    modulationDelay.setDelay(delayTimeSamples);
 
                     // Process sample through delay line
                     modulationDelay.pushSample(channel, channelData[sample]);
@@ -296,7 +330,7 @@ void FlutterVerbAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, j
                 float cutoffHz = 20000.0f * std::pow(10.0f, -normalizedValue * std::log10(100.0f));
                 cutoffHz = juce::jlimit(200.0f, 20000.0f, cutoffHz);
 
-                *toneFilter.state = *juce::dsp::IIR::Coefficients<float>::makeLowPass(
+                *toneFilter.state = *juce::dsp::IIR::Coefficients<SampleType>::makeLowPass(
                     sampleRate, cutoffHz, 0.707f  // Q = 0.707 (Butterworth)
                 );
             }
@@ -308,14 +342,14 @@ void FlutterVerbAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, j
                 float cutoffHz = 20.0f * std::pow(10.0f, normalizedValue * std::log10(500.0f));
                 cutoffHz = juce::jlimit(20.0f, 10000.0f, cutoffHz);
 
-                *toneFilter.state = *juce::dsp::IIR::Coefficients<float>::makeHighPass(
+                *toneFilter.state = *juce::dsp::IIR::Coefficients<SampleType>::makeHighPass(
                     sampleRate, cutoffHz, 0.707f  // Q = 0.707 (Butterworth)
                 );
             }
 
             // Process buffer through filter
-            juce::dsp::AudioBlock<float> filterBlock(buffer);
-            juce::dsp::ProcessContextReplacing<float> filterContext(filterBlock);
+            juce::dsp::AudioBlock<SampleType> filterBlock(buffer);
+            juce::dsp::ProcessContextReplacing<SampleType> filterContext(filterBlock);
             toneFilter.process(filterContext);
         }
         else
@@ -342,8 +376,7 @@ void FlutterVerbAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, j
     dryWetMixer.pushDrySamples(block);
 
     // Process reverb using modern DSP API
-    juce::dsp::ProcessContextReplacing<float> context(block);
-    reverb.process(context);
+    processReverb(block);
 
     if (!wetDryMode)
     {
@@ -361,10 +394,18 @@ void FlutterVerbAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, j
     float peakLevel = 0.0f;
     for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
     {
-        const float* channelData = buffer.getReadPointer(channel);
-        for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
+        const SampleType* channelData = buffer.getReadPointer(channel);
+
+        if constexpr (std::is_same_v<SampleType, float>)
         {
-            peakLevel = juce::jmax(peakLevel, std::abs(channelData[sample]));
+            peakLevel = juce::jmax(peakLevel, pfs::dsp::peakAbs(channelData, buffer.getNumSamples()));
+        }
+        else
+        {
+            for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
+            {
+                peakLevel = juce::jmax(peakLevel, static_cast<float>(std::abs(channelData[sample])));
+            }
         }
     }
 
@@ -375,6 +416,55 @@ void FlutterVerbAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, j
     outputLevel.store(peakDb, std::memory_order_relaxed);
 }
 
+template <typename SampleType>
+void FlutterVerbAudioProcessor::processReverb(juce::dsp::AudioBlock<SampleType>& block)
+{
+    if constexpr (std::is_same_v<SampleType, float>)
+    {
+        juce::dsp::ProcessContextReplacing<float> context(block);
+        reverb.process(context);
+    }
+    else
+    {
+        // Reverb is wet-only (dryLevel = 0), so converting just this stage keeps
+        // the dry path, modulation delay, drive and tone filter in double
+        // reverbScratch holds one prepared block, so longer host blocks go through
+        // it in chunks; the reverb's state carries over between them
+        const auto numChannels = juce::jmin(block.getNumChannels(), static_cast<size_t>(reverbScratch.getNumChannels()));
+        const auto numSamples = block.getNumSamples();
+        const auto chunkSize = static_cast<size_t>(reverbScratch.getNumSamples());
+
+        for (size_t start = 0; start < numSamples && chunkSize > 0; start += chunkSize)
+        {
+            const auto count = juce::jmin(chunkSize, numSamples - start);
+
+            for (size_t channel = 0; channel < numChannels; ++channel)
+            {
+                const auto* source = block.getChannelPointer(channel) + start;
+                auto* scratch = reverbScratch.getWritePointer(static_cast<int>(channel));
+
+                for (size_t sample = 0; sample < count; ++sample)
+                    scratch[sample] = static_cast<float>(source[sample]);
+            }
+
+            auto scratchBlock = juce::dsp::AudioBlock<float>(reverbScratch)
+                                    .getSubsetChannelBlock(0, numChannels)
+                                    .getSubBlock(0, count);
+            juce::dsp::ProcessContextReplacing<float> context(scratchBlock);
+            reverb.process(context);
+
+            for (size_t channel = 0; channel < numChannels; ++channel)
+            {
+                const auto* scratch = reverbScratch.getReadPointer(static_cast<int>(channel));
+                auto* destination = block.getChannelPointer(channel) + start;
+
+                for (size_t sample = 0; sample < count; ++sample)
+                    destination[sample] = static_cast<SampleType>(scratch[sample]);
+            }
+        }
+    }
+}
+
 juce::AudioProcessorEditor* FlutterVerbAudioProcessor::createEditor()
 {
     return new FlutterVerbAudioProcessorEditor(*this);
@@ -1,6 +1,8 @@
 #pragma once
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
+#include "PfsDspKernels.h"
+#include "PfsInstanceArena.h"
 
 class FlutterVerbAudioProcessor : public juce::AudioProcessor
 {
@@ -11,6 +13,8 @@ public:
     void prepareToPlay(double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock(juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override { return true; }
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -34,21 +38,54 @@ public:
     juce::AudioProcessorValueTreeState& getAPVTS() { return parameters; }
 
 private:
+    // Shared float/double processing path (64-bit hosts call the double overload)
+    template <typename SampleType>
+    void processSamples(juce::AudioBuffer<SampleType>& buffer);
+
+    // Sample-carrying DSP, one instance per processing precision.
+    // In the double path the modulation delay (read position included) stays 64-bit.
+    template <typename SampleType>
+    struct SamplePath
+    {
+        juce::dsp::DryWetMixer<SampleType> dryWetMixer;
+        juce::dsp::DelayLine<SampleType, juce::dsp::DelayLineInterpolationTypes::Lagrange3rd> modulationDelay { 9600 }; // 200ms at 48kHz
+        juce::dsp::ProcessorDuplicator<juce::dsp::IIR::Filter<SampleType>, juce::dsp::IIR::Coefficients<SampleType>> toneFilter;
+    };
+
+    template <typename SampleType>
+    void preparePath(SamplePath<SampleType>& path);
+
+    template <typename SampleType>
+    SamplePath<SampleType>& getPath()
+    {
+        if constexpr (std::is_same_v<SampleType, double>)
+            return doublePath;
+        else
+            return floatPath;
+    }
+
+    template <typename SampleType>
+    void processReverb(juce::dsp::AudioBlock<SampleType>& block);
+
     // DSP Components (declare BEFORE parameters for initialization order)
     juce::dsp::ProcessSpec spec;
 
     // Phase 4.1: Core Reverb Processing
+    // juce::dsp::Reverb is float-only: the double path runs it on reverbScratch
     juce::dsp::Reverb reverb;
-    juce::dsp::DryWetMixer<float> dryWetMixer;
+    juce::AudioBuffer<float> reverbScratch;
+    pfs::InstanceArena scratchArena;  // aligned storage behind reverbScratch
+
+    // Phase 4.1-4.3: dry/wet mixer, modulation delay and tone filter per precision
+    SamplePath<float> floatPath;
+    SamplePath<double> doublePath;
 
     // Phase 4.2: Modulation System
-    juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::Lagrange3rd> modulationDelay { 9600 }; // 200ms at 48kHz
     std::vector<float> wowPhase;    // Per-channel wow LFO phase (0-2π)
     std::vector<float> flutterPhase; // Per-channel flutter LFO phase (0-2π)
     double currentSampleRate = 44100.0; // Store sample rate for LFO calculations
 
     // Phase 4.3: Saturation and Filter
-    juce::dsp::ProcessorDuplicator<juce::dsp::IIR::Filter<float>, juce::dsp::IIR::Coefficients<float>> toneFilter;
     enum class FilterType { None, LowPass, HighPass };
     FilterType currentFilterType = FilterType::None;
 
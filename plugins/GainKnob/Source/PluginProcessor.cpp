@@ -56,8 +56,10 @@ void GainKnobAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBloc
     spec.maximumBlockSize = static_cast<juce::uint32>(samplesPerBlock);
     spec.numChannels = static_cast<juce::uint32>(getTotalNumOutputChannels());
 
+    // Both precisions are prepared so the host may pick either one
     filterProcessor.prepare(spec);
-    filterProcessor.reset();
+    filterProcessorDouble.prepare(spec);
+    resetFilters();
 }
 
 void GainKnobAudioProcessor::releaseResources()
@@ -69,6 +71,20 @@ void GainKnobAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce
 {
     juce::ScopedNoDenormals noDenormals;
     juce::ignoreUnused(midiMessages);
+    processSamples(buffer);
+}
+
+void GainKnobAudioProcessor::processBlock(juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages)
+{
+    juce::ScopedNoDenormals noDenormals;
+    juce::ignoreUnused(midiMessages);
+    processSamples(buffer);
+}
+
+template <typename SampleType>
+void GainKnobAudioProcessor::processSamples(juce::AudioBuffer<SampleType>& buffer)
+{
+    auto& filter = getFilterProcessor<SampleType>();
 
     // Read GAIN parameter (atomic read, real-time safe)
     auto* gainParam = parameters.getRawParameterValue("GAIN");
@@ -90,7 +106,7 @@ void GainKnobAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce
         // Reset filter state when switching between low-pass and high-pass
         // Prevents burst caused by residual energy in delay buffers
         if (isLowPass != previousWasLowPass) {
-            filterProcessor.reset();
+            filter.reset();
         }
         previousWasLowPass = isLowPass;
 
@@ -101,7 +117,7 @@ void GainKnobAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce
             float normalizedValue = std::abs(filterPercent) / 100.0f; // 0.0 to 1.0
             float cutoffHz = 20000.0f * std::pow(10.0f, -normalizedValue * std::log10(20000.0f / 200.0f));
 
-            *filterProcessor.state = *juce::dsp::IIR::Coefficients<float>::makeLowPass(
+            *filter.state = *juce::dsp::IIR::Coefficients<SampleType>::makeLowPass(
                 sampleRate, juce::jlimit(200.0f, 20000.0f, cutoffHz), 0.707f
             );
         } else {
@@ -111,20 +127,20 @@ void GainKnobAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce
             float normalizedValue = filterPercent / 100.0f; // 0.0 to 1.0
             float cutoffHz = 20.0f * std::pow(10.0f, normalizedValue * std::log10(10000.0f / 20.0f));
 
-            *filterProcessor.state = *juce::dsp::IIR::Coefficients<float>::makeHighPass(
+            *filter.state = *juce::dsp::IIR::Coefficients<SampleType>::makeHighPass(
                 sampleRate, juce::jlimit(20.0f, 10000.0f, cutoffHz), 0.707f
             );
         }
 
         // Process buffer through filter
-        juce::dsp::AudioBlock<float> block(buffer);
-        juce::dsp::ProcessContextReplacing<float> context(block);
-        filterProcessor.process(context);
+        juce::dsp::AudioBlock<SampleType> block(buffer);
+        juce::dsp::ProcessContextReplacing<SampleType> context(block);
+        filter.process(context);
     } else {
         // Reset filter state when entering bypass zone
         // Prevents residual energy when re-entering filter range
         if (previousWasLowPass) {
-            filterProcessor.reset();
+            filter.reset();
             previousWasLowPass = false;
         }
     }
@@ -11,6 +11,8 @@ public:
     void prepareToPlay(double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock(juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override { return true; }
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -36,8 +38,31 @@ public:
 private:
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
-    // Filter state (per-channel)
-    juce::dsp::ProcessorDuplicator<juce::dsp::IIR::Filter<float>, juce::dsp::IIR::Coefficients<float>> filterProcessor;
+    // Shared float/double processing path (64-bit hosts call the double overload)
+    template <typename SampleType>
+    void processSamples(juce::AudioBuffer<SampleType>& buffer);
+
+    // Filter state (per-channel), one per processing precision
+    template <typename SampleType>
+    using FilterDuplicator = juce::dsp::ProcessorDuplicator<juce::dsp::IIR::Filter<SampleType>, juce::dsp::IIR::Coefficients<SampleType>>;
+
+    FilterDuplicator<float> filterProcessor;
+    FilterDuplicator<double> filterProcessorDouble;
+
+    template <typename SampleType>
+    FilterDuplicator<SampleType>& getFilterProcessor()
+    {
+        if constexpr (std::is_same_v<SampleType, double>)
+            return filterProcessorDouble;
+        else
+            return filterProcessor;
+    }
+
+    void resetFilters()
+    {
+        filterProcessor.reset();
+        filterProcessorDouble.reset();
+    }
 
     // Track previous filter type to detect transitions
     bool previousWasLowPass = false;
@@ -0,0 +1,842 @@
+//==============================================================================
+// GrooveScoutAnalysisCore.cpp
+//
+// All phases read one shared STFT (groovescout::SpectralFrontEnd):
+//
+// Phase DSP.2: BPM detection via an Onset Strength Signal (OSS, total
+// log-band spectral flux) + a windowed tempogram (GrooveScoutTempo), which
+// also yields the tempo path and beat grid used to place MIDI notes.
+//
+// Phase DSP.3: Key detection via the STFT chromagram + Krumhansl-Schmuckler
+// profile correlation. The chromagram uses a 4th-order Butterworth 150 Hz
+// high-pass (applied as a per-bin weight), a per-frame amplitude floor and
+// pitch class profile accumulation. Correlation is Pearson against 24 key
+// profiles with a confidence threshold, plus root chord MIDI derivation.
+//
+// Phase DSP.4: Band-separated drum onset detection (kick, snare, hihat)
+// from band-limited spectral flux + adaptive thresholding. MIDI pattern
+// assembly for each drum plus root chord.
+//
+// Once the spectrum exists, BPM, key and the drum bands are independent
+// final steps, so runAnalysis() fans them out to worker threads and joins
+// (see the task graph in GrooveScoutAnalysisCore.h).
+//==============================================================================
+
+#include "GrooveScoutAnalysisCore.h"
+#include "PfsDspKernels.h"
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+namespace
+{
+    /**
+     * Fork/join over AnalysisJobs: add() jobs, then wait() until every one
+     * has run. The counter and event are shared with the jobs, so a job
+     * finishing late can never touch a destroyed group. With nowhere to send
+     * jobs, add() runs the job on the spot.
+     */
+    class TaskGroup
+    {
+    public:
+        explicit TaskGroup (const groovescout::AnalysisJobs& jobsToUse) : jobs (jobsToUse) {}
+
+        ~TaskGroup()
+        {
+            // Jobs reference the caller's locals — never leave with any in flight
+            while (! wait (100)) {}
+        }
+
+        void add (std::function<void()> job)
+        {
+            if (! jobs.add)
+            {
+                job();
+                return;
+            }
+
+            state->pending.fetch_add (1);
+
+            jobs.add ([sharedState = state, job = std::move (job)]
+            {
+                job();
+
+                if (sharedState->pending.fetch_sub (1) == 1)
+                    sharedState->finished.signal();
+            });
+        }
+
+        /** Waits up to timeoutMs. Returns true once all added jobs have finished. */
+        bool wait (int timeoutMs)
+        {
+            // Run our own queued jobs rather than sit on a pool slot waiting for them
+            if (jobs.runQueued)
+                while (state->pending.load() > 0 && jobs.runQueued()) {}
+
+            if (state->pending.load() == 0)
+                return true;
+
+            state->finished.wait (timeoutMs);
+            return state->pending.load() == 0;
+        }
+
+    private:
+        struct State
+        {
+            std::atomic<int>    pending { 0 };
+            juce::WaitableEvent finished;
+        };
+
+        groovescout::AnalysisJobs jobs;
+        std::shared_ptr<State>    state = std::make_shared<State>();
+    };
+}
+
+namespace groovescout
+{
+    //==========================================================================
+    // Front end — the recording through the shared STFT
+    //==========================================================================
+
+    bool buildSpectrum (SpectralFrontEnd& spectrum, const GrooveScoutRecording& recording, int numSamples,
+                        int progressSpan, const AnalysisCallbacks& callbacks)
+    {
+        // Downmixed a chunk at a time (no full-length mono copy), which also keeps
+        // cancellation responsive on long recordings
+        constexpr int chunkSize = 1 << 16;
+        std::vector<float> monoChunk (static_cast<size_t> (chunkSize));
+
+        int reported = 0;
+
+        for (int start = 0; start < numSamples; start += chunkSize)
+        {
+            if (callbacks.shouldExit && callbacks.shouldExit())
+                return false;
+
+            const int count = std::min (chunkSize, numSamples - start);
+
+            recording.readMono (start, count, monoChunk.data());
+
+            spectrum.push (monoChunk.data(), count);
+
+            const auto done = static_cast<double> (start + count) / static_cast<double> (numSamples);
+            const int  now  = static_cast<int> (done * progressSpan);
+
+            if (callbacks.addProgress && now > reported)
+                callbacks.addProgress (now - reported);
+
+            reported = now;
+        }
+
+        return ! (callbacks.shouldExit && callbacks.shouldExit());
+    }
+
+    //==========================================================================
+    // Task graph
+    //==========================================================================
+
+    AnalysisJobs AnalysisJobs::onPool (juce::ThreadPool* pool)
+    {
+        AnalysisJobs jobs;
+
+        if (pool != nullptr)
+            jobs.add = [pool] (std::function<void()> job) { pool->addJob (std::move (job)); };
+
+        return jobs;
+    }
+
+    AnalysisResult runAnalysis (const SpectralFrontEnd& spectrum, const AnalysisSettings& settings,
+                                juce::ThreadPool* pool, const AnalysisCallbacks& callbacks,
+                                AnalysisCache* cache)
+    {
+        return runAnalysis (spectrum, settings, AnalysisJobs::onPool (pool), callbacks, cache);
+    }
+
+    AnalysisResult runAnalysis (const SpectralFrontEnd& spectrum, const AnalysisSettings& settings,
+                                const AnalysisJobs& jobs, const AnalysisCallbacks& callbacks,
+                                AnalysisCache* cache)
+    {
+        AnalysisResult result;
+        AnalysisResult unscaledTempo;   // tempo stage output before bpmMultiplier
+        Tempogram      tempogram;
+
+        const bool tempoCached = cache != nullptr && cache->haveTempo;
+        const bool keyCached   = cache != nullptr && cache->haveKey;
+
+        std::atomic<bool> tempoDone { ! settings.analyseBpm || tempoCached };
+        std::atomic<bool> keyDone   { ! settings.analyseKey || keyCached };
+        std::atomic<int>  tempogramJobsLeft { 0 };
+
+        auto reportProgress = [&callbacks] (int amount)
+        {
+            if (callbacks.addProgress)
+                callbacks.addProgress (amount);
+        };
+
+        TaskGroup stages (jobs);
+
+        if (settings.analyseBpm && tempoCached)
+        {
+            unscaledTempo.bpm   = cache->bpm;
+            unscaledTempo.beats = cache->beats;
+            reportProgress (6);
+        }
+        else if (settings.analyseBpm)
+        {
+            // Windows are independent: spread them over the pool, and let the
+            // last job to finish do the (linear, sequential) tempo path and beats
+            tempogram.prepare (spectrum);
+
+            constexpr int windowsPerJob = 16;
+            const int numWindows = tempogram.getNumWindows();
+            const int numJobs    = std::max (1, (numWindows + windowsPerJob - 1) / windowsPerJob);
+            tempogramJobsLeft.store (numJobs);
+
+            for (int job = 0; job < numJobs; ++job)
+            {
+                const int first = job * windowsPerJob;
+                const int last  = std::min (numWindows, first + windowsPerJob);
+
+                stages.add ([&, first, last]
+                {
+                    tempogram.computeWindows (spectrum, first, last);
+
+                    if (tempogramJobsLeft.fetch_sub (1) == 1)
+                    {
+                        tempoFromTempogram (tempogram, spectrum, 1.0f, unscaledTempo);
+                        tempoDone.store (true);
+                        reportProgress (6);
+                    }
+                });
+            }
+        }
+
+        if (settings.analyseKey && keyCached)
+        {
+            result.key            = cache->key;
+            result.rootChordValid = cache->rootChordValid;
+            std::copy (std::begin (cache->rootChordMidi), std::end (cache->rootChordMidi), result.rootChordMidi);
+            reportProgress (3);
+        }
+        else if (settings.analyseKey)
+        {
+            stages.add ([&]
+            {
+                keyFromPcp (spectrum.getPcp().data(), result);
+                keyDone.store (true);
+                reportProgress (3);
+            });
+        }
+
+        auto addBand = [&] (const char* name, const AnalysisSettings::Band& band,
+                            AnalysisCache::Band* cached, std::vector<OnsetEvent>& onsetsOut)
+        {
+            if (! band.enabled || band.freqLow >= band.freqHigh)
+                return;
+
+            if (cached != nullptr && cached->haveOnsets
+                && cached->freqLow == band.freqLow && cached->freqHigh == band.freqHigh
+                && cached->sensitivity == band.sensitivity && cached->minGapMs == band.minGapMs)
+            {
+                onsetsOut = cached->onsets;
+                reportProgress (2);
+                return;
+            }
+
+            stages.add ([&, name, cached]
+            {
+                // Flux depends only on the band's range; sensitivity and gap only
+                // affect the thresholding below
+                std::vector<float> freshFlux;
+                const std::vector<float>* flux = &freshFlux;
+
+                if (cached != nullptr && cached->haveFlux
+                    && cached->freqLow == band.freqLow && cached->freqHigh == band.freqHigh)
+                {
+                    flux = &cached->flux;
+                }
+                else
+                {
+                    freshFlux = spectrum.bandFlux (band.freqLow, band.freqHigh);
+                }
+
+                onsetsOut = onsetsFromFlux (spectrum, *flux, band.sensitivity, band.minGapMs);
+
+                if (cached != nullptr)
+                {
+                    if (flux == &freshFlux)
+                    {
+                        cached->freqLow  = band.freqLow;
+                        cached->freqHigh = band.freqHigh;
+                        cached->flux     = std::move (freshFlux);
+                        cached->haveFlux = true;
+                    }
+
+                    cached->sensitivity = band.sensitivity;
+                    cached->minGapMs    = band.minGapMs;
+                    cached->onsets      = onsetsOut;
+                    cached->haveOnsets  = true;
+                }
+
+                reportProgress (2);
+
+                DBG ("GrooveScoutAnalysisCore: " << name << " onsets detected = "
+                     << static_cast<int> (onsetsOut.size()));
+                juce::ignoreUnused (name);
+            });
+        };
+
+        addBand ("kick",  settings.kick,  cache != nullptr ? &cache->kick  : nullptr, result.kickOnsets);
+        addBand ("snare", settings.snare, cache != nullptr ? &cache->snare : nullptr, result.snareOnsets);
+        addBand ("hihat", settings.hihat, cache != nullptr ? &cache->hihat : nullptr, result.hihatOnsets);
+
+        // Join. The stage label follows the earliest stage still running. These
+        // are short, but we still wait for them since they reference our locals.
+        while (! stages.wait (50))
+        {
+            if (callbacks.stageChanged)
+                callbacks.stageChanged (! tempoDone.load() ? AnalysisStage::tempo
+                                      : ! keyDone.load()   ? AnalysisStage::key
+                                                           : AnalysisStage::drums);
+        }
+
+        // ---------------------------------------------------------------------
+        // Store what was computed, then apply bpmMultiplier (½×, 1×, 2×) to a
+        // copy, so changing it later never needs the tempogram again
+        // ---------------------------------------------------------------------
+        if (cache != nullptr)
+        {
+            if (settings.analyseBpm && ! tempoCached)
+            {
+                cache->bpm       = unscaledTempo.bpm;
+                cache->beats     = unscaledTempo.beats;
+                cache->haveTempo = true;
+            }
+
+            if (settings.analyseKey && ! keyCached)
+            {
+                cache->key            = result.key;
+                cache->rootChordValid = result.rootChordValid;
+                std::copy (std::begin (result.rootChordMidi), std::end (result.rootChordMidi), cache->rootChordMidi);
+                cache->haveKey        = true;
+            }
+        }
+
+        if (settings.analyseBpm)
+        {
+            result.bpm   = unscaledTempo.bpm * settings.bpmMultiplier;
+            result.beats = unscaledTempo.beats.withMultiplier (settings.bpmMultiplier);
+        }
+
+        return result;
+    }
+
+    //==========================================================================
+    // DSP.2 Stage: BPM detection
+    //==========================================================================
+
+    void tempoFromTempogram (const Tempogram& tempogram, const SpectralFrontEnd& spectrum,
+                             float bpmMultiplier, AnalysisResult& result)
+    {
+        // ---------------------------------------------------------------------
+        // 2c. Global tempo: the lag whose autocorrelation, summed over every
+        //     window, is strongest in 60–200 BPM (parabolic peak refinement)
+        // ---------------------------------------------------------------------
+        float bestBpm = tempogram.globalBpm();
+
+        // ---------------------------------------------------------------------
+        // 2d. Tempo path across windows, then beats following it
+        // ---------------------------------------------------------------------
+        const auto windowBpm = tempogram.tempoPath (bestBpm);
+        auto beats = tempogram.trackBeats (spectrum, windowBpm);
+
+        if (! windowBpm.empty())
+        {
+            DBG ("GrooveScoutAnalysisCore: tempogram " << tempogram.getNumWindows() << " windows, tempo "
+                 << juce::String (*std::min_element (windowBpm.begin(), windowBpm.end()), 1) << "–"
+                 << juce::String (*std::max_element (windowBpm.begin(), windowBpm.end()), 1)
+                 << " BPM, " << static_cast<int> (beats.beatSamples.size()) << " beats");
+        }
+
+        // ---------------------------------------------------------------------
+        // 2e. Apply bpmMultiplier (½×, 1×, 2×)
+        // ---------------------------------------------------------------------
+        bestBpm *= bpmMultiplier;
+        beats = beats.withMultiplier (bpmMultiplier);
+
+        result.bpm   = bestBpm;
+        result.beats = std::move (beats);
+    }
+
+    //==========================================================================
+    // DSP.3 Stage: Key detection — STFT chromagram + Krumhansl-Schmuckler
+    //==========================================================================
+
+    void keyFromPcp (const float* accumulatedPcp, AnalysisResult& result)
+    {
+        float pcp[12];
+        std::copy (accumulatedPcp, accumulatedPcp + 12, pcp);
+
+        // -----------------------------------------------------------------
+        // 3d. Normalize PCP to unit length
+        // -----------------------------------------------------------------
+        float pcpNorm = 0.0f;
+        for (int i = 0; i < 12; ++i)
+            pcpNorm += pcp[i] * pcp[i];
+
+        pcpNorm = std::sqrt (pcpNorm);
+
+        if (pcpNorm < 1e-10f)
+        {
+            // Silent audio or no tonal content — return "Unknown"
+            result.key = "Unknown";
+            result.rootChordValid = false;
+            DBG ("GrooveScoutAnalysisCore: key detection — silent/atonal audio, returning Unknown");
+        }
+        else
+        {
+            for (int i = 0; i < 12; ++i)
+                pcp[i] /= pcpNorm;
+
+            // ---------------------------------------------------------
+            // 3e. Krumhansl-Schmuckler key profile correlation
+            //     Major profile (Krumhansl 1990):
+            //     [6.35, 2.23, 3.48, 2.33, 4.38, 4.09, 2.52, 5.19, 2.39, 3.66, 2.29, 2.88]
+            //     Minor profile:
+            //     [6.33, 2.68, 3.52, 5.38, 2.60, 3.53, 2.54, 4.75, 3.98, 2.69, 3.34, 3.17]
+            //
+            //     For each of 24 keys (12 major + 12 minor), rotate the
+            //     profile and compute Pearson correlation with PCP.
+            // ---------------------------------------------------------
+            const float majorProfile[12] = {
+                6.35f, 2.23f, 3.48f, 2.33f, 4.38f, 4.09f,
+                2.52f, 5.19f, 2.39f, 3.66f, 2.29f, 2.88f
+            };
+
+            const float minorProfile[12] = {
+                6.33f, 2.68f, 3.52f, 5.38f, 2.60f, 3.53f,
+                2.54f, 4.75f, 3.98f, 2.69f, 3.34f, 3.17f
+            };
+
+            const char* noteNames[12] = {
+                "C", "C#", "D", "D#", "E", "F",
+                "F#", "G", "G#", "A", "A#", "B"
+            };
+
+            // Lambda: Pearson correlation between PCP and a rotated profile.
+            // Rotation by `shift` means the profile starting note is at
+            // pitch class `shift`. We rotate PCP indices to align.
+            auto pearsonCorrelation = [] (const float* pcpVec,
+                                          const float* profile,
+                                          int shift) -> float
+            {
+                // Compute means
+                float meanP = 0.0f, meanQ = 0.0f;
+                for (int i = 0; i < 12; ++i)
+                {
+                    meanP += pcpVec[(i + shift) % 12];
+                    meanQ += profile[i];
+                }
+                meanP /= 12.0f;
+                meanQ /= 12.0f;
+
+                // Compute correlation
+                float num = 0.0f, denP = 0.0f, denQ = 0.0f;
+                for (int i = 0; i < 12; ++i)
+                {
+                    const float p = pcpVec[(i + shift) % 12] - meanP;
+                    const float q = profile[i] - meanQ;
+                    num  += p * q;
+                    denP += p * p;
+                    denQ += q * q;
+                }
+
+                const float den = std::sqrt (denP * denQ);
+                if (den < 1e-10f)
+                    return 0.0f;
+
+                return num / den;
+            };
+
+            float bestCorr = -2.0f;
+            int bestKeyIndex = 0;    // 0-11 = C..B major, 12-23 = C..B minor
+            bool bestIsMajor = true;
+
+            // Test all 12 major keys
+            for (int root = 0; root < 12; ++root)
+            {
+                const float corr = pearsonCorrelation (pcp, majorProfile, root);
+                if (corr > bestCorr)
+                {
+                    bestCorr = corr;
+                    bestKeyIndex = root;
+                    bestIsMajor = true;
+                }
+            }
+
+            // Test all 12 minor keys
+            for (int root = 0; root < 12; ++root)
+            {
+                const float corr = pearsonCorrelation (pcp, minorProfile, root);
+                if (corr > bestCorr)
+                {
+                    bestCorr = corr;
+                    bestKeyIndex = root;
+                    bestIsMajor = false;
+                }
+            }
+
+            // ---------------------------------------------------------
+            // 3f. Confidence check + format key string + root chord
+            //     Minimum correlation threshold: below 0.5 the match
+            //     is essentially random — report "Unknown" instead of
+            //     a misleading key name.
+            // ---------------------------------------------------------
+            constexpr float minKeyConfidence = 0.5f;
+
+            if (bestCorr < minKeyConfidence)
+            {
+                result.key = "Unknown";
+                result.rootChordValid = false;
+                DBG ("GrooveScoutAnalysisCore: key detection — correlation too low ("
+                     + juce::String (bestCorr, 3) + " < " + juce::String (minKeyConfidence, 1)
+                     + "), returning Unknown");
+            }
+            else
+            {
+                juce::String keyString = juce::String (noteNames[bestKeyIndex])
+                                       + (bestIsMajor ? " major" : " minor");
+
+                result.key = keyString;
+
+                // Root chord MIDI: place in octave 4 (C4 = MIDI 60)
+                const int rootMidi = 60 + bestKeyIndex;
+
+                if (bestIsMajor)
+                {
+                    // Major triad: root, +4, +7
+                    result.rootChordMidi[0] = rootMidi;
+                    result.rootChordMidi[1] = rootMidi + 4;
+                    result.rootChordMidi[2] = rootMidi + 7;
+                }
+                else
+                {
+                    // Minor triad: root, +3, +7
+                    result.rootChordMidi[0] = rootMidi;
+                    result.rootChordMidi[1] = rootMidi + 3;
+                    result.rootChordMidi[2] = rootMidi + 7;
+                }
+
+                result.rootChordValid = true;
+
+                DBG ("GrooveScoutAnalysisCore: key detected = " + keyString
+                     + " (corr=" + juce::String (bestCorr, 3)
+                     + ", chord MIDI=" + juce::String (result.rootChordMidi[0])
+                     + "," + juce::String (result.rootChordMidi[1])
+                     + "," + juce::String (result.rootChordMidi[2]) + ")");
+            }
+        }
+
+    }
+
+    //==========================================================================
+    // DSP.4 Helper: Band-limited spectral-flux onset detection
+    //==========================================================================
+
+    std::vector<OnsetEvent> onsetsFromFlux (const SpectralFrontEnd& spectrum,
+                                            const std::vector<float>& flux,
+                                            float sensitivity,
+                                            int minGapMs)
+    {
+        std::vector<OnsetEvent> onsets;
+
+        // -----------------------------------------------------------------
+        // Step 1–2: Onset function — band-limited spectral flux from the
+        //           shared front end, already half-wave rectified:
+        //           O[n] = Σ_b max(0, L[n][b] - L[n-1][b])
+        // -----------------------------------------------------------------
+        const double sampleRate = spectrum.getSampleRate();
+        const int    hopSize    = spectrum.getHopSize();
+
+        const int numFrames = static_cast<int> (flux.size());
+        if (numFrames < 2)
+            return onsets;
+
+        const std::vector<float>& onsetFunc = flux;
+
+        // -----------------------------------------------------------------
+        // Step 3: Adaptive threshold + peak detection
+        //         T[n] = mean(O[n-w..n]) + (1 - sensitivity) * 6 * std(O[n-w..n])
+        //         w ≈ 116 ms (the original 40 frames × 128 samples at 44.1 kHz)
+        //         Minimum inter-onset interval: band-specific (ms → frames)
+        // -----------------------------------------------------------------
+        const int threshWindow = std::max (2, static_cast<int> (std::round (0.116 * sampleRate / hopSize)));
+
+        // Convert caller-specified minimum gap (ms) to frames
+        // frames = ms * sampleRate / (1000 * hopSize)
+        const int minOnsetGap = std::max (1,
+            static_cast<int> (std::round (minGapMs * sampleRate / (1000.0 * hopSize))));
+
+        // Find peak onset strength for velocity normalization
+        float peakOnset = 0.0f;
+        for (int f = 0; f < numFrames; ++f)
+            peakOnset = std::max (peakOnset, onsetFunc[static_cast<size_t> (f)]);
+
+        if (peakOnset < 1e-10f)
+            return onsets;  // No energy in this band
+
+        // Sensitivity-scaled strength floor: at low sensitivity only the strongest
+        // transients (dominant hits) survive; at high sensitivity most hits are kept.
+        //   sens=0.0 → floor = 55% of peak  (only top-tier hits)
+        //   sens=0.5 → floor = 30% of peak  (reasonable selectivity)
+        //   sens=1.0 → floor =  5% of peak  (catch nearly everything)
+        const float strengthFloor = peakOnset * (0.05f + (1.0f - sensitivity) * 0.50f);
+
+        int cooldown = 0;  // frames remaining in suppression window
+
+        // Running Σ O and Σ O² over the previous `threshWindow` frames — O(1) per
+        // frame instead of two passes over the window. Updated on every frame,
+        // including the ones the cooldown skips.
+        SlidingWindowSum windowSum, windowSumSq;
+        windowSum.reset (threshWindow);
+        windowSumSq.reset (threshWindow);
+
+        for (int f = 1; f < numFrames; ++f)
+        {
+            const double entering = onsetFunc[static_cast<size_t> (f - 1)];
+            windowSum.push (entering);
+            windowSumSq.push (entering * entering);
+
+            if (cooldown > 0)
+            {
+                --cooldown;
+                continue;
+            }
+
+            // Adaptive threshold over the previous `threshWindow` frames:
+            // var = E[O²] - E[O]² (accumulated in double, so no cancellation trouble)
+            const double wLen     = static_cast<double> (windowSum.getCount());
+            const double meanD    = windowSum.getSum() / wLen;
+            const double variance = std::max (0.0, windowSumSq.getSum() / wLen - meanD * meanD);
+
+            const float mean   = static_cast<float> (meanD);
+            const float stdDev = static_cast<float> (std::sqrt (variance));
+
+            // Multiplier raised to 6× (was 4×) so low-sensitivity settings demand
+            // a much larger energy increase relative to local variance.
+            const float threshold = mean + (1.0f - sensitivity) * 6.0f * stdDev;
+
+            // Check if current frame exceeds threshold AND the absolute strength floor
+            const float val = onsetFunc[static_cast<size_t> (f)];
+            if (val <= threshold || val < strengthFloor)
+                continue;
+
+            // Local maximum check: O[f] > O[f-1] and O[f] >= O[f+1]
+            const float prev = onsetFunc[static_cast<size_t> (f - 1)];
+            const float next = (f + 1 < numFrames) ? onsetFunc[static_cast<size_t> (f + 1)] : 0.0f;
+
+            if (val > prev && val >= next)
+            {
+                // Detected onset
+                OnsetEvent ev;
+                ev.sampleOffset = spectrum.getFrameCentre (f);
+                ev.strength     = val;
+                onsets.push_back (ev);
+
+                cooldown = minOnsetGap;
+            }
+        }
+
+        return onsets;
+    }
+
+    //==========================================================================
+    // DSP.4 MIDI assembly — in memory; serialised only on drag/export
+    //==========================================================================
+
+    namespace
+    {
+        constexpr int ppq = 480;   // Pulses per quarter note
+
+        /** Tempo meta-event at tick 0: microseconds per beat = 60,000,000 / BPM. */
+        juce::MidiMessageSequence tempoSequence (float bpm)
+        {
+            const int microsPerBeat = static_cast<int> (60000000.0 / static_cast<double> (bpm));
+
+            juce::MidiMessageSequence seq;
+            seq.addEvent (juce::MidiMessage::tempoMetaEvent (microsPerBeat), 0.0);
+            return seq;
+        }
+
+        juce::MidiMessageSequence drumSequence (const std::vector<OnsetEvent>& onsets,
+                                                int midiNote,
+                                                float bpm,
+                                                const BeatGrid& beats,
+                                                double sampleRate)
+        {
+            const int noteDurationTicks = 60;  // 1/32nd note at 480 PPQ (480 / 8 = 60)
+
+            // Find peak onset strength for velocity normalization
+            float peakStrength = 0.0f;
+            for (const auto& ev : onsets)
+                peakStrength = std::max (peakStrength, ev.strength);
+
+            if (peakStrength < 1e-10f)
+                peakStrength = 1.0f;
+
+            juce::MidiMessageSequence seq;
+
+            // Add note events for each detected onset (channel 10 = drum channel, 0-indexed = 9)
+            for (const auto& ev : onsets)
+            {
+                // Convert sample offset to beat position — against the tracked beats
+                // when there are any, else beatPosition = (sampleOffset / sampleRate) * (bpm / 60.0)
+                const double timeSeconds = static_cast<double> (ev.sampleOffset) / sampleRate;
+                const double beatPosition = beats.isUsable()
+                                                ? beats.beatPosition (ev.sampleOffset)
+                                                : timeSeconds * (static_cast<double> (bpm) / 60.0);
+
+                // Convert beat position to MIDI ticks
+                const int tick = static_cast<int> (std::round (beatPosition * ppq));
+                if (tick < 0)
+                    continue;
+
+                // Onset strength to velocity (1-127)
+                int velocity = static_cast<int> (std::round ((ev.strength / peakStrength) * 127.0f));
+                velocity = juce::jlimit (1, 127, velocity);
+
+                // Note on at tick, note off at tick + noteDurationTicks
+                // MIDI channel 10 (0-indexed = 9) for drums
+                seq.addEvent (juce::MidiMessage::noteOn  (10, midiNote, static_cast<juce::uint8> (velocity)),
+                              static_cast<double> (tick));
+                seq.addEvent (juce::MidiMessage::noteOff (10, midiNote, static_cast<juce::uint8> (0)),
+                              static_cast<double> (tick + noteDurationTicks));
+            }
+
+            seq.updateMatchedPairs();
+            return seq;
+        }
+
+        juce::MidiMessageSequence chordSequence (const int chordMidi[3])
+        {
+            const int chordDurationTicks = 1920;  // 4 beats at 480 PPQ
+
+            juce::MidiMessageSequence seq;
+
+            // Add 3 simultaneous notes (channel 1, 0-indexed = 0) at tick 0
+            for (int i = 0; i < 3; ++i)
+            {
+                seq.addEvent (juce::MidiMessage::noteOn  (1, chordMidi[i], static_cast<juce::uint8> (100)),
+                              0.0);
+                seq.addEvent (juce::MidiMessage::noteOff (1, chordMidi[i], static_cast<juce::uint8> (0)),
+                              static_cast<double> (chordDurationTicks));
+            }
+
+            seq.updateMatchedPairs();
+            return seq;
+        }
+
+        /** Track-name meta-event, so DAWs label the tracks of the multi-track file. */
+        juce::MidiMessage trackName (MidiClip clip)
+        {
+            return juce::MidiMessage::textMetaEvent (3, MidiClips::getName (clip));
+        }
+    }
+
+    MidiClips assembleMidi (const AnalysisResult& result, float bpm, double sampleRate)
+    {
+        MidiClips clips;
+
+        const auto tempo = tempoSequence (bpm);
+
+        // "all": format 1 — conductor track with the tempo, then one track per clip
+        auto& all = clips.files[static_cast<int> (MidiClip::all)];
+        all.setTicksPerQuarterNote (ppq);
+        all.addTrack (tempo);
+
+        auto addClip = [&] (MidiClip clip, const juce::MidiMessageSequence& notes)
+        {
+            // Single clip: format 0 — tempo and notes in one track
+            auto single = tempo;
+            single.addSequence (notes, 0.0);
+            single.updateMatchedPairs();
+
+            auto& file = clips.files[static_cast<int> (clip)];
+            file.setTicksPerQuarterNote (ppq);
+            file.addTrack (single);
+
+            auto named = notes;
+            named.addEvent (trackName (clip), 0.0);
+            named.updateMatchedPairs();
+            all.addTrack (named);
+
+            clips.available[static_cast<int> (clip)] = true;
+        };
+
+        if (! result.kickOnsets.empty())
+            addClip (MidiClip::kick,  drumSequence (result.kickOnsets,  36, bpm, result.beats, sampleRate));
+
+        if (! result.snareOnsets.empty())
+            addClip (MidiClip::snare, drumSequence (result.snareOnsets, 38, bpm, result.beats, sampleRate));
+
+        if (! result.hihatOnsets.empty())
+            addClip (MidiClip::hihat, drumSequence (result.hihatOnsets, 42, bpm, result.beats, sampleRate));
+
+        if (result.rootChordValid)
+            addClip (MidiClip::chord, chordSequence (result.rootChordMidi));
+
+        clips.available[static_cast<int> (MidiClip::all)] = all.getNumTracks() > 1;
+        return clips;
+    }
+
+    //==========================================================================
+
+    const char* MidiClips::getName (MidiClip clip) noexcept
+    {
+        switch (clip)
+        {
+            case MidiClip::kick:  return "kick";
+            case MidiClip::snare: return "snare";
+            case MidiClip::hihat: return "hihat";
+            case MidiClip::chord: return "chord";
+            case MidiClip::all:   return "all";
+        }
+
+        return "";
+    }
+
+    bool MidiClips::writeTo (MidiClip clip, juce::OutputStream& out) const
+    {
+        if (! isAvailable (clip))
+            return false;
+
+        // Format 0 = single track; the combined file is format 1 (tempo track + one per clip)
+        return get (clip).writeTo (out, clip == MidiClip::all ? 1 : 0);
+    }
+
+    bool MidiClips::writeTo (MidiClip clip, const juce::File& destFile) const
+    {
+        if (! isAvailable (clip))
+            return false;
+
+        // Write to disk (overwrite existing)
+        destFile.deleteFile();
+        juce::FileOutputStream fos (destFile);
+
+        if (fos.failedToOpen())
+        {
+            DBG ("GrooveScoutAnalysisCore: failed to open " + destFile.getFullPathName());
+            return false;
+        }
+
+        if (! writeTo (clip, fos))
+            return false;
+
+        fos.flush();
+        return true;
+    }
+}
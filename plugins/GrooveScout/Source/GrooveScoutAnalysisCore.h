@@ -0,0 +1,237 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <juce_audio_basics/juce_audio_basics.h>  // For AudioBuffer, MidiFile, MidiMessage
+#include "GrooveScoutFeatures.h"
+#include "GrooveScoutRecording.h"
+#include "GrooveScoutTempo.h"
+
+#include <functional>
+#include <vector>
+
+//==============================================================================
+/**
+ * GrooveScoutAnalysisCore — the analysis itself, with no plugin attached
+ *
+ * Everything from the shared spectrum onwards: tempo and beats, key, drum
+ * onsets, and the MIDI clips. Settings come in as a plain AnalysisSettings
+ * and results go out as an AnalysisResult, so the same code serves both
+ *   - GrooveScoutAnalyzer, which reads the processor's parameters and
+ *     recording and publishes the result to the UI, and
+ *   - the GrooveScoutBatch command-line tool (tools/GrooveScoutBatch), which
+ *     decodes audio files and writes results to an output folder.
+ *
+ * Task graph of runAnalysis():
+ *
+ *         ┌─> tempogram windows ─> beats ─┐
+ *     ────┼─> key ────────────────────────┼──> AnalysisResult
+ *         └─> kick/snare/hihat flux ──────┘
+ *
+ * Given somewhere to send jobs (AnalysisJobs), the stages run there in
+ * parallel. The tempogram is split into several jobs of windows, and
+ * whichever finishes last picks the tempo and tracks the beats, so no worker
+ * ever blocks waiting for another. Without one, every stage runs in turn on
+ * the calling thread. The batch tool does that, because it already keeps
+ * every core busy with one file per thread.
+ */
+namespace groovescout
+{
+    //==========================================================================
+    /** Which stages run and how. The defaults match the plugin's parameter defaults. */
+    struct AnalysisSettings
+    {
+        struct Band
+        {
+            bool  enabled;
+            float freqLow;
+            float freqHigh;
+            float sensitivity;
+            int   minGapMs;       ///< Shortest realistic spacing between hits
+        };
+
+        bool  analyseBpm = true;
+        bool  analyseKey = true;
+        float bpmMultiplier = 1.0f;   ///< 0.5, 1 or 2; also rescales the beat grid
+
+        Band kick  { true,   40.0f,   120.0f, 0.5f, 80 };  // kick can't repeat faster
+        Band snare { true,  200.0f,  8000.0f, 0.5f, 60 };
+        Band hihat { true, 5000.0f, 16000.0f, 0.5f, 30 };  // hihats can be dense (16ths)
+    };
+
+    /** A single detected onset event with timing and strength. */
+    struct OnsetEvent
+    {
+        int    sampleOffset;   ///< Position in the recording (samples)
+        float  strength;       ///< Band spectral flux at the onset (onset function value)
+    };
+
+    /** Output of runAnalysis(). Each parallel stage writes only its own fields. */
+    struct AnalysisResult
+    {
+        float                   bpm = 0.0f;    ///< bpmMultiplier applied; 0 if not analysed
+        BeatGrid                beats;         ///< bpmMultiplier already applied
+        juce::String            key;           ///< "C major", "Unknown", or empty if not analysed
+        int                     rootChordMidi[3] { 0, 0, 0 };
+        bool                    rootChordValid = false;
+        std::vector<OnsetEvent> kickOnsets;
+        std::vector<OnsetEvent> snareOnsets;
+        std::vector<OnsetEvent> hihatOnsets;
+    };
+
+    /**
+     * Intermediate results kept between runAnalysis() calls on the same spectrum,
+     * so a second Analyze only redoes what a changed setting affects:
+     *   - BPM multiplier:  rescales the cached tempo and beats (no tempogram)
+     *   - band frequency:  that band's flux + thresholding
+     *   - sensitivity:     that band's thresholding only
+     * Tempo and key are stored before the multiplier/settings are applied. The
+     * owner calls reset() whenever the spectrum changes (new take, new sample
+     * rate). Each parallel stage touches only its own entry.
+     */
+    struct AnalysisCache
+    {
+        struct Band
+        {
+            float                   freqLow  = -1.0f;   ///< Range the flux was taken over
+            float                   freqHigh = -1.0f;
+            std::vector<float>      flux;
+            bool                    haveFlux = false;
+
+            float                   sensitivity = -1.0f; ///< Settings the onsets were picked with
+            int                     minGapMs    = -1;
+            std::vector<OnsetEvent> onsets;
+            bool                    haveOnsets  = false;
+        };
+
+        bool         haveTempo = false;
+        float        bpm = 0.0f;        ///< Before bpmMultiplier
+        BeatGrid     beats;             ///< Before bpmMultiplier
+
+        bool         haveKey = false;
+        juce::String key;
+        int          rootChordMidi[3] { 0, 0, 0 };
+        bool         rootChordValid = false;
+
+        Band kick, snare, hihat;
+
+        void reset() { *this = {}; }
+    };
+
+    /** Stage labels reported while runAnalysis() waits (the plugin's step indices). */
+    enum class AnalysisStage { tempo = 1, key = 2, drums = 3 };
+
+    /** Hooks back into the caller. Any of them may be empty. */
+    struct AnalysisCallbacks
+    {
+        std::function<void (int)>           addProgress;    ///< Percent done by a finished stage (any thread)
+        std::function<void (AnalysisStage)> stageChanged;   ///< Earliest stage still running (caller's thread)
+        std::function<bool()>               shouldExit;     ///< Polled between chunks (caller's thread)
+    };
+
+    /**
+     * Where runAnalysis() sends its parallel stages. With no `add`, every
+     * stage runs in turn on the calling thread.
+     *
+     * `runQueued` is for callers that are themselves a job on a shared pool
+     * (the plugin's GrooveScoutWorkerPool). While runAnalysis() waits for its
+     * stages it calls it to run them in its own slot, so a pool that is full
+     * of waiting callers still makes progress.
+     */
+    struct AnalysisJobs
+    {
+        std::function<void (std::function<void()>)> add;         ///< Queues a stage for another thread
+        std::function<bool()>                        runQueued;   ///< Runs one of our queued stages here; false if none
+
+        /** Stages on a juce::ThreadPool, or inline if pool is null. */
+        static AnalysisJobs onPool (juce::ThreadPool* pool);
+    };
+
+    /** Shortest recording worth analysing — a tempogram needs a couple of beats. */
+    constexpr double minimumAnalysisSeconds = 2.0;
+
+    //==========================================================================
+
+    /** Runs the first numSamples of a recording through the front end,
+        downmixed and converted a chunk at a time (no full-length mono copy).
+        Reports progressSpan percent in total through addProgress as it goes.
+        Returns false if shouldExit() asked to stop. */
+    bool buildSpectrum (SpectralFrontEnd& spectrum, const GrooveScoutRecording& recording, int numSamples,
+                        int progressSpan, const AnalysisCallbacks& callbacks);
+
+    /** Runs every enabled stage over the spectrum and joins.
+        With a cache, stages whose inputs haven't changed since the last call on
+        the same spectrum are taken from it, and whatever is computed is stored. */
+    AnalysisResult runAnalysis (const SpectralFrontEnd& spectrum, const AnalysisSettings& settings,
+                                const AnalysisJobs& jobs, const AnalysisCallbacks& callbacks,
+                                AnalysisCache* cache = nullptr);
+
+    /** Same, with the stages on a juce::ThreadPool. pool may be null. */
+    AnalysisResult runAnalysis (const SpectralFrontEnd& spectrum, const AnalysisSettings& settings,
+                                juce::ThreadPool* pool, const AnalysisCallbacks& callbacks,
+                                AnalysisCache* cache = nullptr);
+
+    //==========================================================================
+    // Final steps — exposed individually for callers that only need one
+
+    /** DSP.2: global BPM, tempo path and beat grid from a computed tempogram,
+        with the multiplier applied to both the BPM and the grid. */
+    void tempoFromTempogram (const Tempogram& tempogram, const SpectralFrontEnd& spectrum,
+                             float bpmMultiplier, AnalysisResult& result);
+
+    /** DSP.3: Krumhansl-Schmuckler correlation + confidence check on a raw PCP. */
+    void keyFromPcp (const float* pcp, AnalysisResult& result);
+
+    /** DSP.4: adaptive threshold and peak picking on a band's spectral flux. */
+    std::vector<OnsetEvent> onsetsFromFlux (const SpectralFrontEnd& spectrum,
+                                            const std::vector<float>& flux,
+                                            float sensitivity,
+                                            int minGapMs);
+
+    //==========================================================================
+    // MIDI assembly
+
+    /** The clips an analysis can produce; `all` is every other clip in one file. */
+    enum class MidiClip { kick, snare, hihat, chord, all };
+
+    /**
+     * One analysis' MIDI, kept in memory. Each clip is its own single-track file
+     * (format 0, 480 PPQ, tempo meta-event at tick 0). `all` is a format-1 file
+     * with a tempo track plus one named track per available clip. Nothing
+     * touches the disk until writeTo() is called for a drag or an export.
+     *
+     * Drum clips use GM notes on channel 10 (36=kick, 38=snare, 42=hihat).
+     * Onsets are placed relative to the tracked beats when the grid is usable,
+     * so a drifting performance still lines up with the bar lines. Otherwise
+     * the BPM converts time to beats. The chord clip is the root triad held
+     * for one bar.
+     */
+    struct MidiClips
+    {
+        static constexpr int numClips = 5;
+
+        juce::MidiFile files[numClips];          ///< Indexed by MidiClip
+        bool           available[numClips] {};
+
+        bool isAvailable (MidiClip clip) const noexcept               { return available[static_cast<int> (clip)]; }
+        const juce::MidiFile& get (MidiClip clip) const noexcept      { return files[static_cast<int> (clip)]; }
+
+        /** "kick", "snare", "hihat", "chord" or "all" (file names, UI clip ids). */
+        static const char* getName (MidiClip clip) noexcept;
+
+        /** Serialises a clip as a Standard MIDI File. False if the clip isn't available. */
+        bool writeTo (MidiClip clip, juce::OutputStream& out) const;
+
+        /** Same, replacing destFile. */
+        bool writeTo (MidiClip clip, const juce::File& destFile) const;
+    };
+
+    /**
+     * Builds every clip the result has material for.
+     *
+     * @param result       Analysis output (onsets, beats, root chord)
+     * @param bpm          Tempo for the tempo meta-event and for placing onsets
+     *                     when there is no usable beat grid
+     * @param sampleRate   Sample rate the onsets are measured in
+     */
+    MidiClips assembleMidi (const AnalysisResult& result, float bpm, double sampleRate);
+}
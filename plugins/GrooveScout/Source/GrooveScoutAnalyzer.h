@@ -1,99 +1,105 @@
 #pragma once
 
 #include <juce_core/juce_core.h>
-#include <juce_dsp/juce_dsp.h>          // For juce::dsp::FFT, IIR filters
-#include <juce_audio_basics/juce_audio_basics.h>  // For MidiFile, MidiMessage
+#include "GrooveScoutAnalysisCore.h"
+#include "GrooveScoutWorkerPool.h"
+
+#include <atomic>
 
 // Forward declaration — avoids circular include with PluginProcessor.h
 class GrooveScoutAudioProcessor;
 
 //==============================================================================
 /**
- * GrooveScoutAnalyzer — Background analysis thread
+ * GrooveScoutAnalyzer — Background analysis job
  *
- * Runs on a low-priority background thread. Reads the pre-captured audio
- * from GrooveScoutAudioProcessor::recordingBuffer and performs:
+ * Runs as a job on the process-wide GrooveScoutWorkerPool, next to every
+ * other instance's analysis, so the pool's core cap and focus priority
+ * cover it. Reads the pre-captured audio
+ * from GrooveScoutAudioProcessor::recording and, through
+ * GrooveScoutAnalysisCore, performs:
  *   DSP.1: Buffer capture infrastructure (validated)
- *   DSP.2: BPM detection (OSS + autocorrelation using juce::dsp::FFT)
+ *   DSP.2: BPM detection (spectral-flux OSS → windowed tempogram → beat grid)
  *   DSP.3: Key detection (chromagram + Krumhansl-Schmuckler)
- *   DSP.4: Drum onset detection + MIDI assembly
+ *   DSP.4: Drum onset detection (band-limited spectral flux) + MIDI assembly
+ *
+ * Task graph (one analysis):
+ *
+ *                                    ┌─> tempogram windows ─> beats ─┐
+ *     stereo → mono → STFT front ────┼─> key ────────────────────────┼──> MIDI assembly
+ *     end (live, or this job)        └─> kick/snare/hihat flux ──────┘    (this job, in memory)
+ *                                        (shared worker pool)
+ *
+ * This class is the plugin side only: it turns parameters into an
+ * AnalysisSettings, finds or builds the spectrum, runs the core on the
+ * shared pool, then publishes the result and the in-memory MIDI clips.
+ *
+ * Every stage reads the same groovescout::SpectralFrontEnd, so the audio
+ * is read exactly once. GrooveScoutLiveAnalyzer normally builds that
+ * spectrum during capture, which leaves only the final steps. If it doesn't
+ * cover this recording, run() builds it with one offline pass, downmixing
+ * chunk by chunk.
  *
  * Thread-safety contract:
- *   - Reads recordingBuffer ONLY after isCapturing == false
+ *   - Reads recording ONLY after isCapturing == false
  *   - Writes analysisProgress and analysisStep atomically
+ *   - Parallel stages write only their own AnalysisResult fields; processor
+ *     result fields are written by this job after the join
  *   - Sets analysisComplete = true LAST, after all results are written
- *   - Checks threadShouldExit() between analysis steps for cancellation
+ *   - The offline pass polls threadShouldExit() between chunks; run() always
+ *     waits for in-flight final steps before returning
+ *   - start(), startImport() and stop() are called from the message thread only
  */
-class GrooveScoutAnalyzer : public juce::Thread
+class GrooveScoutAnalyzer
 {
 public:
-    explicit GrooveScoutAnalyzer (GrooveScoutAudioProcessor& processor);
-    ~GrooveScoutAnalyzer() override;
+    GrooveScoutAnalyzer (GrooveScoutAudioProcessor& processor, GrooveScoutWorkerPool& pool);
+    ~GrooveScoutAnalyzer();
+
+    /** Queues an analysis of the current take, stopping any previous one first. */
+    void start();
 
-    void run() override;
+    /** Same, but the job first decodes file into the (already reset) recording. */
+    void startImport (const juce::File& file);
+
+    /** True from start() until the job has finished or been stopped. */
+    bool isRunning() const;
+
+    /** Asks a running analysis to stop and waits for it. One still queued is
+        simply dropped. */
+    void stop();
 
 private:
     GrooveScoutAudioProcessor& proc;
+    GrooveScoutWorkerPool&     pool;
+
+    GrooveScoutWorkerPool::JobId queuedJob = 0;
+    std::atomic<bool>            exitRequested { false };
+    juce::WaitableEvent          finished { true };   ///< Signalled whenever no job is pending
+
+    /** Queues one job: importFile() if a file is given, then run(). */
+    void startJob (const juce::File& fileToImport);
+
+    void run();
+    bool importFile (const juce::File& file);   ///< False if there is nothing to analyse
+    bool threadShouldExit() const noexcept   { return exitRequested.load(); }
 
     //==========================================================================
-    // DSP.4 — Onset detection data
+    // Kept between runs on the same take (recordingGeneration, length and rate
+    // unchanged), so re-analysing after a parameter tweak only redoes the
+    // stages it affects — a sensitivity change is just thresholding + MIDI.
+    // Touched only by the analysis job and the stages it joins.
     //==========================================================================
 
-    /** A single detected onset event with timing and strength. */
-    struct OnsetEvent
-    {
-        int    sampleOffset;   ///< Position in the recording buffer (samples)
-        float  strength;       ///< Half-wave rectified energy delta (onset function value)
-    };
-
-    /**
-     * Detect onsets in a mono audio buffer using band-pass filtering +
-     * adaptive energy-based onset detection.
-     *
-     * @param monoBuffer   Input mono audio (will be modified in-place by filtering)
-     * @param numSamples   Number of valid samples in monoBuffer
-     * @param sampleRate   Sample rate of the audio
-     * @param freqLow      High-pass cutoff for band isolation
-     * @param freqHigh     Low-pass cutoff for band isolation
-     * @param sensitivity  Onset sensitivity (0.0 = least sensitive, 1.0 = most sensitive)
-     * @return Vector of detected onset events (sample offset + strength)
-     */
-    std::vector<OnsetEvent> detectOnsetsInBand (std::vector<float>& monoBuffer,
-                                                 int numSamples,
-                                                 double sampleRate,
-                                                 float freqLow,
-                                                 float freqHigh,
-                                                 float sensitivity,
-                                                 int minGapMs = 30);
-
-    /**
-     * Write a single-track MIDI file (format 0, 480 PPQ) containing note events
-     * derived from onset events for a specific drum.
-     *
-     * @param onsets       Detected onset events
-     * @param midiNote     GM drum note number (36=kick, 38=snare, 42=hihat)
-     * @param bpm          Detected BPM (used for tempo meta-event and beat conversion)
-     * @param sampleRate   Sample rate of the audio
-     * @param destFile     Output .mid file path
-     * @return true if file was written successfully
-     */
-    bool writeDrumMidiFile (const std::vector<OnsetEvent>& onsets,
-                            int midiNote,
-                            float bpm,
-                            double sampleRate,
-                            const juce::File& destFile);
-
-    /**
-     * Write a root chord MIDI file from the key detection results.
-     *
-     * @param chordMidi    Array of 3 MIDI note numbers (root triad)
-     * @param bpm          Detected BPM (for tempo meta-event)
-     * @param destFile     Output .mid file path
-     * @return true if file was written successfully
-     */
-    bool writeChordMidiFile (const int chordMidi[3],
-                             float bpm,
-                             const juce::File& destFile);
+    groovescout::SpectralFrontEnd offlineSpectrum;   ///< Used when the live analyzer didn't cover the take
+    groovescout::AnalysisCache    cache;
+    bool   spectrumIsLive   = false;
+    int    cachedGeneration = -1;
+    int    cachedNumSamples = 0;
+    double cachedSampleRate = 0.0;
+
+    /** Stage toggles, band settings and BPM multiplier from the processor's parameters. */
+    groovescout::AnalysisSettings readSettings() const;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GrooveScoutAnalyzer)
 };
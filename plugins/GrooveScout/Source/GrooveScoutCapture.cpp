@@ -0,0 +1,534 @@
+//==============================================================================
+// GrooveScoutCapture.cpp
+//
+// Audio thread → SPSC ring → writer thread → memory-mapped spill file.
+//==============================================================================
+
+#include "GrooveScoutCapture.h"
+
+#include <cstring>
+
+#if JUCE_WINDOWS
+ #ifndef NOMINMAX
+  #define NOMINMAX
+ #endif
+ #ifndef WIN32_LEAN_AND_MEAN
+  #define WIN32_LEAN_AND_MEAN
+ #endif
+ #include <windows.h>
+ #include <winioctl.h>
+#else
+ #include <cerrno>
+ #include <signal.h>
+ #include <unistd.h>
+#endif
+
+namespace
+{
+    juce::uint32 currentProcessId() noexcept
+    {
+       #if JUCE_WINDOWS
+        return static_cast<juce::uint32> (GetCurrentProcessId());
+       #else
+        return static_cast<juce::uint32> (getpid());
+       #endif
+    }
+
+    bool isProcessRunning (juce::uint32 pid) noexcept
+    {
+       #if JUCE_WINDOWS
+        HANDLE process = OpenProcess (PROCESS_QUERY_LIMITED_INFORMATION, FALSE, static_cast<DWORD> (pid));
+
+        if (process == nullptr)
+            return GetLastError() == ERROR_ACCESS_DENIED;   // exists, but belongs to someone else
+
+        DWORD exitCode = 0;
+        const bool running = GetExitCodeProcess (process, &exitCode) && exitCode == STILL_ACTIVE;
+        CloseHandle (process);
+        return running;
+       #else
+        return kill (static_cast<pid_t> (pid), 0) == 0 || errno == EPERM;
+       #endif
+    }
+
+    /** Spill files are named capture_<pid>.s16, capture_<pid>(2).s16, ... Anything
+        whose process is gone was left by a crash. Names without a pid are from
+        builds that predate the scheme and are stale as well. */
+    void deleteStaleSpillFiles (const juce::File& dir)
+    {
+        for (const auto& entry : juce::RangedDirectoryIterator (dir, false, "capture*.s16;capture*.f32",
+                                                                juce::File::findFiles))
+        {
+            const auto file = entry.getFile();
+            const auto pid  = file.getFileNameWithoutExtension()
+                                  .fromFirstOccurrenceOf ("_", false, false)
+                                  .initialSectionContainingOnly ("0123456789");
+
+            if (pid.isEmpty() || ! isProcessRunning (static_cast<juce::uint32> (pid.getLargeIntValue())))
+            {
+                DBG ("GrooveScoutCapture: deleting stale spill file " << file.getFullPathName());
+                file.deleteFile();
+            }
+        }
+    }
+
+    /** Sets the file's length without writing any data, so the range stays unallocated. */
+    bool createSparseFile (const juce::File& file, juce::int64 numBytes)
+    {
+       #if JUCE_WINDOWS
+        // NTFS only skips unwritten ranges in files marked sparse — extending any
+        // other file zero-fills all of it on the spot
+        HANDLE handle = CreateFileW (file.getFullPathName().toWideCharPointer(), GENERIC_READ | GENERIC_WRITE,
+                                     0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+        if (handle == INVALID_HANDLE_VALUE)
+            return false;
+
+        // Best effort: FAT/exFAT volumes have no sparse files and still work, just slower
+        DWORD bytesReturned = 0;
+        DeviceIoControl (handle, FSCTL_SET_SPARSE, nullptr, 0, nullptr, 0, &bytesReturned, nullptr);
+
+        LARGE_INTEGER size;
+        size.QuadPart = numBytes;
+
+        const bool sized = SetFilePointerEx (handle, size, nullptr, FILE_BEGIN) && SetEndOfFile (handle);
+        CloseHandle (handle);
+        return sized;
+       #else
+        // ext4 and APFS leave everything before the last byte unallocated
+        juce::FileOutputStream out (file);
+
+        if (out.failedToOpen()
+            || ! out.setPosition (numBytes - 1)
+            || ! out.writeByte (0))
+            return false;
+
+        out.flush();
+        return true;
+       #endif
+    }
+}
+
+GrooveScoutCapture::GrooveScoutCapture (std::atomic<int>& recordedSamplesToAdvance,
+                                        std::atomic<bool>& waveformDirtyFlag)
+    : juce::Thread ("GrooveScoutCapture"),
+      recordedSamples (recordedSamplesToAdvance),
+      waveformDirty (waveformDirtyFlag)
+{
+}
+
+GrooveScoutCapture::~GrooveScoutCapture()
+{
+    stopThread (2000);
+    closeSpillFile();
+}
+
+//==============================================================================
+// Message thread
+//==============================================================================
+
+void GrooveScoutCapture::prepare (double newSampleRate)
+{
+    stopThread (2000);
+
+    sampleRate = newSampleRate;
+
+    // Ring: a couple of seconds is plenty of slack for a writer that polls every 10 ms
+    const int ringSamples = juce::jmax (2, static_cast<int> (sampleRate * ringSeconds));
+
+    const int previewSamples = juce::jmax (2, static_cast<int> (sampleRate * previewSeconds));
+
+    ringArena.beginLayout();
+    const auto ringRegion    = ringArena.reserve<float> (numChannels, ringSamples);
+    const auto previewRegion = ringArena.reserve<float> (numChannels, previewSamples);
+    ringArena.commit();
+    ringArena.attach (ring, ringRegion);
+    ringArena.attach (previewRing, previewRegion);
+    fifo.setTotalSize (ringSamples);
+    previewFifo.setTotalSize (previewSamples);
+
+    // Spill storage: only rebuilt when the capacity changes (i.e. the sample rate did)
+    const int wantedCapacity = static_cast<int> (sampleRate * maxCaptureSeconds);
+
+    if (wantedCapacity != capacitySamples || channelData[0] == nullptr)
+    {
+        closeSpillFile();
+
+        if (openSpillFile (wantedCapacity))
+        {
+            capacitySamples = wantedCapacity;
+        }
+        else
+        {
+            capacitySamples = static_cast<int> (sampleRate * fallbackSeconds);
+            fallbackStorage.allocate (static_cast<size_t> (capacitySamples) * numChannels, true);
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                channelData[ch] = fallbackStorage.get() + static_cast<size_t> (ch) * static_cast<size_t> (capacitySamples);
+
+            DBG ("GrooveScoutCapture: no spill file — capture limited to "
+                 << fallbackSeconds << " s in memory");
+        }
+    }
+
+    waveform.prepare (capacitySamples);
+
+    reset();
+    startThread (juce::Thread::Priority::normal);
+
+    DBG ("GrooveScoutCapture: ring " << ringSamples << " samples, capacity "
+         << capacitySamples << " samples" << (isSpillingToDisk() ? " (spill file "
+         + spillFile.getFullPathName() + ")" : juce::String()));
+}
+
+void GrooveScoutCapture::reset()
+{
+    const juce::ScopedLock sl (drainLock);
+
+    fifo.reset();
+    writeHead = 0;
+    pushedSamples.store (0);
+    droppedSamples.store (0);
+    recordedSamples.store (0);
+    waveform.reset();
+
+    // A running preview starts over on the new take
+    if (previewRequested.load() != 0)
+        startPreview();
+}
+
+GrooveScoutRecording GrooveScoutCapture::getRecording() const noexcept
+{
+    if (capacitySamples <= 0)
+        return {};
+
+    return { channelData[0], channelData[1], capacitySamples };
+}
+
+void GrooveScoutCapture::startPreview() noexcept
+{
+    previewRequested.fetch_add (1);
+    notify();
+}
+
+void GrooveScoutCapture::flush()
+{
+    drain();
+}
+
+int GrooveScoutCapture::write (const float* const* channels, int numInputChannels, int numSamples)
+{
+    const juce::ScopedLock sl (drainLock);
+
+    const int toWrite = juce::jmin (numSamples, capacitySamples - writeHead);
+
+    if (numInputChannels <= 0 || toWrite <= 0)
+        return 0;
+
+    const float* left  = channels[0];
+    const float* right = channels[juce::jmin (1, numInputChannels - 1)];
+
+    GrooveScoutRecording::encode (channelData[0] + writeHead, left,  toWrite);
+    GrooveScoutRecording::encode (channelData[1] + writeHead, right, toWrite);
+    waveform.append (left, right, toWrite);
+
+    // Same publishing order as drain(); the write head follows so push() stays consistent
+    writeHead += toWrite;
+    pushedSamples.store (writeHead);
+    recordedSamples.store (writeHead);
+    waveformDirty.store (true);
+
+    return toWrite;
+}
+
+int GrooveScoutCapture::writeEncoded (const GrooveScoutRecording::Sample* const* channels, int numSamples)
+{
+    const juce::ScopedLock sl (drainLock);
+
+    const int toWrite = juce::jmin (numSamples, capacitySamples - writeHead);
+
+    if (toWrite <= 0)
+        return 0;
+
+    for (int ch = 0; ch < numChannels; ++ch)
+        std::memcpy (channelData[ch] + writeHead, channels[ch],
+                     static_cast<size_t> (toWrite) * sizeof (GrooveScoutRecording::Sample));
+
+    // The pyramid takes float, so it reads back what was just stored, a stretch at a time
+    const auto stored = getRecording();
+    constexpr int chunkSize = 1024;
+    float left[chunkSize], right[chunkSize];
+
+    for (int done = 0; done < toWrite;)
+    {
+        const int count = juce::jmin (chunkSize, toWrite - done);
+        stored.read (0, writeHead + done, count, left);
+        stored.read (1, writeHead + done, count, right);
+        waveform.append (left, right, count);
+        done += count;
+    }
+
+    writeHead += toWrite;
+    pushedSamples.store (writeHead);
+    recordedSamples.store (writeHead);
+    waveformDirty.store (true);
+
+    return toWrite;
+}
+
+//==============================================================================
+// Audio thread
+//==============================================================================
+
+int GrooveScoutCapture::push (const float* const* channels, int numInputChannels, int numSamples) noexcept
+{
+    if (numInputChannels <= 0 || capacitySamples <= 0)
+        return 0;
+
+    const int head    = pushedSamples.load (std::memory_order_relaxed);
+    int       toWrite = juce::jmin (numSamples, capacitySamples - head);
+
+    if (toWrite <= 0)
+        return 0;
+
+    // Writer fell behind by a whole ring — drop rather than block the audio thread
+    const int freeSpace = fifo.getFreeSpace();
+    if (toWrite > freeSpace)
+    {
+        droppedSamples.fetch_add (toWrite - freeSpace);
+        toWrite = freeSpace;
+    }
+
+    if (toWrite <= 0)
+        return 0;
+
+    {
+        const auto scope = fifo.write (toWrite);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            const float* src = channels[juce::jmin (ch, numInputChannels - 1)];
+
+            if (scope.blockSize1 > 0)
+                juce::FloatVectorOperations::copy (ring.getWritePointer (ch, scope.startIndex1), src, scope.blockSize1);
+
+            if (scope.blockSize2 > 0)
+                juce::FloatVectorOperations::copy (ring.getWritePointer (ch, scope.startIndex2),
+                                                   src + scope.blockSize1, scope.blockSize2);
+        }
+    }
+
+    pushedSamples.store (head + toWrite, std::memory_order_release);
+    return toWrite;
+}
+
+int GrooveScoutCapture::readPreview (float* const* dest, int numDestChannels, int numSamples) noexcept
+{
+    const int numCh   = juce::jmin (numDestChannels, numChannels);
+    const int filling = previewFilling.load();
+    int delivered = 0;
+
+    // Until the writer has moved to the latest request, everything queued is from before it
+    if (filling == previewRequested.load())
+    {
+        if (filling != previewFlushed.load())
+        {
+            previewFifo.finishedRead (previewFifo.getNumReady());
+            previewFlushed.store (filling);
+        }
+
+        delivered = juce::jmin (numSamples, previewFifo.getNumReady());
+        const auto scope = previewFifo.read (delivered);
+
+        for (int ch = 0; ch < numCh; ++ch)
+        {
+            if (scope.blockSize1 > 0)
+                juce::FloatVectorOperations::copy (dest[ch], previewRing.getReadPointer (ch, scope.startIndex1), scope.blockSize1);
+
+            if (scope.blockSize2 > 0)
+                juce::FloatVectorOperations::copy (dest[ch] + scope.blockSize1,
+                                                   previewRing.getReadPointer (ch, scope.startIndex2), scope.blockSize2);
+        }
+    }
+
+    if (delivered < numSamples)
+        for (int ch = 0; ch < numCh; ++ch)
+            juce::FloatVectorOperations::clear (dest[ch] + delivered, numSamples - delivered);
+
+    return delivered;
+}
+
+//==============================================================================
+// Writer thread
+//==============================================================================
+
+void GrooveScoutCapture::run()
+{
+    int reportedDrops = 0;
+
+    while (! threadShouldExit())
+    {
+        drain();
+        fillPreview();
+
+        const int drops = droppedSamples.load();
+        if (drops != reportedDrops)
+        {
+            DBG ("GrooveScoutCapture: ring overflow — " << drops << " samples dropped this take");
+            reportedDrops = drops;
+        }
+
+        // Poll faster while a preview restart waits for the audio thread
+        wait (previewFilling.load() != previewFlushed.load() ? 1 : 10);
+    }
+}
+
+void GrooveScoutCapture::drain()
+{
+    const juce::ScopedLock sl (drainLock);
+
+    const int ready = juce::jmin (fifo.getNumReady(), capacitySamples - writeHead);
+
+    if (ready <= 0)
+        return;
+
+    {
+        const auto scope = fifo.read (ready);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            auto* dest = channelData[ch] + writeHead;
+
+            if (scope.blockSize1 > 0)
+                GrooveScoutRecording::encode (dest, ring.getReadPointer (ch, scope.startIndex1), scope.blockSize1);
+
+            if (scope.blockSize2 > 0)
+                GrooveScoutRecording::encode (dest + scope.blockSize1,
+                                              ring.getReadPointer (ch, scope.startIndex2), scope.blockSize2);
+        }
+
+        // The pyramid takes the float ring data, before it was quantised
+        if (scope.blockSize1 > 0)
+            waveform.append (ring.getReadPointer (0, scope.startIndex1), ring.getReadPointer (1, scope.startIndex1), scope.blockSize1);
+
+        if (scope.blockSize2 > 0)
+            waveform.append (ring.getReadPointer (0, scope.startIndex2), ring.getReadPointer (1, scope.startIndex2), scope.blockSize2);
+    }
+
+    // Publish only once the samples are in place — readers trust [0, recordedSamples)
+    writeHead += ready;
+    recordedSamples.store (writeHead);
+    waveformDirty.store (true);
+}
+
+void GrooveScoutCapture::fillPreview()
+{
+    const int requested = previewRequested.load();
+
+    if (requested == 0)
+        return;
+
+    if (previewFilling.load() != requested)
+    {
+        previewReadPosition = 0;
+        previewFilling.store (requested);
+    }
+
+    if (previewFlushed.load() != requested)
+        return;
+
+    const int recorded = recordedSamples.load();
+
+    if (recorded <= 0)
+        return;
+
+    // Page faults on the mapping land here, on the writer, not on the audio thread
+    const auto view = getRecording();
+    previewReadPosition %= recorded;
+
+    for (int toFill = previewFifo.getFreeSpace(); toFill > 0;)
+    {
+        const int count = juce::jmin (toFill, recorded - previewReadPosition);
+
+        {
+            const auto scope = previewFifo.write (count);
+
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                if (scope.blockSize1 > 0)
+                    view.read (ch, previewReadPosition, scope.blockSize1, previewRing.getWritePointer (ch, scope.startIndex1));
+
+                if (scope.blockSize2 > 0)
+                    view.read (ch, previewReadPosition + scope.blockSize1, scope.blockSize2,
+                               previewRing.getWritePointer (ch, scope.startIndex2));
+            }
+        }
+
+        previewReadPosition = (previewReadPosition + count) % recorded;
+        toFill -= count;
+    }
+}
+
+//==============================================================================
+// Spill file
+//==============================================================================
+
+bool GrooveScoutCapture::openSpillFile (int capacity)
+{
+    const auto dir = juce::File::getSpecialLocation (juce::File::tempDirectory).getChildFile ("GrooveScout");
+
+    if (! dir.createDirectory())
+        return false;
+
+    // Once per process; files of running processes (this one included) are left alone
+    static const bool staleFilesDeleted = [&dir]
+    {
+        deleteStaleSpillFiles (dir);
+        return true;
+    }();
+    juce::ignoreUnused (staleFilesDeleted);
+
+    spillFile = dir.getNonexistentChildFile ("capture_" + juce::String (currentProcessId()), ".s16", true);
+
+    const auto numBytes = static_cast<juce::int64> (capacity) * numChannels
+                          * static_cast<juce::int64> (sizeof (GrooveScoutRecording::Sample));
+
+    if (! createSparseFile (spillFile, numBytes))
+    {
+        spillFile.deleteFile();
+        spillFile = juce::File();
+        return false;
+    }
+
+    mappedFile = std::make_unique<juce::MemoryMappedFile> (spillFile, juce::MemoryMappedFile::readWrite, false);
+
+    if (mappedFile->getData() == nullptr
+        || static_cast<juce::int64> (mappedFile->getSize()) < numBytes)
+    {
+        closeSpillFile();
+        return false;
+    }
+
+    auto* base = static_cast<GrooveScoutRecording::Sample*> (mappedFile->getData());
+
+    for (int ch = 0; ch < numChannels; ++ch)
+        channelData[ch] = base + static_cast<size_t> (ch) * static_cast<size_t> (capacity);
+
+    return true;
+}
+
+void GrooveScoutCapture::closeSpillFile()
+{
+    mappedFile.reset();
+    fallbackStorage.free();
+
+    for (auto*& ptr : channelData)
+        ptr = nullptr;
+
+    capacitySamples = 0;
+
+    if (spillFile.existsAsFile())
+        spillFile.deleteFile();
+
+    spillFile = juce::File();
+}
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_core/juce_core.h>
+#include "PfsInstanceArena.h"
+#include "GrooveScoutRecording.h"
+#include "GrooveScoutWaveform.h"
+
+#include <atomic>
+#include <memory>
+
+//==============================================================================
+/**
+ * GrooveScoutCapture — long captures without a long in-memory buffer
+ *
+ *   audio thread ──push()──> SPSC ring (2 s, arena) ──writer thread──> spill file
+ *                                                                       (mmap)
+ *
+ * The audio thread only copies into a small lock-free ring (juce::AbstractFifo).
+ * A background writer drains that ring into a memory-mapped temp file laid out
+ * as planar 16-bit channels: [L × capacity][R × capacity], converting on the
+ * way. Readers (analysis, live analysis, waveform) get a GrooveScoutRecording
+ * view of the mapping via getRecording(). That view converts back to float one
+ * stretch at a time, so there is no whole-take copy.
+ *
+ * Preview is the one reader on the audio thread, and a page fault on the
+ * mapping could stall it on disk I/O. So the writer also keeps a second small
+ * ring (previewSeconds, same arena) filled with the looping take ahead of the
+ * playhead, and readPreview() only copies out of that.
+ *
+ * The file is sized up front without writing any data (on NTFS it is marked
+ * sparse first), and only written as far as the capture got. Unwritten space
+ * takes no disk, and the pages are file-backed, so the OS can evict them
+ * instead of the plugin holding hundreds of MB per instance. A 10-minute take
+ * at 48 kHz is about 110 MB, half of what float storage needed.
+ *
+ * Files are named after the process (capture_<pid>.s16). The first spill file
+ * a process opens also deletes any whose process is gone, i.e. left by a crash.
+ *
+ * If the spill file can't be created, capture falls back to an in-memory
+ * buffer of fallbackSeconds. The file lives until the processor is
+ * destroyed (or the sample rate changes), so a finished take stays
+ * available for preview and re-analysis after releaseResources().
+ *
+ * Counters:
+ *   - getPushedSamples()  audio thread's write head (samples accepted into the ring)
+ *   - recordedSamples     advanced by the writer once samples are readable in the file;
+ *                         this is the processor's existing atomic, so readers keep
+ *                         using it as before
+ *
+ * The writer also folds each drained stretch into the waveform pyramid
+ * (GrooveScoutWaveform) before publishing it, straight from the float ring. The display then reads peaks
+ * from the pyramid and never rescans the take.
+ */
+class GrooveScoutCapture : private juce::Thread
+{
+public:
+    static constexpr double maxCaptureSeconds = 600.0;   // 10 minutes
+    static constexpr double ringSeconds       = 2.0;
+    static constexpr double fallbackSeconds   = 30.0;
+    static constexpr double previewSeconds    = 0.5;
+    static constexpr int    numChannels       = GrooveScoutRecording::numChannels;
+
+    GrooveScoutCapture (std::atomic<int>& recordedSamplesToAdvance,
+                        std::atomic<bool>& waveformDirtyFlag);
+    ~GrooveScoutCapture() override;
+
+    //==========================================================================
+    // Message thread
+    //==========================================================================
+
+    /** Sizes the ring and (if the rate changed) the spill file, and starts the writer.
+        Readers must call getRecording() again afterwards. Not real-time safe. */
+    void prepare (double sampleRate);
+
+    /** Starts a new take at sample 0. Call while the audio thread is not pushing
+        (GrooveScoutAudioProcessor::rewindCapture() holds it off first). */
+    void reset();
+
+    /** View of the captured audio (numChannels × getCapacitySamples()). */
+    GrooveScoutRecording getRecording() const noexcept;
+
+    /** Blocks until everything pushed so far is readable. Any thread except the audio thread. */
+    void flush();
+
+    /** Restarts the preview read-ahead at sample 0. readPreview() is silent
+        until the writer has refilled it (a few ms). */
+    void startPreview() noexcept;
+
+    /** Appends straight to the storage, bypassing the ring (file import). Mono
+        input is mirrored like push(). Any thread except the audio thread, and
+        only while nothing is being captured. Returns how many samples fit. */
+    int write (const float* const* channels, int numInputChannels, int numSamples);
+
+    /** Same as write(), for samples already in the capture's 16-bit format
+        (a history snapshot). They are stored as they are; only the waveform
+        pyramid sees them converted. Returns how many samples fit. */
+    int writeEncoded (const GrooveScoutRecording::Sample* const* channels, int numSamples);
+
+    //==========================================================================
+    // Audio thread
+    //==========================================================================
+
+    /** Appends up to numSamples (mono input is mirrored to both channels).
+        Returns how many were accepted — fewer if capacity or the ring ran out. */
+    int push (const float* const* channels, int numInputChannels, int numSamples) noexcept;
+
+    /** Copies the next numSamples of the looping take from the preview read-ahead.
+        Never touches the spill file; whatever the writer hasn't filled yet is
+        silent. Returns how many samples were real audio. */
+    int readPreview (float* const* dest, int numDestChannels, int numSamples) noexcept;
+
+    //==========================================================================
+
+    int  getPushedSamples() const noexcept    { return pushedSamples.load(); }
+    int  getCapacitySamples() const noexcept  { return capacitySamples; }
+    int  getDroppedSamples() const noexcept   { return droppedSamples.load(); }
+    bool isSpillingToDisk() const noexcept    { return mappedFile != nullptr; }
+
+    /** Min/max pyramid of [0, recordedSamples), kept current by the writer. */
+    const GrooveScoutWaveform& getWaveform() const noexcept  { return waveform; }
+
+private:
+    void run() override;
+
+    /** Moves everything ready in the ring into the spill storage. One consumer at a time. */
+    void drain();
+
+    /** Tops up the preview read-ahead from the spill storage. Writer thread only. */
+    void fillPreview();
+
+    bool openSpillFile (int capacity);
+    void closeSpillFile();
+
+    std::atomic<int>&  recordedSamples;
+    std::atomic<bool>& waveformDirty;
+
+    double sampleRate      = 0.0;
+    int    capacitySamples = 0;
+
+    // SPSC ring — audio thread writes, drain() reads
+    juce::AbstractFifo       fifo { 1 };
+    pfs::InstanceArena       ringArena;
+    juce::AudioBuffer<float> ring;
+
+    // Spill storage — the mapping, or the in-memory fallback
+    juce::File                              spillFile;
+    std::unique_ptr<juce::MemoryMappedFile> mappedFile;
+    juce::HeapBlock<GrooveScoutRecording::Sample> fallbackStorage;
+    GrooveScoutRecording::Sample*                 channelData[numChannels] {};
+
+    std::atomic<int>     pushedSamples  { 0 };
+    std::atomic<int>     droppedSamples { 0 };
+    int                  writeHead = 0;          // drain() only
+    juce::CriticalSection drainLock;
+
+    GrooveScoutWaveform  waveform;               // appended by drain()
+
+    // Preview read-ahead — fillPreview() writes, readPreview() reads. A restart
+    // bumps previewRequested; the writer moves to it (previewFilling) but adds
+    // nothing until the audio thread has dropped the old samples (previewFlushed).
+    juce::AbstractFifo       previewFifo { 1 };
+    juce::AudioBuffer<float> previewRing;
+    std::atomic<int>         previewRequested { 0 };   // 0: no preview yet
+    std::atomic<int>         previewFilling   { 0 };
+    std::atomic<int>         previewFlushed   { 0 };
+    int                      previewReadPosition = 0;  // fillPreview() only
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GrooveScoutCapture)
+};
@@ -0,0 +1,371 @@
+//==============================================================================
+// GrooveScoutFeatures.cpp
+//
+// The shared STFT front end: one windowed FFT per hop, from which chroma,
+// the log-band spectrogram and the spectral-flux onset functions are all
+// derived.
+//==============================================================================
+
+#include "GrooveScoutFeatures.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace groovescout
+{
+    //==========================================================================
+    // HalfBandDecimator
+    //==========================================================================
+
+    void HalfBandDecimator::prepare (int numTapsToUse)
+    {
+        jassert (numTapsToUse % 4 == 3);
+        numTaps = numTapsToUse;
+
+        // h[n] = sin (πn/2) / (πn) · w[n] for odd n; even n are zero except h[0] = 0.5.
+        // Blackman window over the filter span, then scaled for unity gain at DC.
+        const int halfSpan = getDelay() + 1;
+        pairTaps.clear();
+
+        double sum = 0.0;
+
+        for (int n = 1; n < halfSpan; n += 2)
+        {
+            const double phase = juce::MathConstants<double>::pi * n / halfSpan;
+            const double w     = 0.42 + 0.5 * std::cos (phase) + 0.08 * std::cos (2.0 * phase);
+            const double sinc  = ((n / 2) % 2 == 0 ? 1.0 : -1.0) / (juce::MathConstants<double>::pi * n);
+
+            pairTaps.push_back (static_cast<float> (sinc * w));
+            sum += 2.0 * sinc * w;
+        }
+
+        for (auto& tap : pairTaps)
+            tap = static_cast<float> (tap * 0.5 / sum);
+
+        window.prepare (numTaps, 2);
+    }
+
+    void HalfBandDecimator::process (const float* input, int numSamples, std::vector<float>& output)
+    {
+        const int centre = getDelay();
+
+        window.push (input, numSamples, [&] (const float* x)
+        {
+            const float* mid = x + centre;
+            float y = 0.5f * mid[0];
+
+            for (size_t k = 0; k < pairTaps.size(); ++k)
+            {
+                const int offset = 2 * static_cast<int> (k) + 1;
+                y += pairTaps[k] * (mid[-offset] + mid[offset]);
+            }
+
+            output.push_back (y);
+        });
+    }
+
+    //==========================================================================
+    // SpectralFrontEnd
+    //==========================================================================
+
+    void SpectralFrontEnd::reset (double newSampleRate, int expectedSamples, ChromaKernel newChromaKernel)
+    {
+        const bool rebuild = (newSampleRate != sampleRate) || fft == nullptr;
+        const bool rebuildKernel = rebuild || newChromaKernel != kernelType || kernelStart.empty();
+        sampleRate = newSampleRate;
+        kernelType = newChromaKernel;
+
+        if (rebuild)
+        {
+            // Halve until the rate is in the 44.1/48 kHz family
+            decimation = 1;
+            while (sampleRate / decimation > maxAnalysisRate)
+                decimation *= 2;
+
+            analysisRate = sampleRate / decimation;
+
+            // The last stage sets the final passband, so it gets the long filter.
+            // Earlier stages only need to keep their aliases out of what the
+            // following stages pass.
+            decimators.clear();
+            decimationDelay = 0;
+
+            for (int factor = 1; factor < decimation; factor *= 2)
+            {
+                decimators.emplace_back();
+                decimators.back().prepare (factor * 2 == decimation ? 47 : 23);
+                decimationDelay += decimators.back().getDelay() * factor;
+            }
+
+            // ~46 ms window
+            fftOrder = 11;
+            fftSize  = 1 << fftOrder;
+            hopSize  = fftSize / 8;
+            numBins  = fftSize / 2;
+
+            fft    = std::make_unique<juce::dsp::FFT> (fftOrder);
+            window = std::make_unique<juce::dsp::WindowingFunction<float>> (
+                         static_cast<size_t> (fftSize), juce::dsp::WindowingFunction<float>::hann);
+
+            fftBuffer.assign (static_cast<size_t> (fftSize * 2), 0.0f);
+            binMagnitudes.assign (static_cast<size_t> (numBins), 0.0f);
+            weighted.assign (static_cast<size_t> (numBins), 0.0f);
+
+            buildTables();
+        }
+
+        if (rebuildKernel)
+            buildChromaKernel();
+
+        for (auto& stage : decimators)
+            stage.reset();
+
+        frames.prepare (fftSize, hopSize);
+        chroma.assign (chroma.size(), 0.0f);
+        numFrames = 0;
+
+        const auto expectedFrames = static_cast<size_t> (expectedSamples / getHopSize() + 1);
+        oss.clear();
+        oss.reserve (expectedFrames);
+        logBands.clear();
+        logBands.reserve (expectedFrames * bandCentreHz.size());
+    }
+
+    void SpectralFrontEnd::buildTables()
+    {
+        const double binHz = analysisRate / static_cast<double> (fftSize);
+
+        // Chroma weights: |H(f)| of an N = 4 Butterworth high-pass at 150 Hz,
+        // 1 / sqrt (1 + (fc / f)^(2N)). Bin 0 (DC) and bins under 32 Hz are skipped.
+        chromaMinBin = std::max (1, static_cast<int> (std::ceil (32.0 / binHz)));
+        chromaWeight.assign (static_cast<size_t> (numBins), 0.0f);
+
+        for (int k = chromaMinBin; k < numBins; ++k)
+        {
+            const double ratio = 150.0 / (k * binHz);
+            chromaWeight[static_cast<size_t> (k)] = static_cast<float> (1.0 / std::sqrt (1.0 + std::pow (ratio, 8.0)));
+        }
+
+        // Log bands: 1/6-octave edges from 20 Hz, but every band gets at least one bin
+        const double edgeRatio = std::pow (2.0, 1.0 / bandsPerOctave);
+        double upperEdgeHz = lowestBandEdgeHz * edgeRatio;
+
+        bandStartBin.clear();
+        bandCentreHz.clear();
+
+        for (int bin = 1; bin < numBins;)
+        {
+            const int start = bin;
+
+            do { ++bin; } while (bin < numBins && bin * binHz < upperEdgeHz);
+
+            while (upperEdgeHz <= bin * binHz)
+                upperEdgeHz *= edgeRatio;
+
+            bandStartBin.push_back (start);
+            bandCentreHz.push_back (static_cast<float> (std::sqrt (start * binHz * (bin - 1) * binHz)));
+        }
+
+        bandStartBin.push_back (numBins);
+    }
+
+    void SpectralFrontEnd::buildChromaKernel()
+    {
+        const int cellsPerOctave = (kernelType == ChromaKernel::constantQ36) ? 36 : 12;
+        const double binHz = analysisRate / static_cast<double> (fftSize);
+        const double cHz   = 440.0 * std::pow (2.0, -9.0 / 12.0);   // C4; any C would do
+
+        chroma.assign (static_cast<size_t> (cellsPerOctave), 0.0f);
+        kernelStart.assign (static_cast<size_t> (chromaMinBin), 0);
+        kernelCell.clear();
+        kernelWeight.clear();
+
+        auto wrap = [cellsPerOctave] (int cell) { return ((cell % cellsPerOctave) + cellsPerOctave) % cellsPerOctave; };
+
+        for (int k = chromaMinBin; k < numBins; ++k)
+        {
+            kernelStart.push_back (static_cast<int> (kernelCell.size()));
+            const float hp = chromaWeight[static_cast<size_t> (k)];
+
+            if (kernelType == ChromaKernel::pitchClassMap)
+            {
+                const double midiPitch = 12.0 * std::log2 (k * binHz / 440.0) + 69.0;
+                kernelCell.push_back (wrap (static_cast<int> (std::round (midiPitch))));
+                kernelWeight.push_back (hp);
+                continue;
+            }
+
+            // Constant-Q: the bin's centre is placed on the log-frequency axis
+            // in cells (cell j is centred on j) and shared linearly between the
+            // two cells either side. Bins wider than a semitone (the low end of
+            // a 2048-point FFT) can't tell neighbouring notes apart, so they
+            // count for 1 / (their width in semitones).
+            const double position   = cellsPerOctave * std::log2 (k * binHz / cHz);
+            const double widthSemis = 12.0 * std::log2 ((k + 0.5) / (k - 0.5));
+            const float  confidence = static_cast<float> (std::min (1.0, 1.0 / widthSemis));
+
+            const int   below = static_cast<int> (std::floor (position));
+            const float frac  = static_cast<float> (position - below);
+
+            kernelCell.push_back (wrap (below));
+            kernelWeight.push_back (hp * confidence * (1.0f - frac));
+            kernelCell.push_back (wrap (below + 1));
+            kernelWeight.push_back (hp * confidence * frac);
+        }
+
+        kernelStart.push_back (static_cast<int> (kernelCell.size()));
+    }
+
+    std::array<float, 12> SpectralFrontEnd::getPcp() const noexcept
+    {
+        std::array<float, 12> pcp {};
+
+        if (chroma.size() == 36)
+        {
+            for (int pc = 0; pc < 12; ++pc)
+                pcp[static_cast<size_t> (pc)] = chroma[static_cast<size_t> ((3 * pc + 35) % 36)]
+                                              + chroma[static_cast<size_t> (3 * pc)]
+                                              + chroma[static_cast<size_t> (3 * pc + 1)];
+        }
+        else if (chroma.size() == 12)
+        {
+            std::copy (chroma.begin(), chroma.end(), pcp.begin());
+        }
+
+        return pcp;
+    }
+
+    void SpectralFrontEnd::push (const float* mono, int numSamples)
+    {
+        for (size_t stage = 0; stage < decimators.size(); ++stage)
+        {
+            auto& output = decimated[stage % 2];
+            output.clear();
+            decimators[stage].process (mono, numSamples, output);
+
+            mono       = output.data();
+            numSamples = static_cast<int> (output.size());
+        }
+
+        frames.push (mono, numSamples, [this] (const float* frame) { processFrame (frame); });
+    }
+
+    void SpectralFrontEnd::processFrame (const float* frame)
+    {
+        // Copy frame into fft buffer and zero-pad imaginary part
+        std::copy (frame, frame + fftSize, fftBuffer.begin());
+        std::fill (fftBuffer.begin() + fftSize, fftBuffer.end(), 0.0f);
+
+        window->multiplyWithWindowingTable (fftBuffer.data(), static_cast<size_t> (fftSize));
+
+        // Forward FFT — result is interleaved complex [re0, im0, re1, im1, ...]
+        fft->performRealOnlyForwardTransform (fftBuffer.data(), true);
+        pfs::dsp::magnitudes (binMagnitudes.data(), fftBuffer.data(), numBins);
+
+        // ---------------------------------------------------------------------
+        // Chroma — pick the bins that count on the high-pass weighted
+        // magnitudes, amplitude floor at 1% of the frame peak (noise-floor
+        // bins would otherwise flatten the PCP), then one sparse
+        // matrix-vector product into the chroma cells
+        // ---------------------------------------------------------------------
+        juce::FloatVectorOperations::multiply (weighted.data(), binMagnitudes.data(), chromaWeight.data(), numBins);
+
+        const float framePeak = pfs::dsp::peakAbs (weighted.data() + chromaMinBin, numBins - chromaMinBin);
+        const float magFloor  = framePeak * 0.01f;
+
+        for (int k = chromaMinBin; k < numBins - 1; ++k)
+        {
+            const float mag = weighted[static_cast<size_t> (k)];
+
+            if (mag < magFloor)
+                continue;
+
+            // Spectral peaks only. At this window length a semitone can be
+            // narrower than the Hann main lobe, so the lobe's flanks would
+            // otherwise leak into the neighbouring pitch classes.
+            if (mag < weighted[static_cast<size_t> (k - 1)] || mag <= weighted[static_cast<size_t> (k + 1)])
+                continue;
+
+            const float binMag = binMagnitudes[static_cast<size_t> (k)];
+
+            for (int i = kernelStart[static_cast<size_t> (k)]; i < kernelStart[static_cast<size_t> (k + 1)]; ++i)
+                chroma[static_cast<size_t> (kernelCell[static_cast<size_t> (i)])] += binMag * kernelWeight[static_cast<size_t> (i)];
+        }
+
+        // ---------------------------------------------------------------------
+        // Log-band row + total spectral flux against the previous row
+        // ---------------------------------------------------------------------
+        const size_t numBands = bandCentreHz.size();
+        const size_t rowStart = logBands.size();
+        logBands.resize (rowStart + numBands);
+
+        float* row = logBands.data() + rowStart;
+        const float* prevRow = (numFrames > 0) ? row - numBands : nullptr;
+
+        float flux = 0.0f;
+
+        for (size_t b = 0; b < numBands; ++b)
+        {
+            float sum = 0.0f;
+            for (int k = bandStartBin[b]; k < bandStartBin[b + 1]; ++k)
+                sum += binMagnitudes[static_cast<size_t> (k)];
+
+            row[b] = std::log1p (sum);
+
+            if (prevRow != nullptr)
+                flux += std::max (0.0f, row[b] - prevRow[b]);
+        }
+
+        oss.push_back (flux);
+        ++numFrames;
+    }
+
+    std::vector<float> SpectralFrontEnd::bandFlux (float freqLow, float freqHigh) const
+    {
+        const int numBands = getNumBands();
+        int first = numBands, last = -1;
+
+        for (int b = 0; b < numBands; ++b)
+        {
+            if (bandCentreHz[static_cast<size_t> (b)] >= freqLow && bandCentreHz[static_cast<size_t> (b)] <= freqHigh)
+            {
+                first = std::min (first, b);
+                last  = std::max (last, b);
+            }
+        }
+
+        // Range narrower than a band — use the band nearest its (geometric) centre
+        if (last < 0 && numBands > 0)
+        {
+            const float centre = std::sqrt (std::max (1.0f, freqLow) * std::max (1.0f, freqHigh));
+            float bestDistance = std::numeric_limits<float>::max();
+
+            for (int b = 0; b < numBands; ++b)
+            {
+                const float distance = std::abs (std::log2 (bandCentreHz[static_cast<size_t> (b)] / centre));
+                if (distance < bestDistance)
+                {
+                    bestDistance = distance;
+                    first = last = b;
+                }
+            }
+        }
+
+        std::vector<float> flux (static_cast<size_t> (numFrames), 0.0f);
+
+        for (int n = 1; n < numFrames; ++n)
+        {
+            const float* row     = logBands.data() + static_cast<size_t> (n) * static_cast<size_t> (numBands);
+            const float* prevRow = row - numBands;
+
+            float sum = 0.0f;
+            for (int b = first; b <= last; ++b)
+                sum += std::max (0.0f, row[b] - prevRow[b]);
+
+            flux[static_cast<size_t> (n)] = sum;
+        }
+
+        return flux;
+    }
+}
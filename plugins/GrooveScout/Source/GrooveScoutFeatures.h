@@ -0,0 +1,296 @@
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include "PfsDspKernels.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+//==============================================================================
+/**
+ * GrooveScoutFeatures — the streaming front end behind the analysis
+ *
+ * One short-time Fourier transform over the recording feeds every stage:
+ *
+ *                               ┌─> chroma (PCP)           → key
+ *     mono ──> STFT magnitudes ─┼─> log-band spectrogram ──┬─> total flux (OSS) → tempo
+ *                               │   (stored)               └─> per-band flux    → drum onsets
+ *
+ * SpectralFrontEnd consumes mono audio in chunks of any size and ends up with
+ * exactly what one offline pass over the whole buffer would produce: partial
+ * frames carry across push() calls and frames are cut at the same positions.
+ * That lets the same code run two ways:
+ *   - live, from GrooveScoutLiveAnalyzer while the user is still recording
+ *   - offline, from GrooveScoutAnalyzer, feeding the finished buffer
+ *
+ * Only the per-frame work lives here. The final decisions (autocorrelation
+ * peak pick, Krumhansl correlation, onset thresholding) stay in the analyzer
+ * and run on whichever set of features is available.
+ *
+ * Not thread-safe: one thread pushes at a time. Allocation is fine here, as
+ * none of this runs on the audio thread.
+ */
+namespace groovescout
+{
+    //==========================================================================
+    /** Cuts a sample stream into overlapping frames and carries the remainder. */
+    class FrameStream
+    {
+    public:
+        void prepare (int windowSizeToUse, int hopSizeToUse)
+        {
+            windowSize = windowSizeToUse;
+            hopSize    = hopSizeToUse;
+            pending.clear();
+        }
+
+        void reset() noexcept { pending.clear(); }
+
+        /** Calls onFrame (const float* frame) for every complete frame. */
+        template <typename Callback>
+        void push (const float* samples, int numSamples, Callback&& onFrame)
+        {
+            pending.insert (pending.end(), samples, samples + numSamples);
+
+            size_t pos = 0;
+            while (pos + static_cast<size_t> (windowSize) <= pending.size())
+            {
+                onFrame (pending.data() + pos);
+                pos += static_cast<size_t> (hopSize);
+            }
+
+            pending.erase (pending.begin(), pending.begin() + static_cast<std::ptrdiff_t> (pos));
+        }
+
+    private:
+        int windowSize = 1;
+        int hopSize    = 1;
+        std::vector<float> pending;
+    };
+
+    //==========================================================================
+    /**
+     * Streaming 2:1 decimator built on a linear-phase half-band FIR.
+     *
+     * Every other tap of a half-band filter is zero apart from the centre
+     * (0.5), so in polyphase form one branch is a plain delay and the other is
+     * a short symmetric FIR. Each output costs numTaps / 4 + 1 multiplies, and
+     * no output that would be thrown away is computed. The taps are a
+     * Blackman-windowed sinc (about 74 dB stopband).
+     *
+     * The window is a FrameStream with a hop of 2, so chunk sizes may be odd
+     * and output m always corresponds to input sample 2m + getDelay().
+     */
+    class HalfBandDecimator
+    {
+    public:
+        /** numTaps must be 4k - 1. More taps give a narrower transition band:
+            roughly 5.5 / numTaps of the input rate, centred on the output Nyquist. */
+        void prepare (int numTaps);
+        void reset() noexcept   { window.reset(); }
+
+        /** Appends whatever outputs the new input completes. */
+        void process (const float* input, int numSamples, std::vector<float>& output);
+
+        /** Input samples between an input sample and the output it lands on. */
+        int getDelay() const noexcept   { return (numTaps - 1) / 2; }
+
+    private:
+        int                numTaps = 3;
+        std::vector<float> pairTaps;    // h[centre ± (2k + 1)], k = 0 ..
+        FrameStream        window;
+    };
+
+    //==========================================================================
+    /**
+     * Sum of the most recent `length` values, updated in O(1) per push
+     * whatever the window length. Values entering and leaving go through a
+     * Neumaier-compensated double accumulator, so sliding across millions of
+     * frames doesn't drift from the direct sum.
+     */
+    class SlidingWindowSum
+    {
+    public:
+        void reset (int length)
+        {
+            values.assign (static_cast<size_t> (std::max (1, length)), 0.0);
+            next = 0;
+            count = 0;
+            sum = 0.0;
+            compensation = 0.0;
+        }
+
+        void push (double value) noexcept
+        {
+            if (count == static_cast<int> (values.size()))
+                accumulate (-values[next]);
+            else
+                ++count;
+
+            values[next] = value;
+            accumulate (value);
+            next = (next + 1) % values.size();
+        }
+
+        double getSum() const noexcept     { return sum + compensation; }
+        int    getCount() const noexcept   { return count; }
+        bool   isFull() const noexcept     { return count == static_cast<int> (values.size()); }
+
+    private:
+        void accumulate (double value) noexcept
+        {
+            const double t = sum + value;
+
+            if (std::abs (sum) >= std::abs (value))
+                compensation += (sum - t) + value;
+            else
+                compensation += (value - t) + sum;
+
+            sum = t;
+        }
+
+        std::vector<double> values;
+        size_t next  = 0;
+        int    count = 0;
+        double sum          = 0.0;
+        double compensation = 0.0;
+    };
+
+    //==========================================================================
+    /**
+     * Shared STFT and the features derived from it.
+     *
+     * The STFT always runs at 44.1/48 kHz. Higher input rates are first
+     * brought down by a cascade of HalfBandDecimator stages (88.2/96 kHz by 2,
+     * 176.4/192 kHz by 4). Everything GrooveScout looks at, up to the top of
+     * the hihat range, sits below 20 kHz, so the extra bandwidth would only
+     * cost frames and bins. The analysis cost per second of audio is about
+     * the same at every host rate. Hop sizes and frame centres are reported in
+     * input samples, so callers never see the decimation.
+     *
+     * Hann window of 2048 samples, hop = window / 8, which is about 5 ms.
+     * Each frame's magnitudes are used three ways:
+     *
+     *   - DSP.3 chroma: bins below 1% of the frame peak and bins that aren't
+     *     spectral peaks are dropped, then the rest go through one sparse
+     *     bin → chroma matrix (see ChromaKernel). The matrix is built once per
+     *     sample rate and already includes the magnitude response of a
+     *     4th-order 150 Hz Butterworth high-pass, which keeps kick
+     *     fundamentals out, and the 32 Hz cut-off.
+     *   - Log-band spectrogram: bins are summed into 1/6-octave bands (never
+     *     narrower than one bin) and compressed with log(1 + x). This is the
+     *     only thing stored per frame. At 48 kHz that is about 50 bands ×
+     *     4 bytes per hop, or roughly 22 MB for a 10-minute take. The
+     *     full-resolution spectrogram would be about 20× that.
+     *   - DSP.2 OSS: rectified spectral flux summed over every band.
+     *
+     * DSP.4 onsets are derived afterwards with bandFlux(), which sums the flux
+     * over whichever bands the user's frequency range covers. Changing a
+     * drum's range therefore never needs another pass over the audio.
+     */
+    class SpectralFrontEnd
+    {
+    public:
+        static constexpr int    bandsPerOctave  = 6;
+        static constexpr double lowestBandEdgeHz = 20.0;
+        static constexpr double maxAnalysisRate  = 64000.0;   ///< Inputs above this are decimated
+
+        /** How FFT bins are folded into chroma.
+              pitchClassMap  each bin goes whole to its nearest pitch class
+              constantQ12    each bin is shared linearly between the two
+                             nearest semitone cells on a log-frequency axis;
+                             bins wider than a semitone count for less
+              constantQ36    the same at 1/3 semitone. A detuned recording
+                             lands in a side cell rather than flipping pitch
+                             class; getPcp() folds each semitone's three
+                             cells back together */
+        enum class ChromaKernel { pitchClassMap, constantQ12, constantQ36 };
+
+        SpectralFrontEnd() = default;
+
+        /** Sets up the STFT for this rate. expectedSamples only pre-sizes storage.
+            Tables are rebuilt only when the rate or the chroma kernel changes. */
+        void reset (double sampleRate, int expectedSamples = 0,
+                    ChromaKernel chromaKernel = ChromaKernel::constantQ36);
+        void push (const float* mono, int numSamples);
+
+        double getSampleRate() const noexcept     { return sampleRate; }     ///< Input rate
+        double getAnalysisRate() const noexcept   { return analysisRate; }   ///< Rate the STFT runs at
+        int    getDecimation() const noexcept     { return decimation; }
+        int    getFftSize() const noexcept        { return fftSize; }        ///< In analysis samples
+        int    getHopSize() const noexcept        { return hopSize * decimation; }  ///< In input samples
+        int    getNumFrames() const noexcept      { return numFrames; }
+
+        /** Input sample offset of a frame's centre. */
+        int getFrameCentre (int frame) const noexcept
+        {
+            return (frame * hopSize + fftSize / 2) * decimation + decimationDelay;
+        }
+
+        //======================================================================
+        /** Onset strength signal for tempo: Σ over all bands of max (0, ΔL). */
+        const std::vector<float>& getOss() const noexcept   { return oss; }
+
+        /** Un-normalised pitch class profile: C, C#, ..., B. */
+        std::array<float, 12> getPcp() const noexcept;
+
+        /** The chroma at the kernel's own resolution (12 or 36 cells, cell 0 centred on C). */
+        const std::vector<float>& getChroma() const noexcept   { return chroma; }
+
+        /** Rectified spectral flux over the bands whose centres fall in
+            [freqLow, freqHigh] (or the single nearest band if none do). */
+        std::vector<float> bandFlux (float freqLow, float freqHigh) const;
+
+        int getNumBands() const noexcept   { return static_cast<int> (bandCentreHz.size()); }
+
+    private:
+        void buildTables();
+        void buildChromaKernel();
+        void processFrame (const float* frame);
+
+        double sampleRate   = 0.0;
+        double analysisRate = 0.0;
+        int    fftOrder     = 0;
+        int    fftSize      = 0;
+        int    hopSize      = 0;     // analysis samples
+        int    numBins      = 0;     // 0 .. fftSize/2 - 1 (Nyquist dropped)
+
+        // Input → analysis rate: one half-band stage per factor of 2, first stage first
+        std::vector<HalfBandDecimator> decimators;
+        std::vector<float>             decimated[2];   // ping-pong between stages
+        int                            decimation      = 1;
+        int                            decimationDelay = 0;   // input samples, whole cascade
+
+        std::unique_ptr<juce::dsp::FFT>                      fft;
+        std::unique_ptr<juce::dsp::WindowingFunction<float>> window;
+        std::vector<float>                                   fftBuffer;
+        std::vector<float>                                   binMagnitudes;
+
+        // Chroma. The kernel is a sparse matrix stored by column: bin k
+        // contributes kernelWeight[i] to chroma[kernelCell[i]] for
+        // i in [kernelStart[k], kernelStart[k + 1]).
+        ChromaKernel       kernelType = ChromaKernel::constantQ36;
+        std::vector<float> chromaWeight;          // per bin: high-pass response, 0 where skipped
+        std::vector<int>   kernelStart;
+        std::vector<int>   kernelCell;
+        std::vector<float> kernelWeight;
+        std::vector<float> weighted;              // scratch: one frame's weighted magnitudes
+        std::vector<float> chroma;                // accumulated, cellsPerOctave entries
+        int                chromaMinBin = 1;
+
+        // Log bands: band b covers bins [bandStartBin[b], bandStartBin[b + 1])
+        std::vector<int>   bandStartBin;
+        std::vector<float> bandCentreHz;
+        std::vector<float> logBands;              // numFrames × numBands, row-major
+        std::vector<float> oss;
+
+        FrameStream frames;
+        int         numFrames = 0;
+
+        JUCE_DECLARE_NON_COPYABLE (SpectralFrontEnd)
+    };
+}
@@ -0,0 +1,183 @@
+//==============================================================================
+// GrooveScoutHistory.cpp
+//
+// Always-on 16-bit ring of the input, plus the host position needed to cut
+// whole bars out of it.
+//==============================================================================
+
+#include "GrooveScoutHistory.h"
+#include "GrooveScoutCapture.h"
+
+#include <cmath>
+
+//==============================================================================
+// Message thread
+//==============================================================================
+
+void GrooveScoutHistory::prepare (double newSampleRate)
+{
+    sampleRate   = newSampleRate;
+    guardSamples = static_cast<int> (sampleRate * guardSeconds);
+    capacity     = static_cast<int> (sampleRate * historySeconds) + guardSamples;
+
+    arena.beginLayout();
+    const auto region = arena.reserve<GrooveScoutRecording::Sample> (numChannels, capacity);
+    arena.commit();
+
+    for (int ch = 0; ch < numChannels; ++ch)
+        channelData[ch] = arena.data<GrooveScoutRecording::Sample> (region, ch);
+
+    writtenSamples.store (0);
+
+    {
+        const juce::SpinLock::ScopedLockType lock (transportLock);
+        transport = {};
+    }
+
+    DBG ("GrooveScoutHistory: " << historySeconds << " s ring, "
+         << juce::String (static_cast<double> (arena.getFootprintBytes()) / (1024.0 * 1024.0), 1) << " MB");
+}
+
+GrooveScoutHistory::Span GrooveScoutHistory::findLastBars (int numBars) const
+{
+    const auto written = getWrittenSamples();
+    const Span everything { getOldestReadable (written), written, 0 };
+
+    Transport t;
+    {
+        const juce::SpinLock::ScopedLockType lock (transportLock);
+        t = transport;
+    }
+
+    if (! t.valid || numBars <= 0 || sampleRate <= 0.0)
+        return everything;
+
+    const double samplesPerQuarter = sampleRate * 60.0 / t.bpm;
+    const double barQuarters       = 4.0 * t.numerator / t.denominator;
+    const double barSamples        = barQuarters * samplesPerQuarter;
+
+    // The last bar line crossed before the transport was last seen (now, or where it stopped)
+    const double seenUntilPpq = t.ppq + static_cast<double> (t.playedUntil - t.sample) / samplesPerQuarter;
+    const double barsPlayed   = std::floor ((seenUntilPpq - t.barStartPpq) / barQuarters + 1.0e-6);
+    const double lastBarPpq   = t.barStartPpq + barsPlayed * barQuarters;
+
+    const auto end = juce::jmin (written, t.sample + static_cast<juce::int64> (std::llround ((lastBarPpq - t.ppq) * samplesPerQuarter)));
+
+    const int bars = juce::jmin (numBars, static_cast<int> (std::floor (static_cast<double> (end - everything.start) / barSamples)));
+
+    // Stopped so long ago that not one bar of it is left
+    if (bars <= 0)
+        return everything;
+
+    const auto start = juce::jmax (everything.start, end - static_cast<juce::int64> (std::llround (bars * barSamples)));
+    return { start, end, bars };
+}
+
+bool GrooveScoutHistory::copyTo (GrooveScoutCapture& capture, const Span& span) const
+{
+    if (capacity <= 0 || span.getLength() <= 0)
+        return true;
+
+    // The in-memory fallback capture is shorter than the ring — keep the newest part
+    const auto start = juce::jmax (span.start, span.end - capture.getCapacitySamples());
+
+    // The ring holds the capture's own 16-bit samples: copy them as they are,
+    // one stretch per ring wrap
+    for (auto position = start; position < span.end;)
+    {
+        const int ringPosition = static_cast<int> (position % capacity);
+        const int count        = static_cast<int> (juce::jmin<juce::int64> (span.end - position, capacity - ringPosition));
+
+        const GrooveScoutRecording::Sample* stretch[numChannels] = { channelData[0] + ringPosition,
+                                                                     channelData[1] + ringPosition };
+
+        if (capture.writeEncoded (stretch, count) < count)
+            break;
+
+        position += count;
+    }
+
+    // Everything read must still be in the ring, or part of it was overwritten mid-copy
+    return getWrittenSamples() - capacity <= start;
+}
+
+//==============================================================================
+// Audio thread
+//==============================================================================
+
+void GrooveScoutHistory::push (const float* const* channels, int numInputChannels, int numSamples,
+                               juce::AudioPlayHead* playHead) noexcept
+{
+    if (capacity <= 0 || numInputChannels <= 0 || numSamples <= 0)
+        return;
+
+    const auto blockStart = writtenSamples.load (std::memory_order_relaxed);
+
+    // A block longer than the ring only leaves its tail behind
+    int done     = juce::jmax (0, numSamples - capacity);
+    int position = static_cast<int> ((blockStart + done) % capacity);
+
+    while (done < numSamples)
+    {
+        const int count = juce::jmin (numSamples - done, capacity - position);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            GrooveScoutRecording::encode (channelData[ch] + position,
+                                          channels[juce::jmin (ch, numInputChannels - 1)] + done, count);
+
+        done    += count;
+        position = 0;
+    }
+
+    writtenSamples.store (blockStart + numSamples, std::memory_order_release);
+
+    // After the samples, so a reader never sees a position past the written audio
+    updateTransport (playHead, blockStart, numSamples);
+}
+
+void GrooveScoutHistory::updateTransport (juce::AudioPlayHead* playHead, juce::int64 blockStart, int numSamples) noexcept
+{
+    if (playHead == nullptr)
+        return;
+
+    const auto position = playHead->getPosition();
+
+    if (! position.hasValue() || ! position->getIsPlaying())
+        return;
+
+    const auto ppq = position->getPpqPosition();
+    const auto bpm = position->getBpm();
+
+    if (! ppq.hasValue() || ! bpm.hasValue() || *bpm <= 0.0)
+        return;
+
+    Transport now;
+    now.valid       = true;
+    now.sample      = blockStart;
+    now.playedUntil = blockStart + numSamples;
+    now.ppq         = *ppq;
+    now.bpm         = *bpm;
+
+    if (const auto bar = position->getPpqPositionOfLastBarStart(); bar.hasValue())
+        now.barStartPpq = *bar;
+
+    if (const auto signature = position->getTimeSignature(); signature.hasValue()
+        && signature->numerator > 0 && signature->denominator > 0)
+    {
+        now.numerator   = signature->numerator;
+        now.denominator = signature->denominator;
+    }
+
+    // Never wait for the message thread: if it is reading, the next block updates instead
+    const juce::SpinLock::ScopedTryLockType lock (transportLock);
+
+    if (lock.isLocked())
+        transport = now;
+}
+
+//==============================================================================
+
+juce::int64 GrooveScoutHistory::getOldestReadable (juce::int64 written) const noexcept
+{
+    return juce::jmax<juce::int64> (0, written - (capacity - guardSamples));
+}
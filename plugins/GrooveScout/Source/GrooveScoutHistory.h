@@ -0,0 +1,125 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_core/juce_core.h>
+#include "PfsInstanceArena.h"
+#include "GrooveScoutRecording.h"
+
+#include <atomic>
+
+class GrooveScoutCapture;
+
+//==============================================================================
+/**
+ * GrooveScoutHistory — the last minute of input, always
+ *
+ * Grooves often turn out to be worth analysing only after they have played.
+ * The audio thread writes every block into this ring, whether or not REC is
+ * armed. "Analyze last 8 bars" then copies the newest whole bars into the
+ * capture and analyses them as an ordinary take:
+ *
+ *   audio thread ──push()──> ring (historySeconds, 16-bit, arena)
+ *                               │ plus the latest transport position
+ *   message thread ─findLastBars()─> span ─copyTo()─> GrooveScoutCapture
+ *
+ * Cost while left on: one float → int16 conversion per channel per block
+ * (pfs::dsp::floatToInt16), plus a try-locked copy of the host position.
+ * No allocation, no locks the audio thread can wait on, no I/O. Memory is
+ * about 12 MB at 48 kHz.
+ *
+ * Bar alignment follows the host transport (getPlayHead()). Each block
+ * while playing records its ppq, tempo, time signature and last bar start
+ * against the absolute sample it started at. The snapshot ends on the last
+ * bar line the transport crossed, which is "now" while playing and the stop
+ * point once stopped. It reaches back a whole number of bars at the latest
+ * tempo. Tempo changes inside the span are not followed. Without a playing
+ * transport there is no bar grid, so the snapshot is everything the ring
+ * holds.
+ *
+ * Lock-free in the single-writer sense: only the audio thread writes the
+ * ring and the write counter. A reader never reads closer than guardSeconds
+ * to the oldest sample, and copyTo() checks afterwards that nothing it read
+ * was overwritten meanwhile.
+ */
+class GrooveScoutHistory
+{
+public:
+    static constexpr double historySeconds = 60.0;   // what a snapshot can reach back
+    static constexpr double guardSeconds   = 2.0;    // extra ring the writer may fill during a copy
+    static constexpr int    numChannels    = GrooveScoutRecording::numChannels;
+
+    /** [start, end) in samples written since prepare(); bars == 0 if not bar-aligned. */
+    struct Span
+    {
+        juce::int64 start = 0;
+        juce::int64 end   = 0;
+        int         bars  = 0;
+
+        juce::int64 getLength() const noexcept  { return end - start; }
+    };
+
+    GrooveScoutHistory() = default;
+
+    //==========================================================================
+    // Message thread
+    //==========================================================================
+
+    /** Sizes the ring for this rate and empties it. Not real-time safe. */
+    void prepare (double sampleRate);
+
+    /** The newest numBars whole bars, fewer if the ring doesn't reach back that
+        far, or everything held if the transport never played. */
+    Span findLastBars (int numBars) const;
+
+    /** Writes the span into a capture that was just reset, sample for sample
+        (GrooveScoutCapture::writeEncoded()). False if the audio thread
+        overwrote part of it before the copy finished. */
+    bool copyTo (GrooveScoutCapture& capture, const Span& span) const;
+
+    //==========================================================================
+    // Audio thread
+    //==========================================================================
+
+    /** Appends the block (mono input is mirrored) and, if the host transport
+        is playing, remembers where it is. */
+    void push (const float* const* channels, int numInputChannels, int numSamples,
+               juce::AudioPlayHead* playHead) noexcept;
+
+    //==========================================================================
+
+    juce::int64 getWrittenSamples() const noexcept  { return writtenSamples.load (std::memory_order_acquire); }
+
+private:
+    /** Host position at the start of the newest playing block. */
+    struct Transport
+    {
+        bool        valid = false;
+        juce::int64 sample = 0;              // absolute sample the block started at
+        juce::int64 playedUntil = 0;         // end of that block
+        double      ppq = 0.0;
+        double      barStartPpq = 0.0;       // 0 if the host doesn't report it
+        double      bpm = 120.0;
+        int         numerator = 4;
+        int         denominator = 4;
+    };
+
+    void updateTransport (juce::AudioPlayHead* playHead, juce::int64 blockStart, int numSamples) noexcept;
+
+    /** Oldest sample a reader may use, given the write counter. */
+    juce::int64 getOldestReadable (juce::int64 written) const noexcept;
+
+    double sampleRate   = 0.0;
+    int    capacity     = 0;   // ring length in samples
+    int    guardSamples = 0;
+
+    pfs::InstanceArena           arena;
+    GrooveScoutRecording::Sample* channelData[numChannels] {};
+
+    std::atomic<juce::int64> writtenSamples { 0 };   // audio thread only writes
+
+    // Audio thread try-locks it and skips the update if the message thread holds it
+    mutable juce::SpinLock transportLock;
+    Transport              transport;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GrooveScoutHistory)
+};
@@ -0,0 +1,147 @@
+//==============================================================================
+// GrooveScoutImport.cpp
+//
+// File → AudioFormatReader → (anti-alias low-pass → Lagrange resampler)
+//      → GrooveScoutCapture::write().
+//==============================================================================
+
+#include "GrooveScoutImport.h"
+#include "PfsDspKernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+GrooveScoutImport::GrooveScoutImport()
+{
+    formats.registerBasicFormats();
+}
+
+bool GrooveScoutImport::canImport (const juce::File& file) const
+{
+    return file.existsAsFile()
+           && formats.findFormatForFileExtension (file.getFileExtension()) != nullptr;
+}
+
+juce::String GrooveScoutImport::getWildcard() const
+{
+    return formats.getWildcardForAllFormats();
+}
+
+//==============================================================================
+
+GrooveScoutImport::Result GrooveScoutImport::decode (const juce::File& file, GrooveScoutCapture& capture, double sampleRate,
+                                                     const std::function<void (float)>& progress,
+                                                     const std::function<bool()>& shouldExit)
+{
+    // A manager per decode, so the job never shares reader state with the message thread
+    juce::AudioFormatManager decoders;
+    decoders.registerBasicFormats();
+
+    std::unique_ptr<juce::AudioFormatReader> reader (decoders.createReaderFor (file));
+
+    if (reader == nullptr || reader->lengthInSamples <= 0 || reader->sampleRate <= 0.0 || sampleRate <= 0.0)
+        return Result::unreadable;
+
+    const auto   length      = reader->lengthInSamples;
+    const bool   isMono      = reader->numChannels == 1;
+    const int    numChannels = isMono ? 1 : 2;   // the capture mirrors mono to both channels
+    const double ratio       = reader->sampleRate / sampleRate;   // file samples per host sample
+    const bool   resample    = std::abs (ratio - 1.0) > 1.0e-9;
+
+    DBG ("GrooveScoutImport: " << file.getFileName() << ", " << reader->sampleRate << " Hz, "
+         << length << " samples" << (resample ? " (resampling)" : ""));
+
+    constexpr int chunkSize = 1 << 16;
+    juce::AudioBuffer<float> chunk (2, chunkSize);
+
+    // Resampler input the interpolator hasn't consumed yet, carried across chunks
+    juce::LagrangeInterpolator interpolators[2];
+    std::vector<float>         pending[2];
+    juce::AudioBuffer<float>   resampled;
+    constexpr int lookAhead = 4;
+
+    // Lagrange has no anti-alias filter, so a higher-rate file is low-passed first:
+    // 16th-order Butterworth at 0.4 × the host rate, as cascaded biquads with L and
+    // R as lanes. Anything that would fold back below that is down by 55 dB or more.
+    constexpr int numAntiAliasSections = 8;
+    pfs::dsp::BiquadBank4      antiAlias[numAntiAliasSections];
+    pfs::dsp::BiquadBank4State antiAliasState[numAntiAliasSections];
+    const bool downsample = resample && ratio > 1.0;
+
+    if (downsample)
+    {
+        for (int k = 0; k < numAntiAliasSections; ++k)
+        {
+            const double q = 1.0 / (2.0 * std::cos ((2 * k + 1) * juce::MathConstants<double>::pi
+                                                    / (4.0 * numAntiAliasSections)));
+            const auto c = juce::IIRCoefficients::makeLowPass (reader->sampleRate, 0.4 * sampleRate, q);
+
+            for (int lane = 0; lane < 2; ++lane)
+                antiAlias[k].setLane (lane, { c.coefficients[0], c.coefficients[1], c.coefficients[2],
+                                              c.coefficients[3], c.coefficients[4] });
+        }
+    }
+
+    // Output the whole file should give at the host rate; the last chunk pads the
+    // interpolator's look-ahead with silence so the tail isn't dropped
+    const auto expectedOut = static_cast<juce::int64> (static_cast<double> (length) / ratio);
+    juce::int64 written = 0;
+
+    for (juce::int64 position = 0; position < length; position += chunkSize)
+    {
+        if (shouldExit && shouldExit())
+            return Result::cancelled;
+
+        const int count = static_cast<int> (std::min<juce::int64> (chunkSize, length - position));
+
+        // A decode error part-way through keeps what was read so far
+        if (! reader->read (&chunk, 0, count, position, true, ! isMono))
+            return position > 0 ? Result::imported : Result::unreadable;
+
+        const float* const* output = chunk.getArrayOfReadPointers();
+        int numOut = count;
+
+        if (resample)
+        {
+            if (downsample)
+                pfs::dsp::filterBank (chunk.getArrayOfWritePointers(), numChannels, count,
+                                      antiAlias, antiAliasState, numAntiAliasSections);
+
+            const bool lastChunk = position + count >= length;
+            const int  padding   = lastChunk ? lookAhead : 0;
+            const auto available = static_cast<double> (pending[0].size()) + count + padding;
+
+            numOut = std::max (0, static_cast<int> ((available - lookAhead) / ratio));
+
+            if (lastChunk)
+                numOut = static_cast<int> (std::max<juce::int64> (0, std::min<juce::int64> (numOut, expectedOut - written)));
+
+            resampled.setSize (2, numOut, false, false, true);
+
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                auto& in = pending[ch];
+                in.insert (in.end(), chunk.getReadPointer (ch), chunk.getReadPointer (ch) + count);
+                in.insert (in.end(), static_cast<size_t> (padding), 0.0f);
+
+                const int used = interpolators[ch].process (ratio, in.data(), resampled.getWritePointer (ch),
+                                                            numOut, static_cast<int> (in.size()), 0);
+                in.erase (in.begin(), in.begin() + used);
+            }
+
+            output = resampled.getArrayOfReadPointers();
+        }
+
+        // Full: the rest of the file is past maxCaptureSeconds
+        if (capture.write (output, numChannels, numOut) < numOut)
+            break;
+
+        written += numOut;
+
+        if (progress)
+            progress (static_cast<float> (static_cast<double> (position + count) / static_cast<double> (length)));
+    }
+
+    return Result::imported;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_core/juce_core.h>
+#include "GrooveScoutCapture.h"
+
+#include <functional>
+
+//==============================================================================
+/**
+ * GrooveScoutImport — audio files straight into the recording
+ *
+ * The other way to fill the take, besides playing audio through REC. A file
+ * is decoded a chunk at a time with juce::AudioFormatManager (WAV, AIFF,
+ * FLAC, Ogg, and MP3 where the platform codec allows). Each chunk is brought
+ * to the host rate with a Lagrange interpolator when the rates differ (after
+ * an anti-alias low-pass when the file's rate is higher), then written
+ * through GrooveScoutCapture::write() into the same 16-bit storage REC fills. Everything downstream (analysis, waveform, preview, MIDI
+ * timing) then sees an ordinary take at the host rate.
+ *
+ * Decoding runs as fast as the codec allows, a few hundred times real time
+ * for PCM files. It runs inside the analysis job (see
+ * GrooveScoutAnalyzer::startImport()), so it shares the worker pool's core
+ * cap and stops when the analysis is cancelled.
+ *
+ * Anything longer than the capture capacity (maxCaptureSeconds) is cut off
+ * there.
+ */
+class GrooveScoutImport
+{
+public:
+    enum class Result { imported, cancelled, unreadable };
+
+    GrooveScoutImport();
+
+    /** Whether the file has an extension one of the registered formats reads. Message thread. */
+    bool canImport (const juce::File& file) const;
+
+    /** "*.wav;*.aiff;..." for a file chooser. */
+    juce::String getWildcard() const;
+
+    /**
+     * Writes the file, resampled to sampleRate, into a capture that was just
+     * reset. Call from the analysis job, while nothing is being captured.
+     * progress gets 0 → 1 as decoding goes; shouldExit is polled between
+     * chunks.
+     */
+    static Result decode (const juce::File& file, GrooveScoutCapture& capture, double sampleRate,
+                          const std::function<void (float)>& progress,
+                          const std::function<bool()>& shouldExit);
+
+private:
+    juce::AudioFormatManager formats;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GrooveScoutImport)
+};
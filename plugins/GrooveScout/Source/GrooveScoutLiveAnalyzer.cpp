@@ -0,0 +1,106 @@
+//==============================================================================
+// GrooveScoutLiveAnalyzer.cpp
+//
+// Follows the capture head while recording and keeps the streaming feature
+// trackers up to date, so Analyze only has the final steps left to do.
+//==============================================================================
+
+#include "GrooveScoutLiveAnalyzer.h"
+#include "PluginProcessor.h"
+
+GrooveScoutLiveAnalyzer::GrooveScoutLiveAnalyzer (GrooveScoutAudioProcessor& p)
+    : juce::Thread ("GrooveScoutLiveAnalyzer"), proc (p)
+{
+    monoChunk.resize (static_cast<size_t> (maxChunkSamples));
+}
+
+GrooveScoutLiveAnalyzer::~GrooveScoutLiveAnalyzer()
+{
+    stopThread (2000);
+}
+
+//==============================================================================
+// Lifecycle
+//==============================================================================
+
+void GrooveScoutLiveAnalyzer::begin()
+{
+    stopThread (2000);
+
+    sampleRate = proc.currentSampleRate;
+
+    // Pre-size storage for the capture duration the user asked for
+    const int expectedSamples = juce::jmin (proc.recording.getCapacity(),
+                                            static_cast<int> (proc.getCaptureDurationSeconds() * sampleRate));
+
+    spectrum.reset (sampleRate, expectedSamples);
+
+    consumedSamples = 0;
+    valid           = true;
+
+    startThread (juce::Thread::Priority::low);
+    DBG ("GrooveScoutLiveAnalyzer: following capture");
+}
+
+void GrooveScoutLiveAnalyzer::invalidate()
+{
+    stopThread (2000);
+    valid = false;
+}
+
+bool GrooveScoutLiveAnalyzer::finish (int numRecorded)
+{
+    stopThread (2000);
+
+    if (! valid || sampleRate != proc.currentSampleRate || numRecorded < consumedSamples)
+        return false;
+
+    while (consumedSamples < numRecorded)
+        consumeNextChunk (numRecorded);
+
+    DBG ("GrooveScoutLiveAnalyzer: " << numRecorded << " samples ready ("
+         << spectrum.getNumFrames() << " STFT frames, "
+         << spectrum.getNumBands() << " bands)");
+    return true;
+}
+
+//==============================================================================
+// Thread
+//==============================================================================
+
+void GrooveScoutLiveAnalyzer::run()
+{
+    while (! threadShouldExit())
+    {
+        const bool capturing   = proc.isCapturing.load();
+        const int  numRecorded = proc.recordedSamples.load();
+
+        if (consumedSamples < numRecorded)
+        {
+            consumeNextChunk (numRecorded);
+            continue;
+        }
+
+        // Capture finished and fully consumed — nothing left to follow
+        if (! capturing)
+            break;
+
+        wait (20);
+    }
+}
+
+int GrooveScoutLiveAnalyzer::consumeNextChunk (int numRecorded)
+{
+    const int start = consumedSamples;
+    const int count = juce::jmin (maxChunkSamples, numRecorded - start);
+
+    if (count <= 0)
+        return 0;
+
+    proc.recording.readMono (start, count, monoChunk.data());
+
+    spectrum.push (monoChunk.data(), count);
+
+    consumedSamples += count;
+    return count;
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "GrooveScoutFeatures.h"
+
+// Forward declaration — avoids circular include with PluginProcessor.h
+class GrooveScoutAudioProcessor;
+
+//==============================================================================
+/**
+ * GrooveScoutLiveAnalyzer — feature extraction that runs while recording
+ *
+ * Started by startRecording(). The thread follows recordedSamples and pushes
+ * each newly captured stretch (downmixed to mono) through the shared STFT
+ * front end in GrooveScoutFeatures. That front end produces the chroma (key),
+ * the log-band spectrogram, and the onset strength signal (BPM) derived from
+ * the spectrogram.
+ *
+ * When Analyze is pressed, GrooveScoutAnalyzer calls finish(). That stops
+ * the thread and consumes the few blocks still outstanding, so only the
+ * cheap final steps are left (autocorrelation peak pick, key correlation,
+ * per-band flux + thresholding, MIDI).
+ *
+ * Drum band frequencies are not baked in: per-band flux is derived from the
+ * stored log-band spectrogram at analysis time, so the user can change them
+ * after recording at no extra cost.
+ *
+ * Thread-safety contract:
+ *   - Reads only recording[0, recordedSamples), which the capture writer
+ *     has finished writing
+ *   - The front end is touched by one thread at a time: the live thread, or the
+ *     caller of finish() after it has stopped the live thread
+ *   - Exits on its own once capture has stopped and everything is consumed
+ */
+class GrooveScoutLiveAnalyzer : public juce::Thread
+{
+public:
+    explicit GrooveScoutLiveAnalyzer (GrooveScoutAudioProcessor& processor);
+    ~GrooveScoutLiveAnalyzer() override;
+
+    /** Message thread, when capture starts: resets the front end and starts
+        following the recording. */
+    void begin();
+
+    /** Drops the live features (recording buffer re-allocated, sample rate changed). */
+    void invalidate();
+
+    /**
+     * Stops following and consumes everything up to numRecorded on the
+     * calling thread. Returns true if the front end now describes exactly
+     * recording[0, numRecorded) at the current sample rate.
+     */
+    bool finish (int numRecorded);
+
+    void run() override;
+
+    //==========================================================================
+    // Results — valid after finish() returned true
+    //==========================================================================
+
+    const groovescout::SpectralFrontEnd& getSpectrum() const noexcept   { return spectrum; }
+
+private:
+    GrooveScoutAudioProcessor& proc;
+
+    /** Largest stretch pushed per step — keeps the live thread responsive to stop requests. */
+    static constexpr int maxChunkSamples = 8192;
+
+    /** Downmixes and pushes the next stretch up to numRecorded. Returns samples consumed. */
+    int consumeNextChunk (int numRecorded);
+
+    double sampleRate      = 0.0;
+    int    consumedSamples = 0;
+    bool   valid           = false;
+
+    std::vector<float> monoChunk;
+
+    groovescout::SpectralFrontEnd spectrum;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GrooveScoutLiveAnalyzer)
+};
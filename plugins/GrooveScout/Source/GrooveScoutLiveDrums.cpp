@@ -0,0 +1,251 @@
+//==============================================================================
+// GrooveScoutLiveDrums.cpp
+//
+// Streaming band onsets → MIDI, on the audio thread.
+//==============================================================================
+
+#include "GrooveScoutLiveDrums.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    /** juce::IIRCoefficients keeps b0, b1, b2, a1, a2 already divided by a0. */
+    pfs::dsp::BiquadCoeffs toBiquad (const juce::IIRCoefficients& c) noexcept
+    {
+        return { c.coefficients[0], c.coefficients[1], c.coefficients[2],
+                 c.coefficients[3], c.coefficients[4] };
+    }
+
+    /** Hops per envelope window: long enough to see a kick's first half-cycle,
+        short enough to keep hihats quick. */
+    constexpr int envelopeHops[GrooveScoutLiveDrums::numBands] = { 6, 3, 2 };
+
+    /** Per-sample energy treated as silence (-80 dBFS), so the rise of noise isn't a hit. */
+    constexpr float silenceEnergy = 1.0e-8f;
+
+    /** Same window as onsetsFromFlux(): ≈116 ms. */
+    constexpr double thresholdSeconds = 0.116;
+
+    /** A MidiBuffer stores each event as its sample position, its size and the bytes. */
+    constexpr size_t midiBytesPerEvent = sizeof (juce::int32) + sizeof (juce::uint16) + 3;
+}
+
+//==============================================================================
+
+void GrooveScoutLiveDrums::prepare (double newSampleRate, int maximumBlockSize)
+{
+    sampleRate = newSampleRate;
+    hopSize    = juce::jmax (16, juce::roundToInt (sampleRate * hopSeconds));
+    noteHops   = juce::jmax (1, juce::roundToInt (noteSeconds * sampleRate / hopSize));
+
+    const double hopsPerSecond = sampleRate / hopSize;
+    peakDecay = static_cast<float> (std::pow (0.5, 1.0 / (peakHalfLifeSeconds * hopsPerSecond)));
+
+    mono.assign (static_cast<size_t> (juce::jmax (1, maximumBlockSize)), 0.0f);
+
+    // Each hop a block completes (one more when a hop straddles blocks) can end every
+    // band's note and start a new one: note-off + note-on per band, as a retrigger and
+    // an expiring note-off never land on the same hop. Plus endNotes()' note-offs.
+    const auto maxHopsPerBlock = static_cast<size_t> (juce::jmax (1, maximumBlockSize) / hopSize + 1);
+    maxMidiBytes = (maxHopsPerBlock * numBands * 2 + numBands) * midiBytesPerEvent;
+
+    const groovescout::AnalysisSettings defaults;
+    const int minGapMs[numBands] = { defaults.kick.minGapMs, defaults.snare.minGapMs, defaults.hihat.minGapMs };
+    thresholdHops = juce::jmax (2, juce::roundToInt (thresholdSeconds * hopsPerSecond));
+
+    for (int b = 0; b < numBands; ++b)
+    {
+        auto& s = bandState[b];
+        s.envelopeHops = envelopeHops[b];
+        s.minGapHops   = juce::jmax (1, juce::roundToInt (minGapMs[b] * hopsPerSecond / 1000.0));
+        s.energies.assign (static_cast<size_t> (2 * s.envelopeHops), 0.0f);
+    }
+
+    // Unset frequencies: the first process() builds the filters
+    std::fill (std::begin (lastFreqLow),  std::end (lastFreqLow),  -1.0f);
+    std::fill (std::begin (lastFreqHigh), std::end (lastFreqHigh), -1.0f);
+
+    reset();
+}
+
+void GrooveScoutLiveDrums::reset() noexcept
+{
+    for (auto& state : states)
+        state = {};
+
+    hopFill = 0;
+    std::fill (std::begin (hopEnergy), std::end (hopEnergy), 0.0f);
+
+    for (auto& s : bandState)
+    {
+        std::fill (s.energies.begin(), s.energies.end(), 0.0f);
+        s.next = 0;
+        s.windowSum.reset (thresholdHops);     // same length as before: no allocation
+        s.windowSumSq.reset (thresholdHops);
+        s.previous = s.pending = s.peak = 0.0f;
+        s.cooldown = 0;
+        s.noteOffHops = -1;
+    }
+}
+
+void GrooveScoutLiveDrums::endNotes (juce::MidiBuffer& midiOut, int sampleOffset) noexcept
+{
+    for (int b = 0; b < numBands; ++b)
+    {
+        if (bandState[b].noteOffHops > 0)
+            midiOut.addEvent (juce::MidiMessage::noteOff (midiChannel, getNote (b)), sampleOffset);
+
+        bandState[b].noteOffHops = -1;
+    }
+}
+
+//==============================================================================
+
+void GrooveScoutLiveDrums::process (const float* const* channels, int numChannels, int numSamples,
+                                    const BandParams (&bands)[numBands], juce::MidiBuffer& midiOut) noexcept
+{
+    if (numChannels <= 0 || sampleRate <= 0.0)
+        return;
+
+    midiOut.ensureSize (static_cast<size_t> (midiOut.data.size()) + maxMidiBytes);
+
+    updateFilters (bands);
+
+    const int maxChunk = static_cast<int> (mono.size());
+
+    for (int done = 0; done < numSamples;)
+    {
+        const int chunk = juce::jmin (numSamples - done, maxChunk);
+
+        if (numChannels > 1)
+            pfs::dsp::mixToMono (mono.data(), channels[0] + done, channels[1] + done, chunk);
+        else
+            std::copy (channels[0] + done, channels[0] + done + chunk, mono.data());
+
+        // Feed the bank a hop at a time; a hop may straddle blocks
+        for (int offset = 0; offset < chunk;)
+        {
+            const int count = juce::jmin (chunk - offset, hopSize - hopFill);
+
+            pfs::dsp::filterBankEnergy (mono.data() + offset, count, sections, states, 2, hopEnergy);
+
+            offset  += count;
+            hopFill += count;
+
+            if (hopFill == hopSize)
+            {
+                finishHop (bands, midiOut, done + offset - 1);
+                hopFill = 0;
+                std::fill (std::begin (hopEnergy), std::end (hopEnergy), 0.0f);
+            }
+        }
+
+        done += chunk;
+    }
+}
+
+void GrooveScoutLiveDrums::updateFilters (const BandParams (&bands)[numBands]) noexcept
+{
+    const float nyquistLimit = static_cast<float> (sampleRate * 0.45);
+
+    for (int b = 0; b < numBands; ++b)
+    {
+        const float low  = juce::jmin (bands[b].freqLow,  nyquistLimit);
+        const float high = juce::jmin (bands[b].freqHigh, nyquistLimit);
+
+        // An empty range: the lane outputs nothing, and is rebuilt once the range is valid again
+        bandHasRange[b] = low < high;
+
+        if (! bandHasRange[b])
+        {
+            sections[1].setLane (b, { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f });
+            lastFreqLow[b] = lastFreqHigh[b] = -1.0f;
+            continue;
+        }
+
+        if (std::abs (low - lastFreqLow[b]) <= 0.5f && std::abs (high - lastFreqHigh[b]) <= 0.5f)
+            continue;
+
+        lastFreqLow[b]  = low;
+        lastFreqHigh[b] = high;
+
+        sections[0].setLane (b, toBiquad (juce::IIRCoefficients::makeHighPass (sampleRate, (double) low)));
+        sections[1].setLane (b, toBiquad (juce::IIRCoefficients::makeLowPass  (sampleRate, (double) high)));
+    }
+}
+
+void GrooveScoutLiveDrums::finishHop (const BandParams (&bands)[numBands], juce::MidiBuffer& midiOut,
+                                      int sampleOffset) noexcept
+{
+    for (int b = 0; b < numBands; ++b)
+    {
+        auto& s = bandState[b];
+        const int note = getNote (b);
+
+        if (s.noteOffHops > 0 && --s.noteOffHops == 0)
+        {
+            midiOut.addEvent (juce::MidiMessage::noteOff (midiChannel, note), sampleOffset);
+            s.noteOffHops = -1;
+        }
+
+        // Rise: this envelope window's energy over the one before it, in dB
+        const int size = static_cast<int> (s.energies.size());
+        s.energies[static_cast<size_t> (s.next)] = hopEnergy[b];
+        s.next = (s.next + 1) % size;
+
+        float now = 0.0f, before = 0.0f;
+
+        for (int i = 0; i < s.envelopeHops; ++i)
+        {
+            now    += s.energies[static_cast<size_t> ((s.next - 1 - i + size) % size)];
+            before += s.energies[static_cast<size_t> ((s.next - 1 - s.envelopeHops - i + size) % size)];
+        }
+
+        const float floor = silenceEnergy * static_cast<float> (hopSize * s.envelopeHops);
+        const float rise  = juce::jmax (0.0f, 10.0f * std::log10 ((now + floor) / (before + floor)));
+
+        // Judge O[f] = pending now that O[f + 1] = rise is known (onsetsFromFlux()'s
+        // local-maximum test), against the window of O[.. f - 1]
+        const float val  = s.pending;
+        const float prev = s.previous;
+
+        s.windowSum.push (prev);
+        s.windowSumSq.push (static_cast<double> (prev) * prev);
+        s.previous = val;
+        s.pending  = rise;
+        s.peak     = juce::jmax (s.peak * peakDecay, val);
+
+        if (s.cooldown > 0)
+        {
+            --s.cooldown;
+            continue;
+        }
+
+        if (! bands[b].enabled || ! bandHasRange[b] || s.peak < 1e-10f)
+            continue;
+
+        const float  sensitivity = bands[b].sensitivity;
+        const double wLen        = static_cast<double> (s.windowSum.getCount());
+        const double meanD       = s.windowSum.getSum() / wLen;
+        const double variance    = juce::jmax (0.0, s.windowSumSq.getSum() / wLen - meanD * meanD);
+
+        const float threshold     = static_cast<float> (meanD) + (1.0f - sensitivity) * 6.0f * static_cast<float> (std::sqrt (variance));
+        const float strengthFloor = s.peak * (0.05f + (1.0f - sensitivity) * 0.50f);
+
+        if (val <= threshold || val < strengthFloor || ! (val > prev && val >= rise))
+            continue;
+
+        const int velocity = juce::jlimit (1, 127, juce::roundToInt (val / s.peak * 127.0f));
+
+        // Retrigger: end the previous hit first so receivers see a clean note
+        if (s.noteOffHops > 0)
+            midiOut.addEvent (juce::MidiMessage::noteOff (midiChannel, note), sampleOffset);
+
+        midiOut.addEvent (juce::MidiMessage::noteOn (midiChannel, note, static_cast<juce::uint8> (velocity)), sampleOffset);
+
+        s.noteOffHops = noteHops;
+        s.cooldown    = s.minGapHops;
+    }
+}
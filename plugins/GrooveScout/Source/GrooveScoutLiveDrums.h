@@ -0,0 +1,131 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include "GrooveScoutAnalysisCore.h"   // AnalysisSettings band defaults (minimum gaps)
+#include "GrooveScoutFeatures.h"       // SlidingWindowSum
+#include "PfsDspKernels.h"
+
+#include <vector>
+
+//==============================================================================
+/**
+ * GrooveScoutLiveDrums — drum hits to MIDI while they are played
+ *
+ * The streaming counterpart of the offline band onsets (onsetsFromFlux()),
+ * run inside processBlock(). It sends kick / snare / hihat note-ons
+ * (36 / 38 / 42 on channel 10, the notes the MIDI clips use) to the
+ * plugin's MIDI output, so a live drummer can play Drum808 or any other
+ * drum instrument.
+ *
+ *   input ─mono─> filterBankEnergy ─per hop─> band energy
+ *                 (HP+LP per lane:              │
+ *                  kick/snare/hihat)            ▼
+ *                       rise O[n] = dB(energy over the last window ÷ the window before)
+ *                                               │
+ *                       threshold mean + (1 − sensitivity) · 6 · std over ~116 ms,
+ *                       strength floor, local maximum, minimum gap
+ *                                               │
+ *                                               ▼
+ *                       note-on at the sample where the hit was confirmed
+ *
+ * The threshold, strength floor, local-maximum test and minimum gaps are
+ * the offline ones. The offline floor is relative to the loudest hit in the
+ * take. Here it is relative to a peak that decays with a half-life of
+ * peakHalfLifeSeconds, so it follows the drummer's dynamics.
+ *
+ * Latency is the envelope window plus one hop (the local-maximum test looks
+ * one hop ahead), i.e. (envelopeHops + 1) hops. That is about 4 ms for hihats,
+ * 5 ms for snares and 9 ms for kicks at any sample rate. Hops are about 1.3 ms.
+ *
+ * A band whose range is empty (freqLow >= freqHigh) is skipped, like the
+ * offline addBand(): its lane passes nothing and it sends no notes.
+ *
+ * Cost per block: one downmix, one 4-lane SIMD pass of the HP + LP cascade
+ * (the same kernel and lane layout as the offline bank), and O(1) work per
+ * band per hop. prepare() allocates everything and works out how many MIDI
+ * bytes one block can produce. process() reserves that much in the host's
+ * MidiBuffer up front, which only allocates if that buffer has never been
+ * that large (hosts reuse one buffer, and clear() keeps its capacity), so
+ * adding the events never does.
+ */
+class GrooveScoutLiveDrums
+{
+public:
+    enum Band { kick, snare, hihat, numBands };
+
+    /** One band's parameters, read by the processor each block. */
+    struct BandParams
+    {
+        bool  enabled     = true;
+        float freqLow     = 0.0f;
+        float freqHigh    = 0.0f;
+        float sensitivity = 0.5f;
+    };
+
+    static constexpr int    midiChannel         = 10;
+    static constexpr double hopSeconds          = 0.00133;   // ~64 samples at 48 kHz
+    static constexpr double noteSeconds         = 0.05;      // note-off after each hit
+    static constexpr double peakHalfLifeSeconds = 20.0;
+
+    static int getNote (int band) noexcept   { return band == kick ? 36 : band == snare ? 38 : 42; }
+
+    GrooveScoutLiveDrums() = default;
+
+    /** Sizes every buffer. Not real-time safe. */
+    void prepare (double sampleRate, int maximumBlockSize);
+
+    /** Forgets filter, envelope and threshold state (mode switched on). Audio thread. */
+    void reset() noexcept;
+
+    /**
+     * Adds this block's hits to midiOut, each at the sample offset where it
+     * was detected. Audio thread; see the class notes on allocation.
+     */
+    void process (const float* const* channels, int numChannels, int numSamples,
+                  const BandParams (&bands)[numBands], juce::MidiBuffer& midiOut) noexcept;
+
+    /** Note-offs for any hit still sounding (mode switched off). Audio thread. */
+    void endNotes (juce::MidiBuffer& midiOut, int sampleOffset) noexcept;
+
+private:
+    struct BandState
+    {
+        std::vector<float> energies;   // per-hop energy, last 2 × envelope windows
+        int    next = 0;
+        int    envelopeHops = 1;
+        int    minGapHops = 1;
+
+        groovescout::SlidingWindowSum windowSum, windowSumSq;
+
+        float  previous = 0.0f;        // O[f - 1]
+        float  pending  = 0.0f;        // O[f], waiting for O[f + 1]
+        float  peak     = 0.0f;
+        int    cooldown = 0;
+        int    noteOffHops = -1;       // hops until the sounding note ends; -1 = none
+    };
+
+    void updateFilters (const BandParams (&bands)[numBands]) noexcept;
+
+    /** One hop's energies are complete: advance every band, emit at sampleOffset. */
+    void finishHop (const BandParams (&bands)[numBands], juce::MidiBuffer& midiOut, int sampleOffset) noexcept;
+
+    double sampleRate    = 0.0;
+    int    hopSize       = 64;
+    int    hopFill       = 0;
+    int    noteHops      = 1;
+    int    thresholdHops = 2;         // adaptive threshold window
+    float  peakDecay     = 1.0f;      // per hop
+    size_t maxMidiBytes  = 0;         // worst case one block adds to midiOut
+
+    std::vector<float> mono;          // one block, downmixed
+
+    pfs::dsp::BiquadBank4      sections[2];   // HP, LP; lanes are the bands
+    pfs::dsp::BiquadBank4State states[2];
+    float hopEnergy[4] {};
+    float lastFreqLow[numBands] {}, lastFreqHigh[numBands] {};
+    bool  bandHasRange[numBands] {};  // freqLow < freqHigh after clamping, set by updateFilters()
+
+    BandState bandState[numBands];
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GrooveScoutLiveDrums)
+};
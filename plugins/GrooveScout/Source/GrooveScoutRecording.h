@@ -0,0 +1,65 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "PfsDspKernels.h"
+
+#include <cstdint>
+
+//==============================================================================
+/**
+ * GrooveScoutRecording — read-only view of the captured take
+ *
+ * GrooveScoutCapture stores the take as planar 16-bit samples,
+ * [L × capacity][R × capacity], which is half the size of float. Full scale
+ * is ±2 (+6 dBFS), so a hot input has some headroom before it saturates.
+ * One step is still about 90 dB below full scale, well under anything the
+ * onset, tempo or key stages can resolve.
+ *
+ * The view doesn't own the storage: copying it copies two pointers. Each
+ * reader converts only the stretch it is working on into its own scratch:
+ *   - readMono()  downmix and conversion in one pass (analysis front end,
+ *                 live analyzer, waveform)
+ *   - read()      one channel (preview playback)
+ * Nothing ever holds a float copy of the whole take.
+ *
+ * Only [0, recordedSamples) holds audio. Callers keep their reads inside it.
+ */
+class GrooveScoutRecording
+{
+public:
+    using Sample = std::int16_t;
+
+    static constexpr int   numChannels = 2;
+    static constexpr float fullScale   = 2.0f;
+    static constexpr float encodeScale = 32767.0f / fullScale;
+    static constexpr float decodeScale = fullScale / 32767.0f;
+
+    GrooveScoutRecording() = default;
+
+    GrooveScoutRecording (const Sample* left, const Sample* right, int capacitySamples) noexcept
+        : channels { left, right }, capacity (capacitySamples) {}
+
+    int getCapacity() const noexcept   { return capacity; }
+
+    /** Channel `channel` of [start, start + numSamples) as float. */
+    void read (int channel, int start, int numSamples, float* dest) const noexcept
+    {
+        pfs::dsp::int16ToFloat (dest, channels[channel] + start, decodeScale, numSamples);
+    }
+
+    /** (L + R) / 2 of [start, start + numSamples) as float. */
+    void readMono (int start, int numSamples, float* dest) const noexcept
+    {
+        pfs::dsp::mixInt16ToMono (dest, channels[0] + start, channels[1] + start, decodeScale, numSamples);
+    }
+
+    /** Float audio → storage format, saturating. Used by the capture writer. */
+    static void encode (Sample* dest, const float* src, int numSamples) noexcept
+    {
+        pfs::dsp::floatToInt16 (dest, src, encodeScale, numSamples);
+    }
+
+private:
+    const Sample* channels[numChannels] {};
+    int           capacity = 0;
+};
@@ -0,0 +1,383 @@
+//==============================================================================
+// GrooveScoutTempo.cpp
+//
+// Windowed generalized autocorrelation (tempogram), tempo path and
+// dynamic-programming beat tracking over the shared OSS.
+//==============================================================================
+
+#include "GrooveScoutTempo.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace groovescout
+{
+    //==========================================================================
+    // BeatGrid
+    //==========================================================================
+
+    double BeatGrid::beatPosition (int sampleOffset) const noexcept
+    {
+        const auto numBeats = beatSamples.size();
+        const auto interval = [this] (size_t i)
+        {
+            return static_cast<double> (beatSamples[i + 1] - beatSamples[i]);
+        };
+
+        const double firstBeat = beatSamples.front() / interval (0);
+
+        if (sampleOffset <= beatSamples.front())
+            return firstBeat - (beatSamples.front() - sampleOffset) / interval (0);
+
+        if (sampleOffset >= beatSamples.back())
+            return firstBeat + static_cast<double> (numBeats - 1)
+                 + (sampleOffset - beatSamples.back()) / interval (numBeats - 2);
+
+        const auto next = std::upper_bound (beatSamples.begin(), beatSamples.end(), sampleOffset);
+        const auto i    = static_cast<size_t> (std::distance (beatSamples.begin(), next) - 1);
+
+        return firstBeat + static_cast<double> (i) + (sampleOffset - beatSamples[i]) / interval (i);
+    }
+
+    BeatGrid BeatGrid::withMultiplier (float multiplier) const
+    {
+        BeatGrid scaled;
+
+        if (multiplier == 2.0f)
+        {
+            for (size_t i = 0; i < beatSamples.size(); ++i)
+            {
+                scaled.beatSamples.push_back (beatSamples[i]);
+                scaled.beatBpm.push_back (beatBpm[i] * 2.0f);
+
+                if (i + 1 < beatSamples.size())
+                {
+                    scaled.beatSamples.push_back ((beatSamples[i] + beatSamples[i + 1]) / 2);
+                    scaled.beatBpm.push_back (beatBpm[i] * 2.0f);
+                }
+            }
+        }
+        else if (multiplier == 0.5f)
+        {
+            for (size_t i = 0; i < beatSamples.size(); i += 2)
+            {
+                scaled.beatSamples.push_back (beatSamples[i]);
+                // Two tracked beats per new one: half their average tempo
+                scaled.beatBpm.push_back (i + 1 < beatSamples.size()
+                    ? (beatBpm[i] + beatBpm[i + 1]) * 0.25f
+                    : beatBpm[i] * 0.5f);
+            }
+        }
+        else
+        {
+            scaled = *this;
+        }
+
+        return scaled;
+    }
+
+    //==========================================================================
+    // Tempogram
+    //==========================================================================
+
+    void Tempogram::prepare (const SpectralFrontEnd& spectrum)
+    {
+        sampleRate = spectrum.getSampleRate();
+        hopSize    = spectrum.getHopSize();
+        numFrames  = spectrum.getNumFrames();
+
+        const double framesPerSecond = sampleRate / hopSize;
+
+        minLag = std::max (1, static_cast<int> (std::floor (60.0 * framesPerSecond / maxBpm)));
+        const int maxLag = static_cast<int> (std::ceil (60.0 * framesPerSecond / minBpm));
+        numLags = maxLag - minLag + 1;
+
+        // Short takes get one window over everything
+        windowFrames = std::min (numFrames, static_cast<int> (std::round (windowSeconds * framesPerSecond)));
+        windowHop    = std::max (1, static_cast<int> (std::round (windowHopSeconds * framesPerSecond)));
+        numWindows   = (windowFrames > maxLag)
+                           ? 1 + (numFrames - windowFrames + windowHop - 1) / windowHop
+                           : 0;
+
+        // Zero padding to at least windowFrames + maxLag, so lags don't wrap around
+        fftOrder = 0;
+        while ((1 << fftOrder) < windowFrames + maxLag)
+            ++fftOrder;
+
+        rows.assign (static_cast<size_t> (numWindows) * static_cast<size_t> (numLags), 0.0f);
+    }
+
+    void Tempogram::computeWindows (const SpectralFrontEnd& spectrum, int first, int last)
+    {
+        const auto& oss = spectrum.getOss();
+        const int fftSize = 1 << fftOrder;
+
+        // One FFT per caller — juce::dsp::FFT engines aren't guaranteed re-entrant
+        juce::dsp::FFT fft (fftOrder);
+        std::vector<float> buffer (static_cast<size_t> (fftSize * 2));
+
+        for (int w = first; w < last; ++w)
+        {
+            const int start = std::min (w * windowHop, numFrames - windowFrames);
+
+            // a. sqrt compression (as the global GAC did), mean removed so the
+            //    autocorrelation isn't one slope falling from lag 0, then Hann
+            double mean = 0.0;
+            for (int i = 0; i < windowFrames; ++i)
+                mean += std::sqrt (oss[static_cast<size_t> (start + i)]);
+            mean /= windowFrames;
+
+            std::fill (buffer.begin(), buffer.end(), 0.0f);
+
+            for (int i = 0; i < windowFrames; ++i)
+            {
+                const double hann = 0.5 - 0.5 * std::cos (juce::MathConstants<double>::twoPi * (i + 0.5) / windowFrames);
+                buffer[static_cast<size_t> (i)] = static_cast<float> ((std::sqrt (oss[static_cast<size_t> (start + i)]) - mean) * hann);
+            }
+
+            // b–d. Forward FFT, |X|², inverse FFT → autocorrelation
+            fft.performRealOnlyForwardTransform (buffer.data(), true);
+
+            for (int i = 0; i < fftSize * 2; i += 2)
+            {
+                const float re = buffer[static_cast<size_t> (i)];
+                const float im = buffer[static_cast<size_t> (i + 1)];
+                buffer[static_cast<size_t> (i)]     = re * re + im * im;
+                buffer[static_cast<size_t> (i + 1)] = 0.0f;
+            }
+
+            fft.performRealOnlyInverseTransform (buffer.data());
+
+            // Normalised by lag 0, so loud and quiet windows weigh the same
+            const float energy = buffer[0];
+            float* row = rows.data() + static_cast<size_t> (w) * static_cast<size_t> (numLags);
+
+            for (int i = 0; i < numLags; ++i)
+                row[i] = (energy > 1e-12f) ? buffer[static_cast<size_t> (minLag + i)] / energy : 0.0f;
+        }
+    }
+
+    double Tempogram::lagToBpm (double lag) const noexcept
+    {
+        return 60.0 * sampleRate / (lag * hopSize);
+    }
+
+    double Tempogram::refinedLag (const float* row, int index) const noexcept
+    {
+        double offset = 0.0;
+
+        if (index > 0 && index + 1 < numLags)
+        {
+            const double a = row[index - 1], b = row[index], c = row[index + 1];
+            const double denominator = a - 2.0 * b + c;
+
+            if (denominator < 0.0)
+                offset = juce::jlimit (-0.5, 0.5, 0.5 * (a - c) / denominator);
+        }
+
+        return minLag + index + offset;
+    }
+
+    float Tempogram::globalBpm() const
+    {
+        if (numWindows == 0)
+            return 0.0f;
+
+        std::vector<float> sum (static_cast<size_t> (numLags), 0.0f);
+
+        for (int w = 0; w < numWindows; ++w)
+        {
+            const float* row = getRow (w);
+            for (int i = 0; i < numLags; ++i)
+                sum[static_cast<size_t> (i)] += row[i];
+        }
+
+        const int best = static_cast<int> (std::distance (sum.begin(), std::max_element (sum.begin(), sum.end())));
+        return static_cast<float> (lagToBpm (refinedLag (sum.data(), best)));
+    }
+
+    std::vector<float> Tempogram::tempoPath (float overallBpm) const
+    {
+        std::vector<float> path;
+
+        if (numWindows == 0 || overallBpm <= 0.0f)
+            return path;
+
+        // Viterbi over windows. Score = autocorrelation at the lag, minus a
+        // penalty on (log2 of the lag ratio)² between neighbouring windows
+        // (a 10% change costs ~0.4, an octave jump is effectively barred)
+        // and a weak pull towards the global tempo's octave.
+        constexpr double changePenalty = 20.0;
+        constexpr double octavePull    = 2.0;
+
+        const double globalLag = 60.0 * sampleRate / (overallBpm * hopSize);
+
+        std::vector<double> logLag (static_cast<size_t> (numLags));
+        std::vector<double> prior  (static_cast<size_t> (numLags));
+
+        for (int i = 0; i < numLags; ++i)
+        {
+            logLag[static_cast<size_t> (i)] = std::log2 (static_cast<double> (minLag + i));
+            const double distance = logLag[static_cast<size_t> (i)] - std::log2 (globalLag);
+            prior[static_cast<size_t> (i)] = -octavePull * distance * distance;
+        }
+
+        std::vector<double> score (static_cast<size_t> (numLags)), nextScore (score.size());
+        std::vector<int>    from (static_cast<size_t> (numWindows) * static_cast<size_t> (numLags), 0);
+
+        for (int i = 0; i < numLags; ++i)
+            score[static_cast<size_t> (i)] = getRow (0)[i] + prior[static_cast<size_t> (i)];
+
+        for (int w = 1; w < numWindows; ++w)
+        {
+            const float* row = getRow (w);
+
+            for (int i = 0; i < numLags; ++i)
+            {
+                double best = -std::numeric_limits<double>::max();
+                int    bestFrom = i;
+
+                for (int j = 0; j < numLags; ++j)
+                {
+                    const double ratio = logLag[static_cast<size_t> (i)] - logLag[static_cast<size_t> (j)];
+                    const double candidate = score[static_cast<size_t> (j)] - changePenalty * ratio * ratio;
+
+                    if (candidate > best)
+                    {
+                        best = candidate;
+                        bestFrom = j;
+                    }
+                }
+
+                nextScore[static_cast<size_t> (i)] = best + row[i] + prior[static_cast<size_t> (i)];
+                from[static_cast<size_t> (w) * static_cast<size_t> (numLags) + static_cast<size_t> (i)] = bestFrom;
+            }
+
+            std::swap (score, nextScore);
+        }
+
+        // Backtrace, then refine each window's lag on its own row
+        int state = static_cast<int> (std::distance (score.begin(), std::max_element (score.begin(), score.end())));
+        path.assign (static_cast<size_t> (numWindows), 0.0f);
+
+        for (int w = numWindows - 1; w >= 0; --w)
+        {
+            path[static_cast<size_t> (w)] = static_cast<float> (lagToBpm (refinedLag (getRow (w), state)));
+            state = from[static_cast<size_t> (w) * static_cast<size_t> (numLags) + static_cast<size_t> (state)];
+        }
+
+        return path;
+    }
+
+    BeatGrid Tempogram::trackBeats (const SpectralFrontEnd& spectrum, const std::vector<float>& windowBpm) const
+    {
+        BeatGrid grid;
+        const auto& oss = spectrum.getOss();
+
+        if (windowBpm.empty() || static_cast<int> (oss.size()) != numFrames)
+            return grid;
+
+        // Local period in frames, interpolated between window centres
+        std::vector<double> period (static_cast<size_t> (numFrames));
+
+        for (int f = 0; f < numFrames; ++f)
+        {
+            const double position = (f - 0.5 * windowFrames) / windowHop;
+            const int    w0 = juce::jlimit (0, numWindows - 1, static_cast<int> (std::floor (position)));
+            const int    w1 = std::min (w0 + 1, numWindows - 1);
+            const double t  = juce::jlimit (0.0, 1.0, position - w0);
+            const double bpm = (1.0 - t) * windowBpm[static_cast<size_t> (w0)] + t * windowBpm[static_cast<size_t> (w1)];
+
+            period[static_cast<size_t> (f)] = 60.0 * sampleRate / (bpm * hopSize);
+        }
+
+        // Onset envelope scaled to unit standard deviation, so the tightness
+        // constant means the same thing for every take
+        double mean = 0.0, meanSq = 0.0;
+        for (float value : oss)
+        {
+            mean   += value;
+            meanSq += static_cast<double> (value) * value;
+        }
+        mean   /= numFrames;
+        meanSq /= numFrames;
+
+        const double deviation = std::sqrt (std::max (1e-12, meanSq - mean * mean));
+
+        // C[t] = O[t] + max over τ in [t - 2P, t - P/2] of C[τ] - α (ln ((t - τ) / P))²
+        constexpr double tightness = 100.0;
+
+        std::vector<double> cumulative (static_cast<size_t> (numFrames));
+        std::vector<int>    previous   (static_cast<size_t> (numFrames), -1);
+
+        for (int t = 0; t < numFrames; ++t)
+        {
+            const double local = oss[static_cast<size_t> (t)] / deviation;
+            const double p     = period[static_cast<size_t> (t)];
+            const int    from  = t - static_cast<int> (std::round (2.0 * p));
+            const int    to    = t - static_cast<int> (std::round (0.5 * p));
+
+            double best = 0.0;
+            int    bestFrom = -1;
+
+            for (int tau = std::max (0, from); tau <= to; ++tau)
+            {
+                const double logRatio  = std::log ((t - tau) / p);
+                const double candidate = cumulative[static_cast<size_t> (tau)] - tightness * logRatio * logRatio;
+
+                if (bestFrom < 0 || candidate > best)
+                {
+                    best = candidate;
+                    bestFrom = tau;
+                }
+            }
+
+            cumulative[static_cast<size_t> (t)] = local + (bestFrom >= 0 ? std::max (0.0, best) : 0.0);
+            previous[static_cast<size_t> (t)]   = (bestFrom >= 0 && best > 0.0) ? bestFrom : -1;
+        }
+
+        // Last beat: the best score within one period of the end
+        const int tail = std::max (0, numFrames - static_cast<int> (std::round (period.back())));
+        int beat = static_cast<int> (std::distance (cumulative.begin(),
+                                                    std::max_element (cumulative.begin() + tail, cumulative.end())));
+
+        std::vector<int> frames;
+        for (; beat >= 0; beat = previous[static_cast<size_t> (beat)])
+            frames.push_back (beat);
+
+        std::reverse (frames.begin(), frames.end());
+
+        // The DP happily carries the grid through silence at either end; drop
+        // end beats with next to no onset behind them
+        if (! frames.empty())
+        {
+            double beatStrength = 0.0;
+            for (int frame : frames)
+                beatStrength += oss[static_cast<size_t> (frame)];
+
+            const double floor = 0.1 * beatStrength / static_cast<double> (frames.size());
+            const auto isWeak = [&] (int frame) { return oss[static_cast<size_t> (frame)] < floor; };
+
+            while (! frames.empty() && isWeak (frames.back()))
+                frames.pop_back();
+
+            frames.erase (frames.begin(), std::find_if_not (frames.begin(), frames.end(), isWeak));
+        }
+
+        for (int frame : frames)
+            grid.beatSamples.push_back (spectrum.getFrameCentre (frame));
+
+        for (size_t i = 0; i < grid.beatSamples.size(); ++i)
+        {
+            const size_t a = (i + 1 < grid.beatSamples.size()) ? i : i - 1;
+            const double interval = (grid.beatSamples.size() > 1)
+                                        ? static_cast<double> (grid.beatSamples[a + 1] - grid.beatSamples[a])
+                                        : period.front() * hopSize;
+
+            grid.beatBpm.push_back (static_cast<float> (60.0 * sampleRate / interval));
+        }
+
+        return grid;
+    }
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "GrooveScoutFeatures.h"
+
+#include <vector>
+
+//==============================================================================
+/**
+ * GrooveScoutTempo — windowed tempogram and beat tracking (DSP.2)
+ *
+ *     OSS ──> 8 s windows, 1 s apart ──> per-window autocorrelation (parallel)
+ *                                              │
+ *                       ┌──────────────────────┴──────────────────────┐
+ *                 Σ over windows                             Viterbi over windows
+ *                 → global BPM                               → tempo per window
+ *                                                                     │
+ *                                              OSS + local period ──> beat DP
+ *                                                                     → BeatGrid
+ *
+ * Every window is the same length, so each costs the same however long the
+ * take is. Total cost is linear in the recording, and the windows don't
+ * depend on each other: computeWindows() can be called from several threads
+ * on disjoint ranges. Only the two passes afterwards (tempo path and beat
+ * DP) are sequential, and both are linear too.
+ *
+ * The beat tracker is a dynamic-programming one in the style of Ellis
+ * (2007): each frame's score is its onset strength plus the best earlier
+ * beat one local period back, penalised by how far the gap strays from that
+ * period (log-ratio squared). Following the local period from the tempo
+ * path is what lets the grid bend with a drummer who speeds up or drags.
+ */
+namespace groovescout
+{
+    //==========================================================================
+    /** Tracked beats, as sample offsets into the recording. */
+    struct BeatGrid
+    {
+        std::vector<int>   beatSamples;   ///< Ascending
+        std::vector<float> beatBpm;       ///< Tempo from each beat to the next (the last repeats)
+
+        bool isUsable() const noexcept   { return beatSamples.size() >= 2; }
+
+        /** Musical position of a sample in beats. The first tracked beat sits
+            at beatSamples[0] / (first interval), so sample 0 maps to beat 0 as
+            with a constant tempo. Outside the tracked beats the nearest
+            interval is extended. Requires isUsable(). */
+        double beatPosition (int sampleOffset) const noexcept;
+
+        /** The same grid at 2× (midpoints added) or ½× (every other beat).
+            Other factors return the grid unchanged. */
+        BeatGrid withMultiplier (float multiplier) const;
+    };
+
+    //==========================================================================
+    class Tempogram
+    {
+    public:
+        static constexpr double windowSeconds    = 8.0;
+        static constexpr double windowHopSeconds = 1.0;
+        static constexpr double minBpm           = 60.0;
+        static constexpr double maxBpm           = 200.0;
+
+        /** Lays out the windows over spectrum's OSS. Not thread-safe. */
+        void prepare (const SpectralFrontEnd& spectrum);
+
+        int getNumWindows() const noexcept   { return numWindows; }
+
+        /** Autocorrelates windows [first, last). Safe to call concurrently
+            for disjoint ranges once prepare() has returned. */
+        void computeWindows (const SpectralFrontEnd& spectrum, int first, int last);
+
+        //======================================================================
+        // After every window has been computed
+
+        /** BPM of the strongest lag summed over all windows (before any multiplier). */
+        float globalBpm() const;
+
+        /** Tempo of each window along the smoothest strong path. */
+        std::vector<float> tempoPath (float overallBpm) const;
+
+        /** Beats from spectrum's OSS, following the tempo path. */
+        BeatGrid trackBeats (const SpectralFrontEnd& spectrum, const std::vector<float>& windowBpm) const;
+
+    private:
+        double lagToBpm (double lag) const noexcept;
+
+        /** Lag at row[index], refined by a parabola through its neighbours. */
+        double refinedLag (const float* row, int index) const noexcept;
+
+        const float* getRow (int window) const noexcept
+        {
+            return rows.data() + static_cast<size_t> (window) * static_cast<size_t> (numLags);
+        }
+
+        double sampleRate   = 0.0;
+        int    hopSize      = 0;
+        int    numFrames    = 0;
+        int    windowFrames = 0;
+        int    windowHop    = 0;
+        int    numWindows   = 0;
+        int    fftOrder     = 0;
+        int    minLag       = 1;
+        int    numLags      = 0;
+
+        std::vector<float> rows;   // numWindows × numLags, lag minLag + i, normalised by lag 0
+    };
+}
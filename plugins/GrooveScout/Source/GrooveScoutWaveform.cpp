@@ -0,0 +1,187 @@
+//==============================================================================
+// GrooveScoutWaveform.cpp
+//
+// Incremental min/max pyramid of the capture for the waveform display.
+//==============================================================================
+
+#include "GrooveScoutWaveform.h"
+#include "PfsDspKernels.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+    /** min/max of the mono mix of audio[from, to), folded into binMin/binMax. */
+    void scanAudio (const GrooveScoutRecording& audio, int from, int to, float& binMin, float& binMax) noexcept
+    {
+        constexpr int chunkSize = 256;
+        float mono[chunkSize];
+
+        for (int start = from; start < to; start += chunkSize)
+        {
+            const int count = juce::jmin (chunkSize, to - start);
+            audio.readMono (start, count, mono);
+
+            for (int i = 0; i < count; ++i)
+            {
+                binMin = juce::jmin (binMin, mono[i]);
+                binMax = juce::jmax (binMax, mono[i]);
+            }
+        }
+    }
+}
+
+//==============================================================================
+// Message thread
+//==============================================================================
+
+void GrooveScoutWaveform::prepare (int capacitySamples)
+{
+    capacityBins = (juce::jmax (0, capacitySamples) + baseBinSamples - 1) / baseBinSamples;
+
+    numLevels = 0;
+    while (numLevels < maxLevels && (capacityBins >> numLevels) > 0)
+    {
+        auto& level = levels[numLevels];
+        const auto size = static_cast<size_t> (capacityBins >> numLevels);
+
+        level.mins.assign (size, 0.0f);
+        level.maxs.assign (size, 0.0f);
+        ++numLevels;
+    }
+
+    reset();
+}
+
+void GrooveScoutWaveform::reset() noexcept
+{
+    pendingSamples = 0;
+    pendingMin     = 0.0f;
+    pendingMax     = 0.0f;
+    completeBaseBins.store (0, std::memory_order_release);
+}
+
+//==============================================================================
+// Capture writer
+//==============================================================================
+
+void GrooveScoutWaveform::append (const float* left, const float* right, int numSamples) noexcept
+{
+    float mono[baseBinSamples];
+
+    while (numSamples > 0 && numLevels > 0)
+    {
+        const int count = juce::jmin (numSamples, baseBinSamples - pendingSamples);
+
+        pfs::dsp::mixToMono (mono, left, right, count);
+        const auto range = juce::FloatVectorOperations::findMinAndMax (mono, count);
+
+        pendingMin = (pendingSamples == 0) ? range.getStart() : juce::jmin (pendingMin, range.getStart());
+        pendingMax = (pendingSamples == 0) ? range.getEnd()   : juce::jmax (pendingMax, range.getEnd());
+        pendingSamples += count;
+
+        if (pendingSamples == baseBinSamples)
+        {
+            const int index = completeBaseBins.load (std::memory_order_relaxed);
+
+            if (index < capacityBins)
+                completeBaseBin (index, pendingMin, pendingMax);
+
+            pendingSamples = 0;
+        }
+
+        left       += count;
+        right      += count;
+        numSamples -= count;
+    }
+}
+
+void GrooveScoutWaveform::completeBaseBin (int index, float binMin, float binMax) noexcept
+{
+    levels[0].mins[(size_t) index] = binMin;
+    levels[0].maxs[(size_t) index] = binMax;
+
+    // Carry upwards while this bin closes a pair at the level below
+    for (int level = 1; level < numLevels && ((index + 1) & ((1 << level) - 1)) == 0; ++level)
+    {
+        const auto& below = levels[level - 1];
+        auto&       above = levels[level];
+        const auto  dest  = static_cast<size_t> (index >> level);
+
+        if (dest >= above.mins.size())
+            break;
+
+        above.mins[dest] = juce::jmin (below.mins[2 * dest], below.mins[2 * dest + 1]);
+        above.maxs[dest] = juce::jmax (below.maxs[2 * dest], below.maxs[2 * dest + 1]);
+    }
+
+    completeBaseBins.store (index + 1, std::memory_order_release);
+}
+
+//==============================================================================
+// Readers
+//==============================================================================
+
+void GrooveScoutWaveform::getRange (const GrooveScoutRecording& audio, int startSample, int endSample,
+                                    int numBins, float* mins, float* maxs) const
+{
+    if (numBins <= 0)
+        return;
+
+    const auto span = static_cast<juce::int64> (juce::jmax (0, endSample - startSample));
+
+    if (span == 0)
+    {
+        std::fill (mins, mins + numBins, 0.0f);
+        std::fill (maxs, maxs + numBins, 0.0f);
+        return;
+    }
+    const auto samplesPerSlice = static_cast<double> (span) / numBins;
+
+    // Coarsest level with at least one bin per slice; -1 = slices narrower than a base bin
+    int level = -1;
+    while (level + 1 < numLevels && getBinSamples (level + 1) <= samplesPerSlice)
+        ++level;
+
+    const int binSamples   = (level >= 0) ? getBinSamples (level) : 1;
+    const int completeBins = (level >= 0) ? getNumCompleteBins (level) : 0;
+
+    for (int i = 0; i < numBins; ++i)
+    {
+        const int from = startSample + static_cast<int> (span * i / numBins);
+        const int to   = juce::jmax (from + 1, startSample + static_cast<int> (span * (i + 1) / numBins));
+
+        float sliceMin = std::numeric_limits<float>::max();
+        float sliceMax = std::numeric_limits<float>::lowest();
+        int   scanFrom = from;
+
+        if (level >= 0)
+        {
+            const int firstBin = from / binSamples;
+            const int endBin   = juce::jmin ((to + binSamples - 1) / binSamples, completeBins);
+
+            if (firstBin < endBin)
+            {
+                const float* levelMins = getMins (level);
+                const float* levelMaxs = getMaxs (level);
+
+                sliceMin = *std::min_element (levelMins + firstBin, levelMins + endBin);
+                sliceMax = *std::max_element (levelMaxs + firstBin, levelMaxs + endBin);
+                scanFrom = juce::jmax (from, endBin * binSamples);
+            }
+        }
+
+        // Not in the pyramid yet (the take's last partial bins) or zoomed below one bin
+        const int scanTo = juce::jmin (to, audio.getCapacity());
+
+        if (scanFrom < scanTo)
+            scanAudio (audio, scanFrom, scanTo, sliceMin, sliceMax);
+
+        if (sliceMin > sliceMax)
+            sliceMin = sliceMax = 0.0f;
+
+        mins[i] = sliceMin;
+        maxs[i] = sliceMax;
+    }
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "GrooveScoutRecording.h"
+
+#include <atomic>
+#include <vector>
+
+//==============================================================================
+/**
+ * GrooveScoutWaveform — min/max pyramid of the capture, built as it arrives
+ *
+ *   level 0:  min/max of the mono mix over every baseBinSamples (256) samples
+ *   level k:  pairs of level k-1 bins merged, i.e. 256·2^k samples per bin
+ *
+ * The capture writer calls append() with each stretch it has just made
+ * readable. Each sample is touched once, and a level-k bin is written the
+ * moment its last base bin completes. Display code never rescans the audio:
+ * any view (the full take, or a zoomed-in range) is answered by getRange()
+ * from the coarsest level that still has a bin per pixel. A whole bin's
+ * true peak is always kept, so short transients are not missed the way
+ * strided sampling misses them.
+ *
+ * Thread-safety contract:
+ *   - prepare()/reset() on the message thread, while append() is not running
+ *   - append() from one thread at a time (the capture writer, under its lock)
+ *   - Readers may use any bin below getNumCompleteBins (level) from any
+ *     thread. Bins are written before the completed count is published
+ *     (release/acquire).
+ */
+class GrooveScoutWaveform
+{
+public:
+    static constexpr int baseBinSamples = 256;
+    static constexpr int maxLevels      = 16;
+
+    GrooveScoutWaveform() = default;
+
+    /** Sizes every level for up to capacitySamples. Not real-time safe. */
+    void prepare (int capacitySamples);
+
+    /** Starts a new take: no complete bins, nothing pending. */
+    void reset() noexcept;
+
+    /** Folds the next numSamples of the take (stereo, downmixed here) into the pyramid. */
+    void append (const float* left, const float* right, int numSamples) noexcept;
+
+    //==========================================================================
+
+    int getNumLevels() const noexcept                   { return numLevels; }
+    static int getBinSamples (int level) noexcept       { return baseBinSamples << level; }
+
+    /** Bins of this level that are final and safe to read. */
+    int getNumCompleteBins (int level) const noexcept
+    {
+        return completeBaseBins.load (std::memory_order_acquire) >> level;
+    }
+
+    /** Raw min/max arrays of one level (valid up to getNumCompleteBins()). */
+    const float* getMins (int level) const noexcept     { return levels[(size_t) level].mins.data(); }
+    const float* getMaxs (int level) const noexcept     { return levels[(size_t) level].maxs.data(); }
+
+    /**
+     * min/max of the mono mix for numBins equal slices of [startSample, endSample).
+     * Uses the coarsest level with at least one bin per slice. The part of the
+     * range not yet covered by complete base bins, or slices narrower than a
+     * base bin, are read from the recording, so endSample must not pass
+     * recordedSamples.
+     */
+    void getRange (const GrooveScoutRecording& audio, int startSample, int endSample,
+                   int numBins, float* mins, float* maxs) const;
+
+private:
+    struct Level
+    {
+        std::vector<float> mins, maxs;
+    };
+
+    Level levels[maxLevels];
+    int   numLevels = 0;
+    int   capacityBins = 0;
+
+    // append() only: the base bin being filled
+    int   pendingSamples = 0;
+    float pendingMin = 0.0f, pendingMax = 0.0f;
+
+    std::atomic<int> completeBaseBins { 0 };
+
+    void completeBaseBin (int index, float binMin, float binMax) noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GrooveScoutWaveform)
+};
@@ -0,0 +1,216 @@
+//==============================================================================
+// GrooveScoutWorkerPool.cpp
+//
+// A plain mutex + condition variable job queue. Jobs are coarse (a tempogram
+// slice, a band's flux, one whole analysis), so the queue is never hot
+// enough for anything cleverer to pay off.
+//==============================================================================
+
+#include "GrooveScoutWorkerPool.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace
+{
+    constexpr float minCoreShare = 0.05f;
+
+    int numCores()
+    {
+        return std::max (1, juce::SystemStats::getNumCpus());
+    }
+}
+
+//==============================================================================
+
+class GrooveScoutWorkerPool::Worker : public juce::Thread
+{
+public:
+    explicit Worker (GrooveScoutWorkerPool& owner)
+        : juce::Thread ("GrooveScout analysis"), pool (owner) {}
+
+    ~Worker() override { stopThread (-1); }
+
+    void run() override { pool.workerLoop(); }
+
+private:
+    GrooveScoutWorkerPool& pool;
+};
+
+//==============================================================================
+
+GrooveScoutWorkerPool::GrooveScoutWorkerPool()
+{
+    float share = defaultMaxCoreShare;
+
+    if (const char* forced = std::getenv ("GROOVESCOUT_MAX_CORE_SHARE"))
+    {
+        const auto value = juce::String (forced).getFloatValue();
+
+        if (value > 0.0f)
+            share = value;
+    }
+
+    setMaxCoreShare (share);
+
+    // One thread per core, most of them asleep: the cap is enforced on jobs,
+    // not threads, so raising the share takes effect straight away
+    for (int i = 0; i < numCores(); ++i)
+    {
+        workers.push_back (std::make_unique<Worker> (*this));
+        workers.back()->startThread (juce::Thread::Priority::background);
+    }
+
+    DBG ("GrooveScoutWorkerPool: " << numCores() << " workers, at most "
+         << getMaxConcurrentJobs() << " running at once");
+}
+
+GrooveScoutWorkerPool::~GrooveScoutWorkerPool()
+{
+    {
+        const std::lock_guard<std::mutex> held (lock);
+        shuttingDown = true;
+        queue.clear();       // every client has stopped its analysis by now
+    }
+
+    wake.notify_all();
+    workers.clear();
+}
+
+//==============================================================================
+
+GrooveScoutWorkerPool::JobId GrooveScoutWorkerPool::addJob (ClientId client, std::function<void()> job)
+{
+    JobId id;
+
+    {
+        const std::lock_guard<std::mutex> held (lock);
+        id = nextJobId++;
+        queue.push_back ({ id, client, std::move (job) });
+    }
+
+    wake.notify_one();
+    return id;
+}
+
+bool GrooveScoutWorkerPool::cancelJob (JobId job)
+{
+    const std::lock_guard<std::mutex> held (lock);
+
+    const auto it = std::find_if (queue.begin(), queue.end(), [job] (const Job& j) { return j.id == job; });
+
+    if (it == queue.end())
+        return false;
+
+    queue.erase (it);
+    return true;
+}
+
+bool GrooveScoutWorkerPool::runQueuedJob (ClientId client)
+{
+    std::function<void()> job;
+
+    {
+        const std::lock_guard<std::mutex> held (lock);
+
+        const auto it = std::find_if (queue.begin(), queue.end(), [client] (const Job& j) { return j.client == client; });
+
+        if (it == queue.end())
+            return false;
+
+        job = std::move (it->run);
+        queue.erase (it);
+    }
+
+    // Runs in the caller's slot: it is already counted in runningJobs
+    job();
+    return true;
+}
+
+//==============================================================================
+
+void GrooveScoutWorkerPool::setFocusedClient (ClientId client)
+{
+    const std::lock_guard<std::mutex> held (lock);
+    focusedClient = client;
+}
+
+void GrooveScoutWorkerPool::clearFocusedClient (ClientId client)
+{
+    const std::lock_guard<std::mutex> held (lock);
+
+    if (focusedClient == client)
+        focusedClient = nullptr;
+}
+
+//==============================================================================
+
+void GrooveScoutWorkerPool::setMaxCoreShare (float share)
+{
+    {
+        const std::lock_guard<std::mutex> held (lock);
+        maxCoreShare  = juce::jlimit (minCoreShare, 1.0f, share);
+        maxConcurrent = juce::jlimit (1, numCores(), juce::roundToInt (maxCoreShare * static_cast<float> (numCores())));
+    }
+
+    wake.notify_all();
+}
+
+float GrooveScoutWorkerPool::getMaxCoreShare() const
+{
+    const std::lock_guard<std::mutex> held (lock);
+    return maxCoreShare;
+}
+
+int GrooveScoutWorkerPool::getMaxConcurrentJobs() const
+{
+    const std::lock_guard<std::mutex> held (lock);
+    return maxConcurrent;
+}
+
+//==============================================================================
+
+GrooveScoutWorkerPool::Job GrooveScoutWorkerPool::takeNextJob()
+{
+    auto it = queue.begin();
+
+    if (focusedClient != nullptr)
+    {
+        const auto focused = std::find_if (queue.begin(), queue.end(),
+                                           [this] (const Job& j) { return j.client == focusedClient; });
+
+        if (focused != queue.end())
+            it = focused;
+    }
+
+    Job job = std::move (*it);
+    queue.erase (it);
+    return job;
+}
+
+void GrooveScoutWorkerPool::workerLoop()
+{
+    std::unique_lock<std::mutex> held (lock);
+
+    for (;;)
+    {
+        wake.wait (held, [this] { return shuttingDown || (runningJobs < maxConcurrent && ! queue.empty()); });
+
+        if (shuttingDown)
+            return;
+
+        auto job = takeNextJob();
+        ++runningJobs;
+
+        held.unlock();
+        job.run();
+        job.run = nullptr;   // release captures outside the lock
+        held.lock();
+
+        --runningJobs;
+
+        // A slot came free — let a waiting worker take it
+        if (! queue.empty())
+            wake.notify_one();
+    }
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+//==============================================================================
+/**
+ * GrooveScoutWorkerPool — one set of analysis threads for the whole process
+ *
+ * Every GrooveScout instance holds it through a juce::SharedResourcePointer.
+ * The first instance creates it and the last one destroys it. Without it,
+ * ten instances pressing Analyze together would start ten coordinators and
+ * fifty workers and fight the host's audio threads for the cores.
+ *
+ *     instance A ─┐                          ┌─> worker ─┐
+ *     instance B ─┼─ addJob() ─> job queue ──┼─> worker ─┼─ at most
+ *     instance C ─┘   (per client)           └─> worker ─┘ getMaxConcurrentJobs()
+ *
+ * Scheduling:
+ *   - Jobs carry the client (instance) they belong to. Jobs from the focused
+ *     client, i.e. the editor the user is looking at, are taken first.
+ *     Everything else runs in the order it was queued.
+ *   - At most maxCoreShare × cores jobs run at once (at least one). The
+ *     default leaves half the machine to the host. Setting
+ *     GROOVESCOUT_MAX_CORE_SHARE (0.05 – 1) overrides it, as does
+ *     setMaxCoreShare().
+ *   - Workers run at Priority::background, below the host's audio and UI
+ *     threads, so the OS always prefers those when a core is contended.
+ *
+ * A job may queue more jobs and wait for them. It should then call
+ * runQueuedJob() while it waits, so it runs its own jobs instead of holding
+ * a slot idle. Otherwise a pool capped at one job would deadlock.
+ */
+class GrooveScoutWorkerPool
+{
+public:
+    using ClientId = const void*;
+    using JobId    = juce::uint64;
+
+    static constexpr float defaultMaxCoreShare = 0.5f;
+
+    GrooveScoutWorkerPool();
+    ~GrooveScoutWorkerPool();
+
+    //==========================================================================
+    /** Queues a job for a client. Any thread. The id is only needed for cancelJob(). */
+    JobId addJob (ClientId client, std::function<void()> job);
+
+    /** Removes a job that hasn't started yet. False if it already started
+        (or finished), in which case it will run to the end. */
+    bool cancelJob (JobId job);
+
+    /** Runs the client's oldest queued job on the calling thread.
+        False if the client has nothing queued. */
+    bool runQueuedJob (ClientId client);
+
+    //==========================================================================
+    /** Message thread: this client's jobs go ahead of everyone else's. */
+    void setFocusedClient (ClientId client);
+
+    /** Drops the focus if this client holds it (editor closed). */
+    void clearFocusedClient (ClientId client);
+
+    //==========================================================================
+    /** Fraction of the machine's cores that may run analysis at once (0.05 – 1). */
+    void  setMaxCoreShare (float share);
+    float getMaxCoreShare() const;
+
+    /** Jobs that may run at once under the current core share. */
+    int getMaxConcurrentJobs() const;
+
+private:
+    struct Job
+    {
+        JobId                 id;
+        ClientId              client;
+        std::function<void()> run;
+    };
+
+    class Worker;
+
+    void workerLoop();
+
+    /** Takes the next job in priority order. Caller holds lock, queue not empty. */
+    Job takeNextJob();
+
+    mutable std::mutex      lock;
+    std::condition_variable wake;
+    std::deque<Job>         queue;
+    ClientId                focusedClient = nullptr;
+    JobId                   nextJobId     = 1;
+    int                     runningJobs   = 0;
+    int                     maxConcurrent = 1;
+    float                   maxCoreShare  = defaultMaxCoreShare;
+    bool                    shuttingDown  = false;
+
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GrooveScoutWorkerPool)
+};
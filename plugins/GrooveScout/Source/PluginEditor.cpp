@@ -36,6 +36,7 @@ GrooveScoutAudioProcessorEditor::GrooveScoutAudioProcessorEditor (GrooveScoutAud
     analyzeKickRelay  = std::make_unique<juce::WebToggleButtonRelay> ("analyzeKick");
     analyzeSnareRelay = std::make_unique<juce::WebToggleButtonRelay> ("analyzeSnare");
     analyzeHihatRelay = std::make_unique<juce::WebToggleButtonRelay> ("analyzeHihat");
+    liveMidiRelay     = std::make_unique<juce::WebToggleButtonRelay> ("liveMidi");
 
     // =========================================================================
     // STEP 2: CREATE WEBVIEW (after relays, before attachments)
@@ -70,6 +71,7 @@ GrooveScoutAudioProcessorEditor::GrooveScoutAudioProcessorEditor (GrooveScoutAud
             .withOptionsFrom (*analyzeKickRelay)
             .withOptionsFrom (*analyzeSnareRelay)
             .withOptionsFrom (*analyzeHihatRelay)
+            .withOptionsFrom (*liveMidiRelay)
 
             // Native functions called from JavaScript via getNativeFunction('name')
             // Called on the message thread — safe to call processor methods directly
@@ -79,10 +81,10 @@ GrooveScoutAudioProcessorEditor::GrooveScoutAudioProcessorEditor (GrooveScoutAud
                 juce::Identifier ("setCaptureDuration"),
                 [this] (const juce::Array<juce::var>& args, auto complete)
                 {
-                    // args[0] = duration in seconds (1–30)
+                    // args[0] = duration in seconds (1–600)
                     if (args.size() > 0)
                     {
-                        const float secs = juce::jlimit (1.0f, 30.0f,
+                        const float secs = juce::jlimit (1.0f, static_cast<float> (GrooveScoutCapture::maxCaptureSeconds),
                             static_cast<float> (static_cast<double> (args[0])));
 
                         if (auto* p = dynamic_cast<juce::AudioParameterFloat*> (
@@ -128,6 +130,7 @@ GrooveScoutAudioProcessorEditor::GrooveScoutAudioProcessorEditor (GrooveScoutAud
                     processorRef.isPreviewActive.store (false);
                     processorRef.previewBand.store (bandIndex);
                     processorRef.previewPlayhead.store (0);
+                    processorRef.capture.startPreview();            // read-ahead restarts at sample 0
                     processorRef.previewJustStarted.store (true);  // triggers filter reset in processBlock
                     processorRef.isPreviewActive.store (true);
                     DBG ("GrooveScout: startPreview(" + band + ")");
@@ -148,10 +151,24 @@ GrooveScoutAudioProcessorEditor::GrooveScoutAudioProcessorEditor (GrooveScoutAud
                 juce::Identifier ("analyzeButtonPressed"),
                 [this] (const juce::Array<juce::var>&, auto complete)
                 {
+                    // Whoever just pressed Analyze is looking at this instance
+                    processorRef.analysisPool->setFocusedClient (&processorRef);
                     processorRef.startAnalysis();
                     complete (juce::var {});
                 })
 
+            .withNativeFunction (
+                juce::Identifier ("analyzeLastBars"),
+                [this] (const juce::Array<juce::var>& args, auto complete)
+                {
+                    // args[0] = number of bars (the UI asks for 8)
+                    const int numBars = args.size() > 0 ? juce::jlimit (1, 64, static_cast<int> (args[0])) : 8;
+
+                    processorRef.analysisPool->setFocusedClient (&processorRef);
+                    processorRef.analyzeLastBars (numBars);
+                    complete (juce::var {});
+                })
+
             .withNativeFunction (
                 juce::Identifier ("cancelAnalysis"),
                 [this] (const juce::Array<juce::var>&, auto complete)
@@ -160,6 +177,30 @@ GrooveScoutAudioProcessorEditor::GrooveScoutAudioProcessorEditor (GrooveScoutAud
                     complete (juce::var {});
                 })
 
+            .withNativeFunction (
+                juce::Identifier ("importFile"),
+                [this] (const juce::Array<juce::var>&, auto complete)
+                {
+                    processorRef.analysisPool->setFocusedClient (&processorRef);
+
+                    importChooser = std::make_unique<juce::FileChooser> (
+                        "Import audio", juce::File(), processorRef.getImporter().getWildcard());
+
+                    importChooser->launchAsync (
+                        juce::FileBrowserComponent::openMode | juce::FileBrowserComponent::canSelectFiles,
+                        [this] (const juce::FileChooser& chooser)
+                        {
+                            const auto file = chooser.getResult();
+
+                            if (processorRef.getImporter().canImport (file))
+                                processorRef.importFile (file);
+                            else if (file != juce::File())
+                                DBG ("GrooveScout: importFile — unsupported file: " + file.getFullPathName());
+                        });
+
+                    complete (juce::var {});
+                })
+
             .withNativeFunction (
                 juce::Identifier ("setBpmToDaw"),
                 [this] (const juce::Array<juce::var>&, auto complete)
@@ -180,33 +221,38 @@ GrooveScoutAudioProcessorEditor::GrooveScoutAudioProcessorEditor (GrooveScoutAud
                     if (args.size() > 0)
                         clipType = args[0].toString();
 
-                    // Resolve temp MIDI file path and clip-available flag
-                    const juce::File tempDir = juce::File::getSpecialLocation (
-                        juce::File::SpecialLocationType::tempDirectory).getChildFile ("GrooveScout");
+                    // Resolve the in-memory clip and its clip-available flag
+                    using groovescout::MidiClip;
 
-                    juce::File  midiFile;
-                    bool        clipAvailable = false;
+                    MidiClip clip {};
+                    bool     clipAvailable = false;
 
                     if (clipType == "chord")
                     {
-                        midiFile      = tempDir.getChildFile ("groovescout_chord.mid");
+                        clip          = MidiClip::chord;
                         clipAvailable = processorRef.chordClipAvailable.load();
                     }
                     else if (clipType == "kick")
                     {
-                        midiFile      = tempDir.getChildFile ("groovescout_kick.mid");
+                        clip          = MidiClip::kick;
                         clipAvailable = processorRef.kickClipAvailable.load();
                     }
                     else if (clipType == "snare")
                     {
-                        midiFile      = tempDir.getChildFile ("groovescout_snare.mid");
+                        clip          = MidiClip::snare;
                         clipAvailable = processorRef.snareClipAvailable.load();
                     }
                     else if (clipType == "hihat")
                     {
-                        midiFile      = tempDir.getChildFile ("groovescout_hihat.mid");
+                        clip          = MidiClip::hihat;
                         clipAvailable = processorRef.hihatClipAvailable.load();
                     }
+                    else if (clipType == "all")
+                    {
+                        // Every clip as one multi-track file (shift-drag in the UI)
+                        clip          = MidiClip::all;
+                        clipAvailable = processorRef.midiClips.isAvailable (MidiClip::all);
+                    }
                     else
                     {
                         DBG ("GrooveScout: startMidiDrag — unknown clip type: " + clipType);
@@ -214,7 +260,18 @@ GrooveScoutAudioProcessorEditor::GrooveScoutAudioProcessorEditor (GrooveScoutAud
                         return;
                     }
 
-                    if (clipAvailable && midiFile.existsAsFile())
+                    // midiClips is only stable once the analysis has completed
+                    clipAvailable = clipAvailable && processorRef.analysisComplete.load();
+
+                    // The OS drag needs a file: serialise just this clip, now
+                    const juce::File tempDir = juce::File::getSpecialLocation (
+                        juce::File::SpecialLocationType::tempDirectory).getChildFile ("GrooveScout");
+
+                    const juce::File midiFile = tempDir.getChildFile (
+                        "groovescout_" + juce::String (groovescout::MidiClips::getName (clip)) + ".mid");
+
+                    if (clipAvailable && tempDir.createDirectory()
+                        && processorRef.midiClips.writeTo (clip, midiFile))
                     {
                         DBG ("GrooveScout: startMidiDrag — dragging " + midiFile.getFullPathName());
                         // Pass 'this' as source component so JUCE can find the correct
@@ -316,6 +373,11 @@ GrooveScoutAudioProcessorEditor::GrooveScoutAudioProcessorEditor (GrooveScoutAud
         *analyzeHihatRelay,
         nullptr);
 
+    liveMidiAttachment = std::make_unique<juce::WebToggleButtonParameterAttachment> (
+        *processorRef.parameters.getParameter ("liveMidi"),
+        *liveMidiRelay,
+        nullptr);
+
     // =========================================================================
     // WEBVIEW SETUP
     // =========================================================================
@@ -352,6 +414,8 @@ GrooveScoutAudioProcessorEditor::~GrooveScoutAudioProcessorEditor()
 
     stopTimer();
 
+    processorRef.analysisPool->clearFocusedClient (&processorRef);
+
     // Members automatically destroyed in reverse order of declaration:
     //   1. All attachments (stop sending evaluateJavascript to WebView)
     //   2. webView (safe, attachments are gone)
@@ -374,6 +438,29 @@ void GrooveScoutAudioProcessorEditor::resized()
         webView->setBounds (getLocalBounds());
 }
 
+//==============================================================================
+// FileDragAndDropTarget — drop an audio file to import it
+//
+// Only reaches us where the platform WebView passes OS file drops up to its
+// parent. The Import button covers the rest.
+//==============================================================================
+
+bool GrooveScoutAudioProcessorEditor::isInterestedInFileDrag (const juce::StringArray& files)
+{
+    return files.size() == 1
+           && processorRef.getImporter().canImport (juce::File (files[0]))
+           && ! processorRef.isCapturing.load();
+}
+
+void GrooveScoutAudioProcessorEditor::filesDropped (const juce::StringArray& files, int, int)
+{
+    if (! isInterestedInFileDrag (files))
+        return;
+
+    processorRef.analysisPool->setFocusedClient (&processorRef);
+    processorRef.importFile (juce::File (files[0]));
+}
+
 //==============================================================================
 // Timer callback — polls processor state and pushes to WebView
 //==============================================================================
@@ -383,6 +470,10 @@ void GrooveScoutAudioProcessorEditor::timerCallback()
     if (webView == nullptr)
         return;
 
+    // The instance whose window has focus gets its analysis jobs run first
+    if (auto* peer = getPeer(); peer != nullptr && peer->isFocused())
+        processorRef.analysisPool->setFocusedClient (&processorRef);
+
     // Pre-compute recording state used in both JSON payloads below
     const int   nRecordedSamples = processorRef.recordedSamples.load();
     const float recSecs          = static_cast<float> (nRecordedSamples)
@@ -434,67 +525,111 @@ void GrooveScoutAudioProcessorEditor::timerCallback()
     webView->evaluateJavascript (script, [] (juce::WebBrowserComponent::EvaluationResult) {});
 
     // -------------------------------------------------------------------------
-    // Waveform data push — sends real RMS peak data + time-based fill fraction
-    // to JS so the waveform canvas shows recording progress even for silence.
-    // Sent whenever recordedSamples changes (recording in progress or complete).
+    // Waveform data push. Peaks come from the capture's min/max pyramid
+    // (GrooveScoutWaveform), which the capture writer extends as samples
+    // arrive, so nothing here rescans the recording:
+    //   - while recording: only the bins completed since the last tick, at
+    //     the finest level that keeps the whole capture under
+    //     maxStreamedWaveformBins. JS accumulates them and lays them out
+    //     across the capture duration.
+    //   - once stopped: one exact 250-bar view of the take.
+    // Both carry a time-based fill fraction, so the waveform shows progress
+    // even for silent recordings.
     // -------------------------------------------------------------------------
-    const int nSamples = nRecordedSamples;  // use pre-computed value from above
+    const int nSamples   = nRecordedSamples;  // use pre-computed value from above
+    const int generation = processorRef.recordingGeneration.load();
+    const auto& waveform = processorRef.capture.getWaveform();
+
+    const float durSecs = processorRef.getCaptureDurationSeconds();
+    const int capacitySamples = static_cast<int> (durSecs * processorRef.currentSampleRate);
+    const float fillFrac = (capacitySamples > 0)
+        ? juce::jmin (1.0f, static_cast<float> (nSamples) / static_cast<float> (capacitySamples))
+        : 0.0f;
 
-    if (nSamples > 0 && (processorRef.waveformDirty.load() || nSamples != lastSentWaveformSamples))
+    if (generation != sentWaveformGeneration)
     {
-        processorRef.waveformDirty.store (false);
-        lastSentWaveformSamples = nSamples;
+        // New take (or re-prepared capture) — start streaming from bin 0
+        sentWaveformGeneration  = generation;
+        sentWaveformBins        = 0;
+        streamedWaveformSamples = 0;
+        lastSentWaveformSamples = 0;
 
-        constexpr int BAR_COUNT = 250;
+        waveformLevel = 0;
+        while (waveformLevel + 1 < waveform.getNumLevels()
+               && capacitySamples / GrooveScoutWaveform::getBinSamples (waveformLevel) > maxStreamedWaveformBins)
+            ++waveformLevel;
+    }
 
-        // Read pointers — safe: audio thread only writes to positions >= nSamples.
-        // We captured nSamples first, so 0..nSamples-1 are fully written.
-        const float* L = processorRef.recordingBuffer.getReadPointer (0);
-        const float* R = processorRef.recordingBuffer.getReadPointer (1);
+    auto sendWaveform = [this, fillFrac, recSecs] (const juce::String& payload)
+    {
+        // Send as object {bars|bins, fill, secs} so JS has all info it needs
+        const juce::String waveScript =
+            "if(window.groovescout_updateWaveform){"
+            "window.groovescout_updateWaveform({"
+            + payload + ","
+            "\"fill\":" + juce::String (fillFrac, 3) + ","
+            "\"secs\":" + juce::String (recSecs, 1)
+            + "});}";
+
+        webView->evaluateJavascript (waveScript, [] (juce::WebBrowserComponent::EvaluationResult) {});
+    };
 
-        juce::String rmsJson = "[";
+    if (processorRef.isCapturing.load())
+    {
+        const int completeBins = juce::jmin (waveform.getNumCompleteBins (waveformLevel),
+                                             sentWaveformBins + maxStreamedWaveformBins);
 
-        for (int bar = 0; bar < BAR_COUNT; ++bar)
+        if (completeBins > sentWaveformBins || nSamples != streamedWaveformSamples)
         {
-            const int start = (int) ((int64_t) bar       * nSamples / BAR_COUNT);
-            const int end   = (int) ((int64_t) (bar + 1) * nSamples / BAR_COUNT);
+            processorRef.waveformDirty.store (false);
+
+            const float* mins = waveform.getMins (waveformLevel);
+            const float* maxs = waveform.getMaxs (waveformLevel);
+
+            juce::String minJson, maxJson;
 
-            float peak = 0.0f;
-            if (start < nSamples && start < end)
+            for (int i = sentWaveformBins; i < completeBins; ++i)
             {
-                // Sample at most ~10 points per bucket to keep CPU light
-                const int step = std::max (1, (end - start) / 10);
-                for (int i = start; i < end && i < nSamples; i += step)
-                {
-                    const float s = std::abs ((L[i] + R[i]) * 0.5f);
-                    if (s > peak) peak = s;
-                }
+                const bool last = (i == completeBins - 1);
+                minJson += juce::String (mins[i], 4) + (last ? "" : ",");
+                maxJson += juce::String (maxs[i], 4) + (last ? "" : ",");
             }
 
-            rmsJson += juce::String (peak, 4);
-            if (bar < BAR_COUNT - 1) rmsJson += ",";
+            const int totalBins = capacitySamples / GrooveScoutWaveform::getBinSamples (waveformLevel);
+
+            sendWaveform ("\"bins\":{"
+                          "\"first\":" + juce::String (sentWaveformBins) + ","
+                          "\"total\":" + juce::String (juce::jmax (1, totalBins)) + ","
+                          "\"min\":[" + minJson + "],"
+                          "\"max\":[" + maxJson + "]}");
+
+            sentWaveformBins        = completeBins;
+            streamedWaveformSamples = nSamples;
+            lastSentWaveformSamples = 0;   // the take's full view is still owed once capture stops
         }
+    }
+    else if (nSamples > 0 && (processorRef.waveformDirty.load() || nSamples != lastSentWaveformSamples))
+    {
+        processorRef.waveformDirty.store (false);
+        lastSentWaveformSamples = nSamples;
 
-        rmsJson += "]";
+        constexpr int BAR_COUNT = 250;
 
-        // Time-based fill fraction: shows waveform progress even for silent recordings.
-        // fillFrac = recordedSamples / capacitySamples (clamped 0-1).
-        const float durSecs = processorRef.getCaptureDurationSeconds();
-        const int capacitySamples = static_cast<int> (durSecs * processorRef.currentSampleRate);
-        const float fillFrac = (capacitySamples > 0)
-            ? juce::jmin (1.0f, static_cast<float> (nSamples) / static_cast<float> (capacitySamples))
-            : 0.0f;
+        // Safe: [0, nSamples) is fully written, and the pyramid only reads within it
+        float mins[BAR_COUNT], maxs[BAR_COUNT];
+        waveform.getRange (processorRef.recording, 0, nSamples, BAR_COUNT, mins, maxs);
 
-        // Send as object {bars, fill, secs} so JS has all info it needs
-        const juce::String waveScript =
-            "if(window.groovescout_updateWaveform){"
-            "window.groovescout_updateWaveform({"
-            "\"bars\":" + rmsJson + ","
-            "\"fill\":" + juce::String (fillFrac, 3) + ","
-            "\"secs\":" + juce::String (recSecs, 1)
-            + "});}";
+        juce::String barsJson = "[";
 
-        webView->evaluateJavascript (waveScript, [] (juce::WebBrowserComponent::EvaluationResult) {});
+        for (int bar = 0; bar < BAR_COUNT; ++bar)
+        {
+            barsJson += juce::String (juce::jmax (maxs[bar], -mins[bar]), 4);
+            if (bar < BAR_COUNT - 1) barsJson += ",";
+        }
+
+        barsJson += "]";
+
+        sendWaveform ("\"bars\":" + barsJson);
     }
     else if (nSamples == 0 && lastSentWaveformSamples != 0)
     {
@@ -25,6 +25,7 @@
  */
 class GrooveScoutAudioProcessorEditor : public juce::AudioProcessorEditor,
                                         public juce::DragAndDropContainer,
+                                        public juce::FileDragAndDropTarget,
                                         public juce::Timer
 {
 public:
@@ -38,6 +39,10 @@ public:
     // Timer callback — polls processor and updates WebView state
     void timerCallback() override;
 
+    // Audio files dropped on the editor are imported (see GrooveScoutImport)
+    bool isInterestedInFileDrag (const juce::StringArray& files) override;
+    void filesDropped (const juce::StringArray& files, int x, int y) override;
+
 private:
     GrooveScoutAudioProcessor& processorRef;
 
@@ -71,6 +76,7 @@ private:
     std::unique_ptr<juce::WebToggleButtonRelay> analyzeKickRelay;
     std::unique_ptr<juce::WebToggleButtonRelay> analyzeSnareRelay;
     std::unique_ptr<juce::WebToggleButtonRelay> analyzeHihatRelay;
+    std::unique_ptr<juce::WebToggleButtonRelay> liveMidiRelay;
 
     // -------------------------------------------------------------------------
     // 2. WEBVIEW SECOND (depends on relays via .withOptionsFrom())
@@ -101,6 +107,7 @@ private:
     std::unique_ptr<juce::WebToggleButtonParameterAttachment> analyzeKickAttachment;
     std::unique_ptr<juce::WebToggleButtonParameterAttachment> analyzeSnareAttachment;
     std::unique_ptr<juce::WebToggleButtonParameterAttachment> analyzeHihatAttachment;
+    std::unique_ptr<juce::WebToggleButtonParameterAttachment> liveMidiAttachment;
 
     // -------------------------------------------------------------------------
     // Resource provider helper
@@ -111,5 +118,15 @@ private:
     // Used to avoid redundant waveform updates when nothing has changed
     int lastSentWaveformSamples = 0;
 
+    // Streaming waveform bins while recording (see timerCallback)
+    static constexpr int maxStreamedWaveformBins = 4096;   // per capture, bounds the JS-side array
+    int sentWaveformGeneration = -1;   // processor's recordingGeneration the bins belong to
+    int sentWaveformBins       = 0;    // bins of waveformLevel already sent this take
+    int streamedWaveformSamples = 0;   // recordedSamples at the last streamed update
+    int waveformLevel          = 0;    // pyramid level streamed this take
+
+    // Kept alive while the async "Import audio" chooser is open
+    std::unique_ptr<juce::FileChooser> importChooser;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GrooveScoutAudioProcessorEditor)
 };
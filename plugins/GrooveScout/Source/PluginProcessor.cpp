@@ -1,11 +1,22 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
 #include "GrooveScoutAnalyzer.h"
+#include "GrooveScoutLiveAnalyzer.h"
+
+namespace
+{
+    /** juce::IIRCoefficients keeps b0, b1, b2, a1, a2 already divided by a0. */
+    pfs::dsp::BiquadCoeffs toBiquad (const juce::IIRCoefficients& c) noexcept
+    {
+        return { c.coefficients[0], c.coefficients[1], c.coefficients[2],
+                 c.coefficients[3], c.coefficients[4] };
+    }
+}
 
 //==============================================================================
 // Parameter layout — EXACT specification from parameter-spec.md
 // Order and values are immutable during Stages 1–5.
-// Total: 15 parameters (9 Float, 1 Choice, 5 Bool)
+// Total: 17 parameters (10 Float, 1 Choice, 6 Bool)
 //==============================================================================
 
 juce::AudioProcessorValueTreeState::ParameterLayout
@@ -17,14 +28,20 @@ GrooveScoutAudioProcessor::createParameterLayout()
     // Capture
     // -------------------------------------------------------------------------
 
-    // 1. captureDuration — Float, 1.0–30.0 s, linear, default 15.0
-    layout.add (std::make_unique<juce::AudioParameterFloat> (
-        juce::ParameterID { "captureDuration", 1 },
-        "Capture Duration",
-        juce::NormalisableRange<float> (1.0f, 30.0f),
-        15.0f,
-        "s"
-    ));
+    // 1. captureDuration — Float, 1.0–600.0 s, 1 s steps, skewed so 30 s sits mid-travel,
+    //    default 15.0. Upper bound matches GrooveScoutCapture::maxCaptureSeconds.
+    {
+        juce::NormalisableRange<float> captureRange (1.0f, 600.0f, 1.0f);
+        captureRange.setSkewForCentre (30.0f);
+
+        layout.add (std::make_unique<juce::AudioParameterFloat> (
+            juce::ParameterID { "captureDuration", 1 },
+            "Capture Duration",
+            captureRange,
+            15.0f,
+            "s"
+        ));
+    }
 
     // -------------------------------------------------------------------------
     // Kick detection
@@ -167,6 +184,18 @@ GrooveScoutAudioProcessor::createParameterLayout()
         true
     ));
 
+    // -------------------------------------------------------------------------
+    // Live Output
+    // -------------------------------------------------------------------------
+
+    // 17. liveMidi — Bool, default false. Kick/snare/hihat hits in the input
+    //     become note-ons on the MIDI output (GrooveScoutLiveDrums)
+    layout.add (std::make_unique<juce::AudioParameterBool> (
+        juce::ParameterID { "liveMidi", 1 },
+        "Live MIDI",
+        false
+    ));
+
     return layout;
 }
 
@@ -180,13 +209,19 @@ GrooveScoutAudioProcessor::GrooveScoutAudioProcessor()
                           .withOutput ("Output", juce::AudioChannelSet::stereo(), true))
     , parameters (*this, nullptr, "Parameters", createParameterLayout())
 {
+    liveAnalyzer = std::make_unique<GrooveScoutLiveAnalyzer> (*this);
 }
 
 GrooveScoutAudioProcessor::~GrooveScoutAudioProcessor()
 {
-    // CRITICAL: stop background thread before destruction
-    if (analyzerThread)
-        analyzerThread->stopThread (2000);
+    // CRITICAL: stop background analysis before destruction
+    if (analyzer)
+        analyzer->stop();
+
+    analysisPool->clearFocusedClient (this);
+
+    if (liveAnalyzer)
+        liveAnalyzer->stopThread (2000);
 }
 
 //==============================================================================
@@ -198,11 +233,25 @@ void GrooveScoutAudioProcessor::prepareToPlay (double sampleRate, int samplesPer
     currentSampleRate = sampleRate;
     currentBlockSize  = samplesPerBlock;
 
-    // Pre-allocate recording buffer: max 30s × sampleRate × 2 channels.
-    // This is the ONLY place we allocate — NEVER allocate in processBlock().
-    const int maxCaptureSamples = static_cast<int> (sampleRate * 30.0);
-    recordingBuffer.setSize (2, maxCaptureSamples, false, true, false);
-    recordedSamples.store (0);
+    // Recording storage: a memory-mapped spill file sized for the longest capture
+    // (maxCaptureSeconds), fed through a small lock-free ring. This is the ONLY
+    // place it is (re)created — NEVER allocate in processBlock(). The file is only
+    // rebuilt when the sample rate changes; otherwise the take is just rewound.
+
+    // An analysis still reading the take must finish before the file can be remapped
+    if (analyzer && analyzer->isRunning())
+        analyzer->stop();
+
+    // Live features refer to the old buffer / rate — stop reading it before re-attaching
+    liveAnalyzer->invalidate();
+    recordingGeneration.fetch_add (1);         // cached analysis refers to the old take
+
+    capture.prepare (sampleRate);              // resets recordedSamples to 0
+    recording = capture.getRecording();
+
+    history.prepare (sampleRate);              // the retroactive ring starts empty at a new rate
+    liveDrums.prepare (sampleRate, samplesPerBlock);
+    liveMidiWasOn = false;
 
     // Pre-allocate waveform RMS circular buffer (200 buckets for display)
     {
@@ -231,9 +280,19 @@ void GrooveScoutAudioProcessor::prepareToPlay (double sampleRate, int samplesPer
     p_kickSensitivity  = parameters.getRawParameterValue ("kickSensitivity");
     p_snareSensitivity = parameters.getRawParameterValue ("snareSensitivity");
     p_hihatSensitivity = parameters.getRawParameterValue ("hihatSensitivity");
+    p_analyzeKick      = parameters.getRawParameterValue ("analyzeKick");
+    p_analyzeSnare     = parameters.getRawParameterValue ("analyzeSnare");
+    p_analyzeHihat     = parameters.getRawParameterValue ("analyzeHihat");
+    p_liveMidi         = parameters.getRawParameterValue ("liveMidi");
+
+    resetPreviewState();
+}
+
+void GrooveScoutAudioProcessor::resetPreviewState() noexcept
+{
+    for (auto& state : previewFilterState)
+        state = {};
 
-    // Reset preview filter state
-    for (int ch = 0; ch < 2; ++ch) { previewHP[ch].reset(); previewLP[ch].reset(); }
     previewLastFreqLow  = -1.0f;
     previewLastFreqHigh = -1.0f;
     previewLastBand     = -1;
@@ -244,9 +303,9 @@ void GrooveScoutAudioProcessor::prepareToPlay (double sampleRate, int samplesPer
 
 void GrooveScoutAudioProcessor::releaseResources()
 {
-    // Cancel any active analysis thread
-    if (analyzerThread && analyzerThread->isThreadRunning())
-        analyzerThread->stopThread (2000);
+    // Cancel any active analysis
+    if (analyzer && analyzer->isRunning())
+        analyzer->stop();
 
     isCapturing.store (false);
     isPreviewActive.store (false);
@@ -273,20 +332,68 @@ void GrooveScoutAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
                                               juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
-    juce::ignoreUnused (midiMessages);
+
+    // The MIDI output carries live drum hits only — nothing comes in (acceptsMidi() is false)
+    midiMessages.clear();
 
     const int numSamples  = buffer.getNumSamples();
     const int numChannels = juce::jmin (buffer.getNumChannels(), 2);
 
-    // Recording — append incoming audio to pre-allocated recording buffer.
-    // Audio thread ONLY writes during isCapturing == true.
-    // All reads of recordingBuffer happen in background thread AFTER isCapturing == false.
-    if (isCapturing.load())
+    // A rewind waits for this: from here on this block sees captureHeld, and no
+    // push() from an earlier block can still be running
+    captureHoldAck.store (captureHoldRequest.load());
+
+    // History — every block of input, REC or not, so the last few bars can be
+    // analysed after the fact. Before preview, which replaces the buffer.
+    history.push (buffer.getArrayOfReadPointers(), numChannels, numSamples, getPlayHead());
+
+    // Live drum MIDI — the same band settings the analysis uses, on the input,
+    // with note-ons at the sample each hit is confirmed (see GrooveScoutLiveDrums)
+    const bool liveMidi = p_liveMidi != nullptr && p_liveMidi->load() > 0.5f;
+
+    if (liveMidi)
     {
-        const int currentHead    = recordedSamples.load();
-        const int bufferCapacity = recordingBuffer.getNumSamples();
+        if (! liveMidiWasOn)
+            liveDrums.reset();
 
-        // Apply captureDuration limit (user-set, 1–30 s).
+        auto readBand = [] (std::atomic<float>* enabled, std::atomic<float>* low, std::atomic<float>* high,
+                            std::atomic<float>* sensitivity, const groovescout::AnalysisSettings::Band& fallback)
+        {
+            GrooveScoutLiveDrums::BandParams band;
+            band.enabled     = enabled     != nullptr ? enabled->load() > 0.5f : fallback.enabled;
+            band.freqLow     = low         != nullptr ? low->load()            : fallback.freqLow;
+            band.freqHigh    = high        != nullptr ? high->load()           : fallback.freqHigh;
+            band.sensitivity = sensitivity != nullptr ? sensitivity->load()    : fallback.sensitivity;
+            return band;
+        };
+
+        const groovescout::AnalysisSettings defaults;   // parameter defaults, if a pointer is missing
+
+        const GrooveScoutLiveDrums::BandParams bands[GrooveScoutLiveDrums::numBands] = {
+            readBand (p_analyzeKick,  p_kickFreqLow,  p_kickFreqHigh,  p_kickSensitivity,  defaults.kick),
+            readBand (p_analyzeSnare, p_snareFreqLow, p_snareFreqHigh, p_snareSensitivity, defaults.snare),
+            readBand (p_analyzeHihat, p_hihatFreqLow, p_hihatFreqHigh, p_hihatSensitivity, defaults.hihat)
+        };
+
+        liveDrums.process (buffer.getArrayOfReadPointers(), numChannels, numSamples, bands, midiMessages);
+    }
+    else if (liveMidiWasOn)
+    {
+        liveDrums.endNotes (midiMessages, 0);
+    }
+
+    liveMidiWasOn = liveMidi;
+
+    // Recording — hand incoming audio to the capture ring (wait-free, no I/O).
+    // Audio thread ONLY writes during isCapturing == true. The capture writer
+    // thread converts it into the 16-bit recording and advances recordedSamples, so the
+    // audio thread tracks its own write head via getPushedSamples().
+    if (isCapturing.load() && ! captureHeld.load())
+    {
+        const int currentHead    = capture.getPushedSamples();
+        const int bufferCapacity = capture.getCapacitySamples();
+
+        // Apply captureDuration limit (user-set, 1–600 s).
         // getRawParameterValue returns an atomic<float>* — safe to call in audio thread.
         const float durSecs = getCaptureDurationSeconds();
         const int durationLimitSamples = static_cast<int> (durSecs * currentSampleRate);
@@ -298,14 +405,9 @@ void GrooveScoutAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
         {
             const int samplesToCopy = juce::jmin (numSamples, samplesAvailable);
 
-            for (int ch = 0; ch < numChannels; ++ch)
-                recordingBuffer.copyFrom (ch, currentHead,
-                                          buffer.getReadPointer (ch), samplesToCopy);
-
-            recordedSamples.store (currentHead + samplesToCopy);
-
-            // Signal waveform update — Timer callback pushes RMS data to JS
-            waveformDirty.store (true);
+            // Mono input is mirrored to both capture channels. If the writer ever
+            // falls a whole ring behind, the overflow is dropped (and logged by it).
+            capture.push (buffer.getArrayOfReadPointers(), numChannels, samplesToCopy);
 
             if (samplesAvailable <= numSamples)
             {
@@ -327,7 +429,7 @@ void GrooveScoutAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     // filtered to the selected drum's frequency range so the user hears only
     // that band while auditioning.
     //
-    // Sensitivity gate: mirrors the adaptive threshold used in detectOnsetsInBand().
+    // Sensitivity gate: mirrors the adaptive threshold used in onsetsFromFlux().
     // Gate opens when the filtered envelope exceeds peak * (1 - sensitivity) * 0.35.
     //   sensitivity=1.0 → threshold=0 → gate always open (hear full band)
     //   sensitivity=0.5 → threshold=peak*0.175 → only moderately loud hits pass
@@ -339,19 +441,13 @@ void GrooveScoutAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
         {
             const int head   = previewPlayhead.load();
             const int numCh  = juce::jmin (buffer.getNumChannels(),
-                                            recordingBuffer.getNumChannels());
+                                            GrooveScoutRecording::numChannels);
 
             // Reset filter + gate state at the start of a new preview session
             if (previewJustStarted.load())
             {
                 previewJustStarted.store (false);
-                previewLastFreqLow  = -1.0f;
-                previewLastFreqHigh = -1.0f;
-                previewLastBand     = -1;
-                for (int ch = 0; ch < 2; ++ch) { previewHP[ch].reset(); previewLP[ch].reset(); }
-                previewGateEnv    = 0.0f;
-                previewGatePeak   = 0.0f;
-                previewGateSmooth = 0.0f;
+                resetPreviewState();
             }
 
             // Read freq range for the active band (cached atomic pointers — safe on audio thread)
@@ -364,7 +460,7 @@ void GrooveScoutAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
             else                { freqLow = p_hihatFreqLow  ? p_hihatFreqLow->load() :  5000.0f;
                                   freqHigh = p_hihatFreqHigh ? p_hihatFreqHigh->load(): 16000.0f; }
 
-            // Recompute IIR coefficients only when band or freq params change
+            // Recompute biquad coefficients only when band or freq params change
             if (band != previewLastBand
                 || std::abs (freqLow  - previewLastFreqLow)  > 0.5f
                 || std::abs (freqHigh - previewLastFreqHigh) > 0.5f)
@@ -373,12 +469,12 @@ void GrooveScoutAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
                 previewLastFreqLow  = freqLow;
                 previewLastFreqHigh = freqHigh;
 
-                const auto hpCoeffs = juce::IIRCoefficients::makeHighPass (currentSampleRate, (double) freqLow);
-                const auto lpCoeffs = juce::IIRCoefficients::makeLowPass  (currentSampleRate, (double) freqHigh);
+                const auto hp = toBiquad (juce::IIRCoefficients::makeHighPass (currentSampleRate, (double) freqLow));
+                const auto lp = toBiquad (juce::IIRCoefficients::makeLowPass  (currentSampleRate, (double) freqHigh));
                 for (int ch = 0; ch < 2; ++ch)
                 {
-                    previewHP[ch].setCoefficients (hpCoeffs);
-                    previewLP[ch].setCoefficients (lpCoeffs);
+                    previewFilter[0].setLane (ch, hp);
+                    previewFilter[1].setLane (ch, lp);
                 }
             }
 
@@ -398,50 +494,54 @@ void GrooveScoutAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
             const float gateOpenSpeed  = 0.01f;
             const float gateCloseSpeed = 0.001f;
 
-            // Fill buffer with band-filtered + sensitivity-gated recorded audio.
-            // Gate uses channel-0 envelope; the same gate value is applied to all channels.
-            for (int i = 0; i < numSamples; ++i)
-            {
-                const int readPos = (head + i) % nRecorded;
-
-                // Filter channel 0 and use it to drive the gate envelope
-                float s0 = recordingBuffer.getSample (0, readPos);
-                s0 = previewHP[0].processSingleSampleRaw (s0);
-                s0 = previewLP[0].processSingleSampleRaw (s0);
+            // 1. The next stretch of the looping take. The capture writer pages it in from
+            //    the spill file ahead of time, so this is a plain copy; any gap is silent
+            const int delivered = capture.readPreview (buffer.getArrayOfWritePointers(), numCh, numSamples);
 
-                // Envelope follower: instant attack, ~75ms release
-                const float absS = std::abs (s0);
-                if (absS > previewGateEnv) previewGateEnv = absS;
-                else                       previewGateEnv *= gateRelCoeff;
+            // 2. Band-pass every channel in one pass, L and R as lanes of one register
+            pfs::dsp::filterBank (buffer.getArrayOfWritePointers(), numCh, numSamples,
+                                  previewFilter, previewFilterState, 2);
 
-                // Slow peak tracker: provides a stable reference across buffer loops
-                if (previewGateEnv > previewGatePeak) previewGatePeak = previewGateEnv;
-                else                                  previewGatePeak *= gatePeakCoeff;
+            // 3. Gate. The envelope/peak/smoothing recurrence is inherently serial,
+            //    so channel 0 drives it into a gain block; the gain is then applied
+            //    to every channel as a vector multiply.
+            float gain[previewGateBlock];
 
-                // Gate threshold: mirrors detectOnsetsInBand() sensitivity semantics.
-                // sensitivity=1.0 → thresh=0 → gate always open
-                // sensitivity=0.0 → thresh=peak*0.35 → only strong transients pass
-                const float thresh = previewGatePeak * (1.0f - sensitivity) * 0.35f;
-
-                // Smoothed gate output — fast open preserves transient click,
-                // slow close avoids chopping the decay of each hit
-                const float target    = (previewGateEnv > thresh) ? 1.0f : 0.0f;
-                const float gateSpeed = (target > previewGateSmooth) ? gateOpenSpeed : gateCloseSpeed;
-                previewGateSmooth    += (target - previewGateSmooth) * gateSpeed;
-
-                buffer.setSample (0, i, s0 * previewGateSmooth);
+            for (int start = 0; start < numSamples; start += previewGateBlock)
+            {
+                const int    count = juce::jmin (previewGateBlock, numSamples - start);
+                const float* s0    = buffer.getReadPointer (0, start);
 
-                // Filter remaining channels with the same gate value
-                for (int ch = 1; ch < numCh; ++ch)
+                for (int i = 0; i < count; ++i)
                 {
-                    float s = recordingBuffer.getSample (ch, readPos);
-                    s = previewHP[ch].processSingleSampleRaw (s);
-                    s = previewLP[ch].processSingleSampleRaw (s);
-                    buffer.setSample (ch, i, s * previewGateSmooth);
+                    // Envelope follower: instant attack, ~75ms release
+                    const float absS = std::abs (s0[i]);
+                    if (absS > previewGateEnv) previewGateEnv = absS;
+                    else                       previewGateEnv *= gateRelCoeff;
+
+                    // Slow peak tracker: provides a stable reference across buffer loops
+                    if (previewGateEnv > previewGatePeak) previewGatePeak = previewGateEnv;
+                    else                                  previewGatePeak *= gatePeakCoeff;
+
+                    // Gate threshold: mirrors onsetsFromFlux() sensitivity semantics.
+                    // sensitivity=1.0 → thresh=0 → gate always open
+                    // sensitivity=0.0 → thresh=peak*0.35 → only strong transients pass
+                    const float thresh = previewGatePeak * (1.0f - sensitivity) * 0.35f;
+
+                    // Smoothed gate output — fast open preserves transient click,
+                    // slow close avoids chopping the decay of each hit
+                    const float target    = (previewGateEnv > thresh) ? 1.0f : 0.0f;
+                    const float gateSpeed = (target > previewGateSmooth) ? gateOpenSpeed : gateCloseSpeed;
+                    previewGateSmooth    += (target - previewGateSmooth) * gateSpeed;
+
+                    gain[i] = previewGateSmooth;
                 }
+
+                for (int ch = 0; ch < numCh; ++ch)
+                    juce::FloatVectorOperations::multiply (buffer.getWritePointer (ch, start), gain, count);
             }
 
-            previewPlayhead.store ((head + numSamples) % nRecorded);
+            previewPlayhead.store ((head + delivered) % nRecorded);
         }
     }
 
@@ -488,12 +588,13 @@ void GrooveScoutAudioProcessor::setStateInformation (const void* data, int sizeI
 
 void GrooveScoutAudioProcessor::startRecording()
 {
-    // Stop any running analysis thread first
-    if (analyzerThread && analyzerThread->isThreadRunning())
-        analyzerThread->stopThread (2000);
+    // Stop any running analysis first
+    if (analyzer && analyzer->isRunning())
+        analyzer->stop();
 
-    // Reset all state flags
-    recordedSamples.store (0);
+    // Reset all state flags — rewinds the capture (ring, write head, recordedSamples)
+    rewindCapture();
+    recordingGeneration.fetch_add (1);   // new take — cached analysis no longer applies
     analyzeTriggered.store (false);   // CRITICAL: clear stale flag from previous analysis
     analysisComplete.store (false);
     analysisCancelled.store (false);
@@ -506,16 +607,33 @@ void GrooveScoutAudioProcessor::startRecording()
 
     // Begin capture — audio thread starts appending on next processBlock()
     isCapturing.store (true);
+
+    // Extract analysis features while recording so Analyze only has the final steps left
+    liveAnalyzer->begin();
     DBG ("GrooveScout: startRecording()");
 }
 
+void GrooveScoutAudioProcessor::rewindCapture()
+{
+    captureHeld.store (true);
+    const int request = captureHoldRequest.fetch_add (1) + 1;
+
+    // One block at most while the host is processing. If it isn't (transport
+    // suspended, no device), nothing is pushing and the wait simply runs out.
+    for (int waitedMs = 0; captureHoldAck.load() != request && waitedMs < 200; ++waitedMs)
+        juce::Thread::sleep (1);
+
+    capture.reset();
+    captureHeld.store (false);
+}
+
 void GrooveScoutAudioProcessor::stopCurrentOperation()
 {
     isCapturing.store (false);
     isPreviewActive.store (false);
 
-    if (analyzerThread && analyzerThread->isThreadRunning())
-        analyzerThread->stopThread (2000);
+    if (analyzer && analyzer->isRunning())
+        analyzer->stop();
 
     DBG ("GrooveScout: stopCurrentOperation()");
 }
@@ -546,22 +664,25 @@ void GrooveScoutAudioProcessor::startAnalysis()
     analysisProgress.store (0);
     analysisStep.store (0);
 
-    // Create analyzer thread on first use, then start it
-    if (!analyzerThread)
-        analyzerThread = std::make_unique<GrooveScoutAnalyzer> (*this);
+    // A re-analysis may produce fewer clips than the last one
+    kickClipAvailable.store (false);
+    snareClipAvailable.store (false);
+    hihatClipAvailable.store (false);
+    chordClipAvailable.store (false);
 
-    if (analyzerThread->isThreadRunning())
-        analyzerThread->stopThread (2000);
+    // Create the analyzer on first use, then queue it on the shared pool
+    if (!analyzer)
+        analyzer = std::make_unique<GrooveScoutAnalyzer> (*this, *analysisPool);
 
-    analyzerThread->startThread (juce::Thread::Priority::low);
-    DBG ("GrooveScout: startAnalysis() — thread started");
+    analyzer->start();
+    DBG ("GrooveScout: startAnalysis() — analysis queued");
 }
 
 void GrooveScoutAudioProcessor::cancelAnalysis()
 {
-    if (analyzerThread && analyzerThread->isThreadRunning())
+    if (analyzer && analyzer->isRunning())
     {
-        analyzerThread->stopThread (2000);
+        analyzer->stop();
         analysisCancelled.store (true);
         analysisProgress.store (0);
         analysisStep.store (0);
@@ -569,6 +690,86 @@ void GrooveScoutAudioProcessor::cancelAnalysis()
     }
 }
 
+void GrooveScoutAudioProcessor::importFile (const juce::File& file)
+{
+    // Not over a take that is still being recorded (the editor's drop target refuses too)
+    if (isCapturing.load())
+    {
+        DBG ("GrooveScout: importFile() ignored while recording");
+        return;
+    }
+
+    // The file replaces the take, just as a new recording would
+    if (analyzer && analyzer->isRunning())
+        analyzer->stop();
+
+    liveAnalyzer->invalidate();          // nothing to follow — the analysis runs the offline pass
+
+    rewindCapture();
+    recordingGeneration.fetch_add (1);
+    recordingComplete.store (false);
+
+    // Straight into analysis: the UI shows progress from the start of decoding
+    analyzeTriggered.store (true);
+    analysisComplete.store (false);
+    analysisCancelled.store (false);
+    analysisError.store (0);
+    analysisProgress.store (0);
+    analysisStep.store (0);
+
+    kickClipAvailable.store (false);
+    snareClipAvailable.store (false);
+    hihatClipAvailable.store (false);
+    chordClipAvailable.store (false);
+
+    if (!analyzer)
+        analyzer = std::make_unique<GrooveScoutAnalyzer> (*this, *analysisPool);
+
+    analyzer->startImport (file);
+    DBG ("GrooveScout: importFile() — " << file.getFullPathName());
+}
+
+void GrooveScoutAudioProcessor::analyzeLastBars (int numBars)
+{
+    // Not over a take that is still being recorded
+    if (isCapturing.load())
+    {
+        DBG ("GrooveScout: analyzeLastBars() ignored while recording");
+        return;
+    }
+
+    // Like a new recording, except the audio has already been heard
+    if (analyzer && analyzer->isRunning())
+        analyzer->stop();
+
+    liveAnalyzer->invalidate();          // the analysis runs the offline pass over the snapshot
+
+    rewindCapture();
+    recordingGeneration.fetch_add (1);
+    recordingComplete.store (false);
+
+    // Copied here, before anything is queued: a job that waited in the pool
+    // could find the oldest bars already overwritten. The ring and the capture
+    // share the 16-bit format, so this is a memcpy per channel and ring wrap.
+    const auto span = history.findLastBars (numBars);
+
+    if (! history.copyTo (capture, span))
+    {
+        DBG ("GrooveScout: analyzeLastBars() — history overwritten during the copy");
+        rewindCapture();
+        analyzeTriggered.store (true);
+        analysisError.store (4);   // 4 = snapshot overwritten
+        analysisComplete.store (true);
+        return;
+    }
+
+    DBG ("GrooveScout: analyzeLastBars (" << numBars << ") — " << span.bars << " bars, "
+         << span.getLength() << " samples");
+
+    // An empty history ends as "buffer empty", like Analyze without a take
+    startAnalysis();
+}
+
 void GrooveScoutAudioProcessor::togglePreview (const juce::String& band)
 {
     // Kept for compatibility — editor now calls startPreview/stopPreview
@@ -2,9 +2,17 @@
 
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_gui_extra/juce_gui_extra.h>
-
-// Forward declaration — GrooveScoutAnalyzer is defined in GrooveScoutAnalyzer.h
+#include "GrooveScoutCapture.h"
+#include "GrooveScoutHistory.h"
+#include "GrooveScoutLiveDrums.h"
+#include "GrooveScoutImport.h"
+#include "GrooveScoutAnalysisCore.h"   // groovescout::MidiClips
+#include "GrooveScoutWorkerPool.h"
+#include "PfsDspKernels.h"
+
+// Forward declarations — defined in GrooveScoutAnalyzer.h / GrooveScoutLiveAnalyzer.h
 class GrooveScoutAnalyzer;
+class GrooveScoutLiveAnalyzer;
 
 //==============================================================================
 /**
@@ -51,10 +59,9 @@ public:
     const juce::String getName() const override { return "GrooveScout"; }
 
     bool acceptsMidi() const override { return false; }
-    bool producesMidi() const override { return false; }
+    bool producesMidi() const override { return true; }   // live drum MIDI (liveMidi parameter)
     bool isMidiEffect() const override { return false; }
     double getTailLengthSeconds() const override { return 0.0; }
-    int getLatencySamples() const { return 0; }
 
     //==============================================================================
     // Programs
@@ -89,6 +96,7 @@ public:
     // Recording state
     std::atomic<bool>  isCapturing       { false };
     std::atomic<bool>  recordingComplete { false };
+    std::atomic<int>   recordingGeneration { 0 };  // bumped per take; keys GrooveScoutAnalyzer's cache
 
     // Preview state
     std::atomic<bool>  isPreviewActive    { false };
@@ -105,7 +113,7 @@ public:
     // Extended analysis state (Stage 2 DSP.1)
     std::atomic<bool>  analyzeTriggered  { false };
     std::atomic<bool>  analysisCancelled { false };
-    std::atomic<int>   analysisError     { 0 };  // 0=none, 1=buffer too short, 2=cancelled
+    std::atomic<int>   analysisError     { 0 };  // 0=none, 1=buffer too short, 2=cancelled, 3=file unreadable, 4=snapshot overwritten
 
     // Clip availability flags (set by background thread, read by message thread)
     std::atomic<bool>  kickClipAvailable  { false };
@@ -126,10 +134,17 @@ public:
     int            rootChordMidi[3] { 0, 0, 0 };
     bool           rootChordValid { false };
 
-    // Recording buffer — pre-allocated in prepareToPlay()
-    // Written by audio thread ONLY during isCapturing==true.
-    // Read by background thread ONLY after isCapturing==false.
-    juce::AudioBuffer<float> recordingBuffer;
+    // MIDI clips of the last analysis, kept in memory (DSP.4). Same lifecycle as
+    // the fields above; the editor serialises one only when it is dragged out.
+    groovescout::MidiClips midiClips;
+
+    // Recording — a 16-bit view of the capture's spill file (see GrooveScoutCapture).
+    // The audio thread never writes it directly: it pushes into the capture ring
+    // and the capture writer converts into this storage, then advances recordedSamples.
+    // Readers (analyzer, live analyzer, waveform) only touch [0, recordedSamples),
+    // which is already written; preview plays from the capture's read-ahead
+    // instead (GrooveScoutCapture::readPreview). Refreshed in prepareToPlay().
+    GrooveScoutRecording recording;
 
     // Current sample rate — needed by GrooveScoutAnalyzer
     double currentSampleRate = 44100.0;
@@ -138,6 +153,10 @@ public:
     // cleared by Timer callback in the editor after sending RMS data to JS.
     std::atomic<bool>      waveformDirty { false };
 
+    // Capture path: audio thread → SPSC ring → writer thread → memory-mapped spill file.
+    // Declared after recordedSamples / waveformDirty, which it advances.
+    GrooveScoutCapture     capture { recordedSamples, waveformDirty };
+
     //==============================================================================
     // Public action methods — called from UI thread (message thread).
     //==============================================================================
@@ -146,6 +165,13 @@ public:
     void stopCurrentOperation();
     void startAnalysis();
     void cancelAnalysis();
+
+    /** Replaces the take with an audio file and analyses it as soon as it is decoded. */
+    void importFile (const juce::File& file);
+
+    /** Replaces the take with the newest numBars bars of input (see GrooveScoutHistory)
+        and analyses it. Nothing has to have been recorded. */
+    void analyzeLastBars (int numBars);
     void togglePreview (const juce::String& band);
 
     //==============================================================================
@@ -153,6 +179,16 @@ public:
     //==============================================================================
 
     float          getCaptureDurationSeconds() const;
+
+    /** Formats importFile() accepts (file chooser wildcard, drag-and-drop filter). */
+    const GrooveScoutImport& getImporter() const noexcept { return importer; }
+
+    /** Analysis threads shared by every GrooveScout instance in the process.
+        The editor reports focus to it so the visible instance is served first. */
+    juce::SharedResourcePointer<GrooveScoutWorkerPool> analysisPool;
+
+    /** Features gathered while recording — used by GrooveScoutAnalyzer. */
+    GrooveScoutLiveAnalyzer* getLiveAnalyzer() noexcept { return liveAnalyzer.get(); }
     float          getAnalysisProgress() const;
     float          getDetectedBpm() const;
     juce::String   getDetectedKey() const;
@@ -164,10 +200,12 @@ private:
 
     int    currentBlockSize    = 512;
 
-    // Preview band-pass IIR filters — audio thread only, no locking needed.
+    // Preview band-pass — audio thread only, no locking needed.
     // Applied to recorded-buffer playback so the user hears the freq-filtered band.
-    juce::IIRFilter previewHP[2];   // high-pass (L, R)
-    juce::IIRFilter previewLP[2];   // low-pass  (L, R)
+    // Section 0 is the high-pass, section 1 the low-pass; lanes 0/1 are L/R, so
+    // both channels go through one SIMD pass (pfs::dsp::filterBank).
+    pfs::dsp::BiquadBank4      previewFilter[2];
+    pfs::dsp::BiquadBank4State previewFilterState[2];
     float  previewLastFreqLow  = -1.0f;
     float  previewLastFreqHigh = -1.0f;
     int    previewLastBand     = -1;
@@ -183,16 +221,46 @@ private:
     std::atomic<float>* p_kickSensitivity  = nullptr;
     std::atomic<float>* p_snareSensitivity = nullptr;
     std::atomic<float>* p_hihatSensitivity = nullptr;
+    std::atomic<float>* p_analyzeKick      = nullptr;
+    std::atomic<float>* p_analyzeSnare     = nullptr;
+    std::atomic<float>* p_analyzeHihat     = nullptr;
+    std::atomic<float>* p_liveMidi         = nullptr;
 
     // Sensitivity gate state — audio thread only, no locking needed.
-    // Mirrors the adaptive threshold used in detectOnsetsInBand() so the user
+    // Mirrors the adaptive threshold used in onsetsFromFlux() so the user
     // hears exactly which transients would pass during analysis.
     float previewGateEnv    = 0.0f;   // envelope follower (instant attack, ~75ms release)
     float previewGatePeak   = 0.0f;   // slow-decaying peak reference for threshold
     float previewGateSmooth = 0.0f;   // smoothed gate output (avoids clicks)
 
-    // Background analysis thread
-    std::unique_ptr<GrooveScoutAnalyzer> analyzerThread;
+    static constexpr int previewGateBlock = 256;   // gain samples computed per vector multiply
+
+    void resetPreviewState() noexcept;
+
+    GrooveScoutImport importer;
+
+    // Capture rewinds. capture.reset() must not overlap a push(), so rewindCapture()
+    // raises captureHeld and waits until processBlock() has acknowledged the request
+    // at the top of a block; processBlock() doesn't push while the hold is up.
+    std::atomic<bool> captureHeld        { false };
+    std::atomic<int>  captureHoldRequest { 0 };
+    std::atomic<int>  captureHoldAck     { 0 };
+
+    /** Rewinds the capture to an empty take once no push() can be in flight. Message thread. */
+    void rewindCapture();
+
+    // Always-on ring of the last minute of input — written by the audio thread every block
+    GrooveScoutHistory history;
+
+    // Live drum → MIDI (liveMidi parameter) — audio thread only, no locking needed
+    GrooveScoutLiveDrums liveDrums;
+    bool                 liveMidiWasOn = false;
+
+    // Background analysis — a job on analysisPool
+    std::unique_ptr<GrooveScoutAnalyzer> analyzer;
+
+    // Follows the capture head while recording (incremental STFT front end: OSS, chroma, log-band spectrogram)
+    std::unique_ptr<GrooveScoutLiveAnalyzer> liveAnalyzer;
 
     // Waveform RMS data — kept private (no longer used; editor computes RMS inline)
     std::vector<float>     waveformRms;
@@ -123,9 +123,18 @@ void ScatterAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock
     dryWetMixer.prepare(spec);
     dryWetMixer.reset();
 
-    // Phase 3.3: Allocate feedback buffer (stereo)
-    feedbackBuffer.setSize(2, samplesPerBlock);
-    feedbackBuffer.clear();
+    // Phase 3.3: Allocate feedback buffer (stereo) and the window table from one arena block
+    windowTableCapacity = static_cast<int>(sampleRate * maxGrainSizeMs / 1000.0) + 1;
+
+    bufferArena.beginLayout();
+    auto feedbackRegion = bufferArena.reserve<float>(2, samplesPerBlock);
+    auto windowRegion = bufferArena.reserve<float>(1, windowTableCapacity);
+    bufferArena.commit();
+    bufferArena.attach(feedbackBuffer, feedbackRegion);
+    hannWindow = bufferArena.data<float>(windowRegion);
+    windowTableSize = 0;
+
+    DBG("Scatter: arena footprint " << (int) bufferArena.getFootprintBytes() << " bytes");
 
     // Initialize grain scheduler
     grainSpawnCounter = 0;
@@ -187,13 +196,7 @@ void ScatterAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce:
     // Phase 3.3: Step 2 - Mix feedback signal with input
     for (int channel = 0; channel < numChannels; ++channel)
     {
-        auto* channelData = buffer.getWritePointer(channel);
-        auto* feedbackData = feedbackBuffer.getReadPointer(channel);
-
-        for (int sample = 0; sample < numSamples; ++sample)
-        {
-            channelData[sample] += feedbackData[sample];
-        }
+        pfs::dsp::addWithGain(buffer.getWritePointer(channel), feedbackBuffer.getReadPointer(channel), 1.0f, numSamples);
     }
 
     // Phase 3.3: Step 3 - Write input + feedback to delay buffer (stereo)
@@ -217,13 +220,8 @@ void ScatterAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce:
     feedbackBuffer.clear();
     for (int channel = 0; channel < numChannels; ++channel)
     {
-        auto* wetData = buffer.getReadPointer(channel);
-        auto* feedbackData = feedbackBuffer.getWritePointer(channel);
-
-        for (int sample = 0; sample < numSamples; ++sample)
-        {
-            feedbackData[sample] = wetData[sample] * feedbackGain;
-        }
+        // Onto the cleared buffer, so this is wet * feedbackGain
+        pfs::dsp::addWithGain(feedbackBuffer.getWritePointer(channel), buffer.getReadPointer(channel), feedbackGain, numSamples);
     }
 
     // Phase 3.3: Step 7 - Blend with dry signal using dry/wet mixer
@@ -296,13 +294,17 @@ std::vector<ScatterAudioProcessor::GrainVisualizationData> ScatterAudioProcessor
 
 void ScatterAudioProcessor::generateHannWindow(int sizeInSamples)
 {
-    hannWindow.resize(sizeInSamples);
+    // Table is pre-sized for the largest grain in prepareToPlay (fills in place, no allocation)
+    if (hannWindow == nullptr)
+        return;
+
+    sizeInSamples = juce::jmin(sizeInSamples, windowTableCapacity);
     windowTableSize = sizeInSamples;
 
     // Generate Hann window: hann[n] = 0.5 * (1 - cos(2 * pi * n / N))
     juce::dsp::WindowingFunction<float>::fillWindowingTables(
-        hannWindow.data(),
-        sizeInSamples,
+        hannWindow,
+        static_cast<size_t>(sizeInSamples),
         juce::dsp::WindowingFunction<float>::hann,
         false  // Not normalized (we want 0-1 range)
     );
@@ -427,7 +429,7 @@ void ScatterAudioProcessor::processGrainVoices(juce::AudioBuffer<float>& buffer)
 
             // Get window envelope value (or 1.0 if table not generated yet)
             float windowValue = 1.0f;
-            if (windowIndex < static_cast<int>(hannWindow.size()))
+            if (windowIndex < windowTableSize)
             {
                 windowValue = hannWindow[windowIndex];
             }
@@ -1,6 +1,8 @@
 #pragma once
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
+#include "PfsDspKernels.h"
+#include "PfsInstanceArena.h"
 #include <array>
 #include <vector>
 
@@ -76,8 +78,11 @@ private:
     int grainSpawnCounter = 0;         // Sample counter for grain spawning
     int lastGrainSpawnInterval = 0;    // Cached spawn interval
 
-    // Window function lookup table (Hann window)
-    std::vector<float> hannWindow;
+    // Window function lookup table (Hann window), carved from bufferArena at the
+    // largest grain size so regenerating it on the audio thread never allocates
+    static constexpr float maxGrainSizeMs = 500.0f;
+    float* hannWindow = nullptr;
+    int windowTableCapacity = 0;
     int windowTableSize = 0;
 
     // Sample rate tracking
@@ -92,6 +97,9 @@ private:
     juce::dsp::DryWetMixer<float> dryWetMixer;
     juce::AudioBuffer<float> feedbackBuffer;
 
+    // One aligned block holding feedbackBuffer and the Hann window table
+    pfs::InstanceArena bufferArena;
+
     // Helper methods
     void spawnNewGrain(float grainSizeMs, float pitchRandomPercent, float panRandomPercent, int scaleIndex, int rootNote);
     void updateGrainScheduler(float densityPercent, float grainSizeMs, float pitchRandomPercent, float panRandomPercent, int scaleIndex, int rootNote);
@@ -52,7 +52,6 @@ TapeAgeAudioProcessor::TapeAgeAudioProcessor()
     : AudioProcessor(BusesProperties()
                         .withInput("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput("Output", juce::AudioChannelSet::stereo(), true))
-    , oversampler(2, 1, juce::dsp::Oversampling<float>::filterHalfBandFIREquiripple)  // 2x oversampling, 1 stage, FIR filters
     , parameters(*this, nullptr, "Parameters", createParameterLayout())
 {
 }
@@ -69,16 +68,9 @@ void TapeAgeAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock
     currentSpec.numChannels = static_cast<juce::uint32>(getTotalNumOutputChannels());
     currentSampleRate = sampleRate;
 
-    // Phase 4.1: Prepare oversampling engine
-    oversampler.initProcessing(static_cast<size_t>(samplesPerBlock));
-    oversampler.reset();
-
-    // Phase 4.2: Prepare wow/flutter modulation
-    // 200ms delay line buffer for pitch modulation (architecture.md line 28)
-    int delaySamples = static_cast<int>(sampleRate * 0.2);
-    delayLine.setMaximumDelayInSamples(delaySamples);
-    delayLine.prepare(currentSpec);
-    delayLine.reset();
+    // Both precisions are prepared so the host may pick either one
+    preparePath(floatPath, samplesPerBlock);
+    preparePath(doublePath, samplesPerBlock);
 
     // Initialize random phase offsets per channel for stereo width
     lfoPhase[0] = random.nextFloat() * juce::MathConstants<float>::twoPi;
@@ -98,41 +90,75 @@ void TapeAgeAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock
     // Initialize noise filter state to zero
     noiseFilterState[0] = 0.0f;
     noiseFilterState[1] = 0.0f;
+}
+
+template <typename SampleType>
+void TapeAgeAudioProcessor::preparePath(SamplePath<SampleType>& path, int samplesPerBlock)
+{
+    const double sampleRate = currentSpec.sampleRate;
+
+    // Phase 4.1: Prepare oversampling engine
+    path.oversampler.initProcessing(static_cast<size_t>(samplesPerBlock));
+    path.oversampler.reset();
+
+    // Phase 4.2: Prepare wow/flutter modulation
+    // 200ms delay line buffer for pitch modulation (architecture.md line 28)
+    int delaySamples = static_cast<int>(sampleRate * 0.2);
+    path.delayLine.setMaximumDelayInSamples(delaySamples);
+    path.delayLine.prepare(currentSpec);
+    path.delayLine.reset();
 
     // v1.1.0: Prepare age-dependent high-frequency rolloff filters
     for (int i = 0; i < 2; ++i)
     {
-        ageFilter[i].prepare(currentSpec);
-        ageFilter[i].reset();
+        path.ageFilter[i].prepare(currentSpec);
+        path.ageFilter[i].reset();
         // Initialize with 20kHz lowpass (transparent at age=0)
-        auto coefficients = juce::dsp::IIR::Coefficients<float>::makeFirstOrderLowPass(sampleRate, 20000.0f);
-        ageFilter[i].coefficients = coefficients;
+        auto coefficients = juce::dsp::IIR::Coefficients<SampleType>::makeFirstOrderLowPass(sampleRate, static_cast<SampleType>(20000));
+        path.ageFilter[i].coefficients = coefficients;
     }
 
     // Phase 4.4: Prepare dry/wet mixer
-    dryWetMixer.prepare(currentSpec);
-    dryWetMixer.reset();
+    path.dryWetMixer.prepare(currentSpec);
+    path.dryWetMixer.reset();
 
     // Set wet latency to compensate for oversampler + delay line latency
-    int oversamplerLatency = static_cast<int>(oversampler.getLatencyInSamples());
+    int oversamplerLatency = static_cast<int>(path.oversampler.getLatencyInSamples());
     int delayLineLatency = static_cast<int>(sampleRate * 0.1);  // 100ms base delay from wow/flutter
     int totalWetLatency = oversamplerLatency + delayLineLatency;
-    dryWetMixer.setWetLatency(static_cast<float>(totalWetLatency));
+    path.dryWetMixer.setWetLatency(static_cast<SampleType>(totalWetLatency));
 }
 
 void TapeAgeAudioProcessor::releaseResources()
 {
     // Phase 4.1: Reset DSP components
-    oversampler.reset();
+    floatPath.oversampler.reset();
+    doublePath.oversampler.reset();
 
     // Phase 4.2: Reset wow/flutter modulation
-    delayLine.reset();
+    floatPath.delayLine.reset();
+    doublePath.delayLine.reset();
 }
 
 void TapeAgeAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
     juce::ignoreUnused(midiMessages);
+    processSamples(buffer);
+}
+
+void TapeAgeAudioProcessor::processBlock(juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages)
+{
+    juce::ScopedNoDenormals noDenormals;
+    juce::ignoreUnused(midiMessages);
+    processSamples(buffer);
+}
+
+template <typename SampleType>
+void TapeAgeAudioProcessor::processSamples(juce::AudioBuffer<SampleType>& buffer)
+{
+    auto& path = getPath<SampleType>();
+    auto& dryWetMixer = path.dryWetMixer;
 
     // Clear unused channels
     for (int i = getTotalNumInputChannels(); i < getTotalNumOutputChannels(); ++i)
@@ -149,7 +175,7 @@ void TapeAgeAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce:
     }
 
     // Phase 4.4: Store dry signal AFTER input gain
-    juce::dsp::AudioBlock<float> block(buffer);
+    juce::dsp::AudioBlock<SampleType> block(buffer);
     dryWetMixer.pushDrySamples(block);
 
     // Read mix parameter (0.0 = fully dry, 1.0 = fully wet)
@@ -190,7 +216,7 @@ void TapeAgeAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce:
     }
 
     // Upsample
-    auto oversampledBlock = oversampler.processSamplesUp(block);
+    auto oversampledBlock = path.oversampler.processSamplesUp(block);
 
     // Apply tanh saturation manually in oversampled domain
     // Calculate makeup gain to compensate for volume increase (v1.1.0)
@@ -208,7 +234,7 @@ void TapeAgeAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce:
     }
 
     // Downsample back to original sample rate
-    oversampler.processSamplesDown(block);
+    path.oversampler.processSamplesDown(block);
 
     // Phase 4.2: Wow/Flutter Modulation
     // Processing chain: Apply pitch modulation via delay line after saturation
@@ -257,10 +283,10 @@ void TapeAgeAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce:
             float totalDelay = baseDelaySamples + modulationSamples;
 
             // Push input sample to delay line
-            delayLine.pushSample(channel, channelData[sample]);
+            path.delayLine.pushSample(channel, channelData[sample]);
 
             // Read modulated sample from delay line
-            channelData[sample] = delayLine.popSample(channel, totalDelay);
+            channelData[sample] = path.delayLine.popSample(channel, static_cast<SampleType>(totalDelay));
 
             // Advance LFO phases
             lfoPhase[channel] += lfoPhaseIncrement;
@@ -281,16 +307,16 @@ void TapeAgeAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce:
         float cutoffFrequency = 20000.0f * std::pow(0.4f, age);  // 0.4^1 = 0.4, so 20kHz * 0.4 = 8kHz at age=1
 
         // Update filter coefficients if cutoff changed significantly
-        auto coefficients = juce::dsp::IIR::Coefficients<float>::makeFirstOrderLowPass(currentSampleRate, cutoffFrequency);
+        auto coefficients = juce::dsp::IIR::Coefficients<SampleType>::makeFirstOrderLowPass(currentSampleRate, static_cast<SampleType>(cutoffFrequency));
 
         for (int channel = 0; channel < numChannels; ++channel)
         {
-            ageFilter[channel].coefficients = coefficients;
+            path.ageFilter[channel].coefficients = coefficients;
             auto* channelData = buffer.getWritePointer(channel);
 
             for (int sample = 0; sample < numSamples; ++sample)
             {
-                channelData[sample] = ageFilter[channel].processSample(channelData[sample]);
+                channelData[sample] = path.ageFilter[channel].processSample(channelData[sample]);
             }
         }
     }
@@ -434,7 +460,7 @@ void TapeAgeAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce:
     float peakLevel = 0.0f;
     for (int channel = 0; channel < numChannels; ++channel)
     {
-        float channelPeak = buffer.getMagnitude(channel, 0, numSamples);
+        float channelPeak = static_cast<float>(buffer.getMagnitude(channel, 0, numSamples));
         peakLevel = std::max(peakLevel, channelPeak);
     }
 
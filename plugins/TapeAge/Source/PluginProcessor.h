@@ -11,6 +11,8 @@ public:
     void prepareToPlay(double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock(juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override { return true; }
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -37,14 +39,46 @@ public:
     std::atomic<float> outputLevel { -100.0f };  // Peak level in dB (initialized to silence)
 
 private:
+    // Shared float/double processing path (64-bit hosts call the double overload)
+    template <typename SampleType>
+    void processSamples(juce::AudioBuffer<SampleType>& buffer);
+
+    // Sample-carrying DSP, one instance per processing precision.
+    // LFO, dropout and noise state below is precision-independent and shared.
+    template <typename SampleType>
+    struct SamplePath
+    {
+        // Phase 4.1: Core Saturation Processing (2x oversampling, 1 stage, FIR filters)
+        juce::dsp::Oversampling<SampleType> oversampler { 2, 1, juce::dsp::Oversampling<SampleType>::filterHalfBandFIREquiripple };
+
+        // Phase 4.2: Wow/Flutter Modulation
+        juce::dsp::DelayLine<SampleType, juce::dsp::DelayLineInterpolationTypes::Lagrange3rd> delayLine;
+
+        // v1.1.0: High-frequency rolloff per channel
+        juce::dsp::IIR::Filter<SampleType> ageFilter[2];
+
+        // Phase 4.4: Dry/Wet Mixing
+        juce::dsp::DryWetMixer<SampleType> dryWetMixer { 20000 };  // Max latency: 192kHz * 0.1s delay line + oversampler
+    };
+
+    template <typename SampleType>
+    void preparePath(SamplePath<SampleType>& path, int samplesPerBlock);
+
+    template <typename SampleType>
+    SamplePath<SampleType>& getPath()
+    {
+        if constexpr (std::is_same_v<SampleType, double>)
+            return doublePath;
+        else
+            return floatPath;
+    }
+
     // DSP Components (declared BEFORE parameters for initialization order)
     juce::dsp::ProcessSpec currentSpec;
-
-    // Phase 4.1: Core Saturation Processing
-    juce::dsp::Oversampling<float> oversampler { 2, 1, juce::dsp::Oversampling<float>::filterHalfBandFIREquiripple };
+    SamplePath<float> floatPath;
+    SamplePath<double> doublePath;
 
     // Phase 4.2: Wow/Flutter Modulation
-    juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::Lagrange3rd> delayLine;
     float lfoPhase[2] { 0.0f, 0.0f };  // Separate phase per channel for stereo width
     float flutterPhase[2] { 0.0f, 0.0f };  // Secondary flutter LFO phase per channel (v1.1.0)
     juce::Random random;
@@ -56,10 +90,6 @@ private:
     int dropoutSamplesRemaining { 0 };  // Current dropout duration
     float dropoutEnvelope { 1.0f };  // Smooth attack/release (1.0 = no attenuation)
     float noiseFilterState[2] { 0.0f, 0.0f };  // One-pole lowpass filter state per channel
-    juce::dsp::IIR::Filter<float> ageFilter[2];  // High-frequency rolloff per channel (v1.1.0)
-
-    // Phase 4.4: Dry/Wet Mixing
-    juce::dsp::DryWetMixer<float> dryWetMixer { 20000 };  // Max latency: 192kHz * 0.1s delay line + oversampler
 
     // Parameter layout creation
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
@@ -0,0 +1,350 @@
+//==============================================================================
+// PfsDspKernels.cpp
+//
+// CPU feature detection, ISA selection and the portable scalar kernels.
+// The SSE2 / AVX2 / AVX-512 tables live in PfsDspKernelsX86.cpp.
+//==============================================================================
+
+#include "PfsDspKernelsInternal.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+#if PFS_DSP_X86
+ #if defined(_MSC_VER)
+  #include <intrin.h>
+ #else
+  #include <cpuid.h>
+ #endif
+#endif
+
+namespace pfs::dsp
+{
+    //==========================================================================
+    // Scalar kernels — the reference implementation every wide path must match
+    //==========================================================================
+
+    namespace scalar
+    {
+        void mixToMono (float* dst, const float* left, const float* right, int numSamples)
+        {
+            for (int i = 0; i < numSamples; ++i)
+                dst[i] = (left[i] + right[i]) * 0.5f;
+        }
+
+        void addWithGain (float* dst, const float* src, float gain, int numSamples)
+        {
+            for (int i = 0; i < numSamples; ++i)
+                dst[i] += src[i] * gain;
+        }
+
+        void multiplyByGain (float* data, float gain, int numSamples)
+        {
+            for (int i = 0; i < numSamples; ++i)
+                data[i] *= gain;
+        }
+
+        void floatToInt16 (std::int16_t* dst, const float* src, float scale, int numSamples)
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                // Clamp before converting; lrint rounds to nearest-even like the SIMD paths
+                const float x = std::clamp (src[i] * scale, -32768.0f, 32767.0f);
+                dst[i] = static_cast<std::int16_t> (std::lrint (x));
+            }
+        }
+
+        void int16ToFloat (float* dst, const std::int16_t* src, float scale, int numSamples)
+        {
+            for (int i = 0; i < numSamples; ++i)
+                dst[i] = static_cast<float> (src[i]) * scale;
+        }
+
+        void mixInt16ToMono (float* dst, const std::int16_t* left, const std::int16_t* right,
+                             float scale, int numSamples)
+        {
+            const float halfScale = scale * 0.5f;
+
+            for (int i = 0; i < numSamples; ++i)
+                dst[i] = static_cast<float> (left[i] + right[i]) * halfScale;
+        }
+
+        float peakAbs (const float* src, int numSamples)
+        {
+            float peak = 0.0f;
+            for (int i = 0; i < numSamples; ++i)
+                peak = std::max (peak, std::abs (src[i]));
+            return peak;
+        }
+
+        void magnitudes (float* dst, const float* interleavedComplex, int numBins)
+        {
+            for (int k = 0; k < numBins; ++k)
+            {
+                const float re = interleavedComplex[2 * k];
+                const float im = interleavedComplex[2 * k + 1];
+                dst[k] = std::sqrt (re * re + im * im);
+            }
+        }
+
+        void filterBankEnergy (const float* src, int numSamples, const BiquadBank4* sections,
+                               BiquadBank4State* states, int numSections, float* sumsOfSquares)
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                for (int lane = 0; lane < 4; ++lane)
+                {
+                    float x = src[i];
+
+                    for (int k = 0; k < numSections; ++k)
+                    {
+                        const BiquadBank4& c = sections[k];
+                        BiquadBank4State&  s = states[k];
+
+                        const float y = c.b0[lane] * x + s.s1[lane];
+                        s.s1[lane] = c.b1[lane] * x - c.a1[lane] * y + s.s2[lane];
+                        s.s2[lane] = c.b2[lane] * x - c.a2[lane] * y;
+                        x = y;
+                    }
+
+                    sumsOfSquares[lane] += x * x;
+                }
+            }
+        }
+
+        void filterBank (float* const* channels, int numChannels, int numSamples,
+                         const BiquadBank4* sections, BiquadBank4State* states, int numSections)
+        {
+            numChannels = std::min (numChannels, 4);
+
+            for (int lane = 0; lane < numChannels; ++lane)
+            {
+                float* data = channels[lane];
+
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    float x = data[i];
+
+                    for (int k = 0; k < numSections; ++k)
+                    {
+                        const BiquadBank4& c = sections[k];
+                        BiquadBank4State&  s = states[k];
+
+                        const float y = c.b0[lane] * x + s.s1[lane];
+                        s.s1[lane] = c.b1[lane] * x - c.a1[lane] * y + s.s2[lane];
+                        s.s2[lane] = c.b2[lane] * x - c.a2[lane] * y;
+                        x = y;
+                    }
+
+                    data[i] = x;
+                }
+            }
+        }
+
+        void linearInterpolate (float* dst, const float* src, int srcLength,
+                                double startPosition, double increment, int numSamples)
+        {
+            if (srcLength <= 0)
+            {
+                std::memset (dst, 0, sizeof (float) * static_cast<size_t> (std::max (0, numSamples)));
+                return;
+            }
+
+            const double lastIndex = static_cast<double> (srcLength - 1);
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const double pos   = std::clamp (startPosition + static_cast<double> (i) * increment, 0.0, lastIndex);
+                const int    index = static_cast<int> (pos);
+                const int    next  = std::min (index + 1, srcLength - 1);
+                const float  frac  = static_cast<float> (pos - static_cast<double> (index));
+
+                dst[i] = src[index] + (src[next] - src[index]) * frac;
+            }
+        }
+    }
+
+    const KernelTable& scalarKernels() noexcept
+    {
+        static const KernelTable table {
+            scalar::mixToMono,
+            scalar::addWithGain,
+            scalar::multiplyByGain,
+            scalar::floatToInt16,
+            scalar::int16ToFloat,
+            scalar::mixInt16ToMono,
+            scalar::peakAbs,
+            scalar::magnitudes,
+            scalar::filterBankEnergy,
+            scalar::filterBank,
+            scalar::linearInterpolate
+        };
+        return table;
+    }
+
+    const KernelTable& tableFor (Isa isa) noexcept
+    {
+        switch (isa)
+        {
+           #if PFS_DSP_X86
+            case Isa::sse2:   return sse2Kernels();
+            case Isa::avx2:   return avx2Kernels();
+            case Isa::avx512: return avx512Kernels();
+           #endif
+            default:          return scalarKernels();
+        }
+    }
+
+    //==========================================================================
+    // CPU feature detection
+    //==========================================================================
+
+    namespace
+    {
+       #if PFS_DSP_X86
+        void cpuid (unsigned int leaf, unsigned int subleaf, unsigned int regs[4]) noexcept
+        {
+           #if defined(_MSC_VER)
+            int r[4];
+            __cpuidex (r, static_cast<int> (leaf), static_cast<int> (subleaf));
+            for (int i = 0; i < 4; ++i)
+                regs[i] = static_cast<unsigned int> (r[i]);
+           #else
+            __cpuid_count (leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+           #endif
+        }
+
+        /** XCR0 — which register files the OS saves on context switch. */
+        unsigned long long readXcr0() noexcept
+        {
+           #if defined(_MSC_VER)
+            return _xgetbv (0);
+           #else
+            unsigned int eax = 0, edx = 0;
+            __asm__ volatile ("xgetbv" : "=a" (eax), "=d" (edx) : "c" (0));
+            return (static_cast<unsigned long long> (edx) << 32) | eax;
+           #endif
+        }
+
+        Isa queryCpu() noexcept
+        {
+            unsigned int regs[4] = {};   // eax, ebx, ecx, edx
+
+            cpuid (0, 0, regs);
+            const unsigned int maxLeaf = regs[0];
+
+            cpuid (1, 0, regs);
+            const bool hasSse2    = (regs[3] & (1u << 26)) != 0;
+            const bool hasFma     = (regs[2] & (1u << 12)) != 0;
+            const bool hasOsxsave = (regs[2] & (1u << 27)) != 0;
+            const bool hasAvx     = (regs[2] & (1u << 28)) != 0;
+
+            if (! hasSse2)
+                return Isa::scalar;
+
+            // AVX state (XMM + YMM) must be enabled by the OS, not just present in silicon
+            const unsigned long long xcr0 = hasOsxsave ? readXcr0() : 0;
+            const bool osSavesYmm  = (xcr0 & 0x06) == 0x06;
+            const bool osSavesZmm  = (xcr0 & 0xe6) == 0xe6;   // + opmask, ZMM0-15 upper, ZMM16-31
+
+            if (maxLeaf < 7 || ! (hasAvx && hasFma && osSavesYmm))
+                return Isa::sse2;
+
+            cpuid (7, 0, regs);
+            const bool hasAvx2    = (regs[1] & (1u << 5))  != 0;
+            const bool hasAvx512f = (regs[1] & (1u << 16)) != 0;
+
+            if (! hasAvx2)
+                return Isa::sse2;
+
+            return (hasAvx512f && osSavesZmm) ? Isa::avx512 : Isa::avx2;
+        }
+       #else
+        Isa queryCpu() noexcept
+        {
+            return Isa::scalar;
+        }
+       #endif
+
+        bool parseIsa (const char* name, Isa& isa) noexcept
+        {
+            for (auto candidate : { Isa::scalar, Isa::sse2, Isa::avx2, Isa::avx512 })
+            {
+                if (std::strcmp (name, isaName (candidate)) == 0)
+                {
+                    isa = candidate;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        std::atomic<const KernelTable*> activeTable { nullptr };
+        std::atomic<Isa>                activeIsaValue { Isa::scalar };
+
+        const KernelTable& selectTable (Isa requested) noexcept
+        {
+            const Isa isa = std::min (requested, detectIsa());
+            const KernelTable& table = tableFor (isa);
+
+            activeIsaValue.store (isa, std::memory_order_relaxed);
+            activeTable.store (&table, std::memory_order_release);
+            return table;
+        }
+
+        const KernelTable& initialiseFromEnvironment() noexcept
+        {
+            Isa isa = detectIsa();
+
+            if (const char* forced = std::getenv ("PFS_DSP_ISA"))
+                parseIsa (forced, isa);
+
+            return selectTable (isa);
+        }
+    }
+
+    //==========================================================================
+    // Public API
+    //==========================================================================
+
+    Isa detectIsa() noexcept
+    {
+        static const Isa detected = queryCpu();
+        return detected;
+    }
+
+    Isa activeIsa() noexcept
+    {
+        kernels();   // make sure the environment override has been applied
+        return activeIsaValue.load (std::memory_order_relaxed);
+    }
+
+    Isa forceIsa (Isa requested) noexcept
+    {
+        selectTable (requested);
+        return activeIsaValue.load (std::memory_order_relaxed);
+    }
+
+    const char* isaName (Isa isa) noexcept
+    {
+        switch (isa)
+        {
+            case Isa::sse2:   return "sse2";
+            case Isa::avx2:   return "avx2";
+            case Isa::avx512: return "avx512";
+            default:          return "scalar";
+        }
+    }
+
+    const KernelTable& kernels() noexcept
+    {
+        if (const KernelTable* table = activeTable.load (std::memory_order_acquire))
+            return *table;
+
+        // First use — selection is idempotent, so racing initialisers are harmless
+        return initialiseFromEnvironment();
+    }
+}
@@ -0,0 +1,206 @@
+#pragma once
+
+//==============================================================================
+/**
+ * PfsDspKernels — hot-loop kernels shared by the plugins, with runtime ISA dispatch
+ *
+ * Every kernel has a portable scalar implementation plus SSE2, AVX2 (+FMA) and
+ * AVX-512F variants on x86. The best variant the CPU (and OS) supports is
+ * picked once, on first use, via cpuid/xgetbv — so a single build runs on
+ * older studio machines and still gets the wide paths on new ones.
+ *
+ * On non-x86 targets (Apple Silicon) only the scalar table exists; the compiler
+ * auto-vectorises it to NEON.
+ *
+ * Forcing a path (benchmarks, golden renders, bug reports):
+ *   - environment:  PFS_DSP_ISA=scalar|sse2|avx2|avx512   (read on first use)
+ *   - code:         pfs::dsp::forceIsa (pfs::dsp::Isa::sse2)
+ * A forced ISA the machine can't run is clamped down to the best supported one.
+ * checkAgainstScalar() verifies a path against the scalar kernels;
+ * GrooveScoutBench runs it for every ISA the host supports (--check-kernels).
+ *
+ * Kernels are plain C++ (no JUCE) so tools and the analysis core can use them.
+ * They never allocate and are safe on the audio thread. Wide variants sum in a
+ * different order than the scalar loop, so reductions may differ in the last
+ * few ulps between ISAs.
+ */
+#include <cstdint>
+
+namespace pfs::dsp
+{
+    enum class Isa
+    {
+        scalar = 0,
+        sse2,
+        avx2,
+        avx512
+    };
+
+    /** Best ISA this CPU and OS support (cached after the first call). */
+    Isa detectIsa() noexcept;
+
+    /** ISA whose kernels are currently dispatched to. */
+    Isa activeIsa() noexcept;
+
+    /** Switches every kernel to the given ISA, clamped to what detectIsa() allows.
+        Returns the ISA actually selected. Not meant to be called while audio is running. */
+    Isa forceIsa (Isa requested) noexcept;
+
+    /** "scalar", "sse2", "avx2" or "avx512". */
+    const char* isaName (Isa isa) noexcept;
+
+    /** Runs every kernel of one ISA against the scalar reference on fixed
+        pseudo-random input, with unaligned pointers and lengths that leave a
+        vector tail. Returns the name of the first kernel outside its tolerance,
+        or nullptr if all agree. isa must not be above detectIsa(). Allocates. */
+    const char* checkAgainstScalar (Isa isa);
+
+    //==========================================================================
+    /** Normalised biquad (a0 == 1), transposed direct form II. */
+    struct BiquadCoeffs
+    {
+        float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f;
+        float a1 = 0.0f, a2 = 0.0f;
+    };
+
+    /** One biquad section for four independent filter lanes, stored lane-wise
+        so a single SSE register holds the same coefficient for every lane. */
+    struct BiquadBank4
+    {
+        float b0[4] { 1.0f, 1.0f, 1.0f, 1.0f };
+        float b1[4] {}, b2[4] {};
+        float a1[4] {}, a2[4] {};
+
+        /** Puts coeffs into one lane, leaving the others untouched. */
+        void setLane (int lane, const BiquadCoeffs& c) noexcept
+        {
+            b0[lane] = c.b0;  b1[lane] = c.b1;  b2[lane] = c.b2;
+            a1[lane] = c.a1;  a2[lane] = c.a2;
+        }
+    };
+
+    struct BiquadBank4State
+    {
+        float s1[4] {}, s2[4] {};
+    };
+
+    /** Longest cascade filterBankEnergy() and filterBank() accept. */
+    constexpr int maxBankSections = 4;
+
+    //==========================================================================
+    /** One function table per ISA. Use the free functions below rather than this directly. */
+    struct KernelTable
+    {
+        // Mixing
+        void  (*mixToMono)         (float* dst, const float* left, const float* right, int numSamples);
+        void  (*addWithGain)       (float* dst, const float* src, float gain, int numSamples);
+        void  (*multiplyByGain)    (float* data, float gain, int numSamples);
+
+        // Sample conversion
+        void  (*floatToInt16)      (std::int16_t* dst, const float* src, float scale, int numSamples);
+        void  (*int16ToFloat)      (float* dst, const std::int16_t* src, float scale, int numSamples);
+        void  (*mixInt16ToMono)    (float* dst, const std::int16_t* left, const std::int16_t* right,
+                                    float scale, int numSamples);
+
+        // Math / reductions
+        float (*peakAbs)           (const float* src, int numSamples);
+        void  (*magnitudes)        (float* dst, const float* interleavedComplex, int numBins);
+
+        // Filtering
+        void  (*filterBankEnergy)  (const float* src, int numSamples, const BiquadBank4* sections,
+                                    BiquadBank4State* states, int numSections, float* sumsOfSquares);
+        void  (*filterBank)        (float* const* channels, int numChannels, int numSamples,
+                                    const BiquadBank4* sections, BiquadBank4State* states, int numSections);
+
+        // Interpolation
+        void  (*linearInterpolate) (float* dst, const float* src, int srcLength,
+                                    double startPosition, double increment, int numSamples);
+    };
+
+    /** Table for the active ISA. */
+    const KernelTable& kernels() noexcept;
+
+    //==========================================================================
+    /** dst[i] = (left[i] + right[i]) * 0.5 */
+    inline void mixToMono (float* dst, const float* left, const float* right, int numSamples) noexcept
+    {
+        kernels().mixToMono (dst, left, right, numSamples);
+    }
+
+    /** dst[i] += src[i] * gain */
+    inline void addWithGain (float* dst, const float* src, float gain, int numSamples) noexcept
+    {
+        kernels().addWithGain (dst, src, gain, numSamples);
+    }
+
+    /** data[i] *= gain */
+    inline void multiplyByGain (float* data, float gain, int numSamples) noexcept
+    {
+        kernels().multiplyByGain (data, gain, numSamples);
+    }
+
+    /** dst[i] = src[i] * scale, rounded to nearest and saturated to the int16 range. */
+    inline void floatToInt16 (std::int16_t* dst, const float* src, float scale, int numSamples) noexcept
+    {
+        kernels().floatToInt16 (dst, src, scale, numSamples);
+    }
+
+    /** dst[i] = src[i] * scale */
+    inline void int16ToFloat (float* dst, const std::int16_t* src, float scale, int numSamples) noexcept
+    {
+        kernels().int16ToFloat (dst, src, scale, numSamples);
+    }
+
+    /** dst[i] = (left[i] + right[i]) * 0.5 * scale — mixToMono() straight from 16-bit storage. */
+    inline void mixInt16ToMono (float* dst, const std::int16_t* left, const std::int16_t* right,
+                                float scale, int numSamples) noexcept
+    {
+        kernels().mixInt16ToMono (dst, left, right, scale, numSamples);
+    }
+
+    /** max |src[i]| (0 for an empty range) */
+    inline float peakAbs (const float* src, int numSamples) noexcept
+    {
+        return kernels().peakAbs (src, numSamples);
+    }
+
+    /** dst[k] = |re_k + j·im_k| for an interleaved [re0, im0, re1, im1, ...] spectrum. */
+    inline void magnitudes (float* dst, const float* interleavedComplex, int numBins) noexcept
+    {
+        kernels().magnitudes (dst, interleavedComplex, numBins);
+    }
+
+    /**
+     * Runs src through four independent biquad cascades at once (one per lane,
+     * numSections deep, at most maxBankSections) and adds each lane's Σ y² to
+     * sumsOfSquares[lane]. The filtered signal itself is never stored. That
+     * makes a multiband energy analysis one pass over the input instead of
+     * one copy and two sweeps per band.
+     */
+    inline void filterBankEnergy (const float* src, int numSamples, const BiquadBank4* sections,
+                                  BiquadBank4State* states, int numSections, float* sumsOfSquares) noexcept
+    {
+        kernels().filterBankEnergy (src, numSamples, sections, states, numSections, sumsOfSquares);
+    }
+
+    /**
+     * Filters up to four channels in place, channel c through lane c's biquad
+     * cascade (numSections deep, at most maxBankSections). Every channel
+     * advances in the same register, so a stereo HP + LP costs about the same
+     * as one channel through the scalar biquad(). Lanes past numChannels
+     * compute on zeros and their state is left alone.
+     */
+    inline void filterBank (float* const* channels, int numChannels, int numSamples,
+                            const BiquadBank4* sections, BiquadBank4State* states, int numSections) noexcept
+    {
+        kernels().filterBank (channels, numChannels, numSamples, sections, states, numSections);
+    }
+
+    /** dst[i] = src at fractional position (startPosition + i * increment), linearly interpolated.
+        Positions outside [0, srcLength - 1] read as the nearest edge sample. */
+    inline void linearInterpolate (float* dst, const float* src, int srcLength,
+                                   double startPosition, double increment, int numSamples) noexcept
+    {
+        kernels().linearInterpolate (dst, src, srcLength, startPosition, increment, numSamples);
+    }
+}
@@ -0,0 +1,327 @@
+//==============================================================================
+// PfsDspKernelsCheck.cpp
+//
+// Compares one ISA's kernel table with the scalar reference.
+//==============================================================================
+
+#include "PfsDspKernelsInternal.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace pfs::dsp
+{
+    namespace
+    {
+        /** Deterministic noise in [-1, 1) — the check must give the same verdict every run. */
+        struct Noise
+        {
+            std::uint32_t state = 0x9e3779b9u;
+
+            float next() noexcept
+            {
+                state ^= state << 13;
+                state ^= state >> 17;
+                state ^= state << 5;
+                return static_cast<float> (state >> 8) / 8388608.0f - 1.0f;
+            }
+        };
+
+        /** Lengths below, at and past every vector width, with a tail left over. */
+        constexpr int testLengths[] = { 0, 1, 3, 7, 8, 15, 16, 17, 31, 33, 64, 1003 };
+        constexpr int maxLength     = 1003;
+
+        // Source pointers start one float in, so no load is ever aligned by luck
+        constexpr int misalign = 1;
+
+        bool nearlyEqual (float a, float b, float tolerance) noexcept
+        {
+            return std::abs (a - b) <= tolerance * std::max (1.0f, std::max (std::abs (a), std::abs (b)));
+        }
+
+        bool allNearlyEqual (const float* a, const float* b, int n, float tolerance) noexcept
+        {
+            for (int i = 0; i < n; ++i)
+                if (! nearlyEqual (a[i], b[i], tolerance))
+                    return false;
+
+            return true;
+        }
+
+        /** RBJ cookbook low- or high-pass, Q = 1/sqrt(2), normalised by a0. */
+        BiquadCoeffs makeButterworth (double normalisedFrequency, bool highPass) noexcept
+        {
+            const double w     = 2.0 * 3.14159265358979323846 * normalisedFrequency;
+            const double alpha = std::sin (w) / std::sqrt (2.0);
+            const double cosW  = std::cos (w);
+            const double a0    = 1.0 + alpha;
+            const double b1    = highPass ? -(1.0 + cosW) : 1.0 - cosW;
+            const double b0    = highPass ? (1.0 + cosW) * 0.5 : (1.0 - cosW) * 0.5;
+
+            BiquadCoeffs c;
+            c.b0 = static_cast<float> (b0 / a0);
+            c.b1 = static_cast<float> (b1 / a0);
+            c.b2 = static_cast<float> (b0 / a0);
+            c.a1 = static_cast<float> (-2.0 * cosW / a0);
+            c.a2 = static_cast<float> ((1.0 - alpha) / a0);
+            return c;
+        }
+
+        /** HP then LP per lane, four different bands — the shape every caller uses. */
+        void makeBank (BiquadBank4 (&sections)[2]) noexcept
+        {
+            const double bands[4][2] = { { 0.001, 0.003 }, { 0.005, 0.17 }, { 0.1, 0.33 }, { 0.02, 0.04 } };
+
+            for (int lane = 0; lane < 4; ++lane)
+            {
+                sections[0].setLane (lane, makeButterworth (bands[lane][0], true));
+                sections[1].setLane (lane, makeButterworth (bands[lane][1], false));
+            }
+        }
+
+        const char* checkMixing (const KernelTable& wide, const KernelTable& ref, Noise& noise)
+        {
+            std::vector<float> left (maxLength + misalign), right (maxLength + misalign);
+            std::vector<float> expected (maxLength + misalign), actual (maxLength + misalign);
+
+            for (auto* v : { &left, &right })
+                for (auto& x : *v)
+                    x = noise.next();
+
+            for (int n : testLengths)
+            {
+                ref.mixToMono  (expected.data() + misalign, left.data() + misalign, right.data() + misalign, n);
+                wide.mixToMono (actual.data()   + misalign, left.data() + misalign, right.data() + misalign, n);
+
+                if (! allNearlyEqual (expected.data() + misalign, actual.data() + misalign, n, 0.0f))
+                    return "mixToMono";
+
+                ref.multiplyByGain  (expected.data() + misalign, 0.7f, n);
+                wide.multiplyByGain (actual.data()   + misalign, 0.7f, n);
+
+                if (! allNearlyEqual (expected.data() + misalign, actual.data() + misalign, n, 0.0f))
+                    return "multiplyByGain";
+
+                ref.addWithGain  (expected.data() + misalign, left.data() + misalign, -1.3f, n);
+                wide.addWithGain (actual.data()   + misalign, left.data() + misalign, -1.3f, n);
+
+                // FMA rounds the multiply-add once instead of twice
+                if (! allNearlyEqual (expected.data() + misalign, actual.data() + misalign, n, 1.0e-6f))
+                    return "addWithGain";
+            }
+
+            return nullptr;
+        }
+
+        const char* checkConversions (const KernelTable& wide, const KernelTable& ref, Noise& noise)
+        {
+            // Past full scale both ways, to exercise saturation, plus exact halves for rounding
+            std::vector<float> floats (maxLength + misalign);
+
+            for (size_t i = 0; i < floats.size(); ++i)
+                floats[i] = (i % 5 == 0) ? static_cast<float> (static_cast<int> (i) - 500) + 0.5f
+                                         : noise.next() * 1.5f;
+
+            std::vector<std::int16_t> expected16 (maxLength + misalign), actual16 (maxLength + misalign);
+            const float toInt16 = 32768.0f;
+
+            for (int n : testLengths)
+            {
+                ref.floatToInt16  (expected16.data() + misalign, floats.data() + misalign, toInt16, n);
+                wide.floatToInt16 (actual16.data()   + misalign, floats.data() + misalign, toInt16, n);
+
+                if (! std::equal (expected16.begin() + misalign, expected16.begin() + misalign + n, actual16.begin() + misalign))
+                    return "floatToInt16";
+            }
+
+            std::vector<std::int16_t> left (maxLength + misalign), right (maxLength + misalign);
+
+            for (size_t i = 0; i < left.size(); ++i)
+            {
+                left[i]  = static_cast<std::int16_t> (noise.next() * 32767.0f);
+                right[i] = static_cast<std::int16_t> (i % 7 == 0 ? -32768 : static_cast<int> (noise.next() * 32767.0f));
+            }
+
+            std::vector<float> expected (maxLength + misalign), actual (maxLength + misalign);
+            const float fromInt16 = 1.0f / 32768.0f;
+
+            for (int n : testLengths)
+            {
+                ref.int16ToFloat  (expected.data() + misalign, left.data() + misalign, fromInt16, n);
+                wide.int16ToFloat (actual.data()   + misalign, left.data() + misalign, fromInt16, n);
+
+                if (! allNearlyEqual (expected.data() + misalign, actual.data() + misalign, n, 0.0f))
+                    return "int16ToFloat";
+
+                ref.mixInt16ToMono  (expected.data() + misalign, left.data() + misalign, right.data() + misalign, fromInt16, n);
+                wide.mixInt16ToMono (actual.data()   + misalign, left.data() + misalign, right.data() + misalign, fromInt16, n);
+
+                if (! allNearlyEqual (expected.data() + misalign, actual.data() + misalign, n, 0.0f))
+                    return "mixInt16ToMono";
+            }
+
+            return nullptr;
+        }
+
+        const char* checkMath (const KernelTable& wide, const KernelTable& ref, Noise& noise)
+        {
+            std::vector<float> src (2 * maxLength + misalign);
+
+            for (auto& x : src)
+                x = noise.next() * 4.0f;
+
+            for (int n : testLengths)
+            {
+                // The peak lands in the tail as well as in the vector body
+                src[static_cast<size_t> (misalign + std::max (0, n - 1))] = -7.5f;
+
+                if (ref.peakAbs (src.data() + misalign, n) != wide.peakAbs (src.data() + misalign, n))
+                    return "peakAbs";
+            }
+
+            std::vector<float> expected (maxLength + misalign), actual (maxLength + misalign);
+
+            for (int n : testLengths)
+            {
+                ref.magnitudes  (expected.data() + misalign, src.data() + misalign, n);
+                wide.magnitudes (actual.data()   + misalign, src.data() + misalign, n);
+
+                // FMA contraction may change the last bit of re² + im²
+                if (! allNearlyEqual (expected.data() + misalign, actual.data() + misalign, n, 1.0e-6f))
+                    return "magnitudes";
+            }
+
+            return nullptr;
+        }
+
+        const char* checkFilters (const KernelTable& wide, const KernelTable& ref, Noise& noise)
+        {
+            BiquadBank4 sections[2];
+            makeBank (sections);
+
+            std::vector<float> src (maxLength + misalign);
+
+            for (auto& x : src)
+                x = noise.next();
+
+            // FMA rounding feeds back through the recursion. Near DC (lane 0, like a
+            // kick band at 48 kHz) the poles sit close to 1 and magnify it to about
+            // 1e-3 after a thousand samples. A wrong lane or coefficient is far off.
+            constexpr float tolerance = 5.0e-3f;
+
+            {
+                BiquadBank4State expectedStates[2], actualStates[2];
+                float expected[4] {}, actual[4] {};
+
+                // Calls back to back carry state, like hops of a stream
+                for (int n : testLengths)
+                {
+                    ref.filterBankEnergy  (src.data() + misalign, n, sections, expectedStates, 2, expected);
+                    wide.filterBankEnergy (src.data() + misalign, n, sections, actualStates,   2, actual);
+                }
+
+                if (! allNearlyEqual (expected, actual, 4, tolerance))
+                    return "filterBankEnergy";
+
+                for (int k = 0; k < 2; ++k)
+                    if (! allNearlyEqual (expectedStates[k].s1, actualStates[k].s1, 4, tolerance)
+                        || ! allNearlyEqual (expectedStates[k].s2, actualStates[k].s2, 4, tolerance))
+                        return "filterBankEnergy";
+            }
+
+            for (int numChannels = 1; numChannels <= 4; ++numChannels)
+            {
+                std::vector<float> expected[4], actual[4];
+                float* expectedPointers[4] {};
+                float* actualPointers[4] {};
+
+                for (int c = 0; c < numChannels; ++c)
+                {
+                    expected[c].resize (maxLength + misalign);
+                    expectedPointers[c] = expected[c].data() + misalign;
+                    actualPointers[c]   = nullptr;
+                }
+
+                BiquadBank4State expectedStates[2], actualStates[2];
+
+                for (int n : testLengths)
+                {
+                    for (int c = 0; c < numChannels; ++c)
+                    {
+                        // A different signal per channel: a lane mix-up must show
+                        for (int i = 0; i < n; ++i)
+                            expectedPointers[c][i] = src[static_cast<size_t> (misalign + (i * (c + 1)) % maxLength)];
+
+                        actual[c].assign (expected[c].begin(), expected[c].end());
+                        actualPointers[c] = actual[c].data() + misalign;
+                    }
+
+                    ref.filterBank  (expectedPointers, numChannels, n, sections, expectedStates, 2);
+                    wide.filterBank (actualPointers,   numChannels, n, sections, actualStates,   2);
+
+                    for (int c = 0; c < numChannels; ++c)
+                        if (! allNearlyEqual (expectedPointers[c], actualPointers[c], n, tolerance))
+                            return "filterBank";
+                }
+            }
+
+            return nullptr;
+        }
+
+        const char* checkInterpolation (const KernelTable& wide, const KernelTable& ref, Noise& noise)
+        {
+            std::vector<float> src (maxLength + misalign);
+
+            for (auto& x : src)
+                x = noise.next();
+
+            std::vector<float> expected (maxLength), actual (maxLength);
+
+            // Faster up, down, and slower than the source, each starting or running off an edge
+            const double reads[][2] = { { -2.25, 1.37 }, { 1002.5, -0.61 }, { 0.125, 0.5 } };
+
+            for (const auto& read : reads)
+            {
+                for (int n : testLengths)
+                {
+                    ref.linearInterpolate  (expected.data(), src.data() + misalign, maxLength, read[0], read[1], n);
+                    wide.linearInterpolate (actual.data(),   src.data() + misalign, maxLength, read[0], read[1], n);
+
+                    // FMA again, on the final lerp
+                    if (! allNearlyEqual (expected.data(), actual.data(), n, 1.0e-6f))
+                        return "linearInterpolate";
+                }
+            }
+
+            return nullptr;
+        }
+    }
+
+    //==========================================================================
+
+    const char* checkAgainstScalar (Isa isa)
+    {
+        if (isa == Isa::scalar || isa > detectIsa())
+            return nullptr;
+
+        const KernelTable& ref  = scalarKernels();
+        const KernelTable& wide = tableFor (isa);
+        Noise noise;
+
+        if (const char* failed = checkMixing (wide, ref, noise))
+            return failed;
+
+        if (const char* failed = checkConversions (wide, ref, noise))
+            return failed;
+
+        if (const char* failed = checkMath (wide, ref, noise))
+            return failed;
+
+        if (const char* failed = checkFilters (wide, ref, noise))
+            return failed;
+
+        return checkInterpolation (wide, ref, noise);
+    }
+}
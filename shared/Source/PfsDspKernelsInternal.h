@@ -0,0 +1,47 @@
+#pragma once
+
+#include "PfsDspKernels.h"
+
+//==============================================================================
+// Private to the pfs_dsp library — per-ISA kernel tables and the scalar
+// building blocks the wide tables fall back to for inherently serial kernels.
+//==============================================================================
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+ #define PFS_DSP_X86 1
+#else
+ #define PFS_DSP_X86 0
+#endif
+
+namespace pfs::dsp
+{
+    namespace scalar
+    {
+        void  mixToMono         (float* dst, const float* left, const float* right, int numSamples);
+        void  addWithGain       (float* dst, const float* src, float gain, int numSamples);
+        void  multiplyByGain    (float* data, float gain, int numSamples);
+        void  floatToInt16      (std::int16_t* dst, const float* src, float scale, int numSamples);
+        void  int16ToFloat      (float* dst, const std::int16_t* src, float scale, int numSamples);
+        void  mixInt16ToMono    (float* dst, const std::int16_t* left, const std::int16_t* right,
+                                 float scale, int numSamples);
+        float peakAbs           (const float* src, int numSamples);
+        void  magnitudes        (float* dst, const float* interleavedComplex, int numBins);
+        void  filterBankEnergy  (const float* src, int numSamples, const BiquadBank4* sections,
+                                 BiquadBank4State* states, int numSections, float* sumsOfSquares);
+        void  filterBank        (float* const* channels, int numChannels, int numSamples,
+                                 const BiquadBank4* sections, BiquadBank4State* states, int numSections);
+        void  linearInterpolate (float* dst, const float* src, int srcLength,
+                                 double startPosition, double increment, int numSamples);
+    }
+
+    const KernelTable& scalarKernels() noexcept;
+
+   #if PFS_DSP_X86
+    const KernelTable& sse2Kernels() noexcept;
+    const KernelTable& avx2Kernels() noexcept;
+    const KernelTable& avx512Kernels() noexcept;
+   #endif
+
+    /** The table for an ISA, without clamping it to what the CPU supports. */
+    const KernelTable& tableFor (Isa isa) noexcept;
+}
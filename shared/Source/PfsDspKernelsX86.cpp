@@ -0,0 +1,752 @@
+//==============================================================================
+// PfsDspKernelsX86.cpp
+//
+// SSE2, AVX2 (+FMA) and AVX-512F kernel tables.
+//
+// Each function carries its own target attribute instead of the whole file
+// being compiled with -mavx2 / -mavx512f: the rest of the binary stays at the
+// baseline ISA, universal macOS builds still compile the arm64 slice, and
+// nothing wide can run before the cpuid check in PfsDspKernels.cpp says so.
+//
+// The 16-bit conversions stop at AVX2 in every table, as they are bound by
+// memory rather than arithmetic. filterBankEnergy and filterBank go wide
+// across filters (or channels) instead of across samples, so they stop at
+// four lanes. linearInterpolate needs a gather, so SSE2 keeps the scalar loop.
+// Tails shorter than one vector fall through to plain scalar code inside the
+// same function.
+//==============================================================================
+
+#include "PfsDspKernelsInternal.h"
+
+#if PFS_DSP_X86
+
+#include <immintrin.h>
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(_MSC_VER) && ! defined(__clang__)
+ // MSVC allows any intrinsic in any function — no per-function target needed
+ #define PFS_TARGET_SSE2
+ #define PFS_TARGET_AVX2
+ #define PFS_TARGET_AVX512
+#else
+ #define PFS_TARGET_SSE2   __attribute__ ((target ("sse2")))
+ #define PFS_TARGET_AVX2   __attribute__ ((target ("avx2,fma")))
+ #define PFS_TARGET_AVX512 __attribute__ ((target ("avx512f,avx2,fma")))
+#endif
+
+namespace pfs::dsp
+{
+    //==========================================================================
+    // SSE2 — 4 lanes
+    //==========================================================================
+
+    namespace sse2
+    {
+        PFS_TARGET_SSE2 inline float horizontalMax (__m128 v)
+        {
+            v = _mm_max_ps (v, _mm_shuffle_ps (v, v, _MM_SHUFFLE (2, 3, 0, 1)));
+            v = _mm_max_ps (v, _mm_movehl_ps (v, v));
+            return _mm_cvtss_f32 (v);
+        }
+
+        PFS_TARGET_SSE2 void mixToMono (float* dst, const float* left, const float* right, int numSamples)
+        {
+            const __m128 half = _mm_set1_ps (0.5f);
+            int i = 0;
+
+            for (; i + 4 <= numSamples; i += 4)
+                _mm_storeu_ps (dst + i, _mm_mul_ps (_mm_add_ps (_mm_loadu_ps (left + i), _mm_loadu_ps (right + i)), half));
+
+            for (; i < numSamples; ++i)
+                dst[i] = (left[i] + right[i]) * 0.5f;
+        }
+
+        PFS_TARGET_SSE2 void addWithGain (float* dst, const float* src, float gain, int numSamples)
+        {
+            const __m128 g = _mm_set1_ps (gain);
+            int i = 0;
+
+            for (; i + 4 <= numSamples; i += 4)
+                _mm_storeu_ps (dst + i, _mm_add_ps (_mm_loadu_ps (dst + i), _mm_mul_ps (_mm_loadu_ps (src + i), g)));
+
+            for (; i < numSamples; ++i)
+                dst[i] += src[i] * gain;
+        }
+
+        PFS_TARGET_SSE2 void multiplyByGain (float* data, float gain, int numSamples)
+        {
+            const __m128 g = _mm_set1_ps (gain);
+            int i = 0;
+
+            for (; i + 4 <= numSamples; i += 4)
+                _mm_storeu_ps (data + i, _mm_mul_ps (_mm_loadu_ps (data + i), g));
+
+            for (; i < numSamples; ++i)
+                data[i] *= gain;
+        }
+
+        PFS_TARGET_SSE2 void floatToInt16 (std::int16_t* dst, const float* src, float scale, int numSamples)
+        {
+            const __m128 g  = _mm_set1_ps (scale);
+            const __m128 lo = _mm_set1_ps (-32768.0f);
+            const __m128 hi = _mm_set1_ps (32767.0f);
+            int i = 0;
+
+            for (; i + 8 <= numSamples; i += 8)
+            {
+                const __m128 a = _mm_min_ps (_mm_max_ps (_mm_mul_ps (_mm_loadu_ps (src + i),     g), lo), hi);
+                const __m128 b = _mm_min_ps (_mm_max_ps (_mm_mul_ps (_mm_loadu_ps (src + i + 4), g), lo), hi);
+
+                _mm_storeu_si128 (reinterpret_cast<__m128i*> (dst + i),
+                                  _mm_packs_epi32 (_mm_cvtps_epi32 (a), _mm_cvtps_epi32 (b)));
+            }
+
+            scalar::floatToInt16 (dst + i, src + i, scale, numSamples - i);
+        }
+
+        /** Sign-extends eight int16 to two vectors of int32. */
+        PFS_TARGET_SSE2 inline void widenInt16 (__m128i v, __m128i& low, __m128i& high)
+        {
+            low  = _mm_srai_epi32 (_mm_unpacklo_epi16 (v, v), 16);
+            high = _mm_srai_epi32 (_mm_unpackhi_epi16 (v, v), 16);
+        }
+
+        PFS_TARGET_SSE2 void int16ToFloat (float* dst, const std::int16_t* src, float scale, int numSamples)
+        {
+            const __m128 g = _mm_set1_ps (scale);
+            int i = 0;
+
+            for (; i + 8 <= numSamples; i += 8)
+            {
+                __m128i low, high;
+                widenInt16 (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (src + i)), low, high);
+
+                _mm_storeu_ps (dst + i,     _mm_mul_ps (_mm_cvtepi32_ps (low),  g));
+                _mm_storeu_ps (dst + i + 4, _mm_mul_ps (_mm_cvtepi32_ps (high), g));
+            }
+
+            for (; i < numSamples; ++i)
+                dst[i] = static_cast<float> (src[i]) * scale;
+        }
+
+        PFS_TARGET_SSE2 void mixInt16ToMono (float* dst, const std::int16_t* left, const std::int16_t* right,
+                                             float scale, int numSamples)
+        {
+            const float  halfScale = scale * 0.5f;
+            const __m128 g = _mm_set1_ps (halfScale);
+            int i = 0;
+
+            for (; i + 8 <= numSamples; i += 8)
+            {
+                __m128i l0, l1, r0, r1;
+                widenInt16 (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (left + i)),  l0, l1);
+                widenInt16 (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (right + i)), r0, r1);
+
+                // The int32 sum is exact, so this matches the scalar loop bit for bit
+                _mm_storeu_ps (dst + i,     _mm_mul_ps (_mm_cvtepi32_ps (_mm_add_epi32 (l0, r0)), g));
+                _mm_storeu_ps (dst + i + 4, _mm_mul_ps (_mm_cvtepi32_ps (_mm_add_epi32 (l1, r1)), g));
+            }
+
+            for (; i < numSamples; ++i)
+                dst[i] = static_cast<float> (left[i] + right[i]) * halfScale;
+        }
+
+        PFS_TARGET_SSE2 float peakAbs (const float* src, int numSamples)
+        {
+            const __m128 absMask = _mm_castsi128_ps (_mm_set1_epi32 (0x7fffffff));
+            __m128 peak = _mm_setzero_ps();
+            int i = 0;
+
+            for (; i + 4 <= numSamples; i += 4)
+                peak = _mm_max_ps (peak, _mm_and_ps (_mm_loadu_ps (src + i), absMask));
+
+            float result = horizontalMax (peak);
+
+            for (; i < numSamples; ++i)
+                result = std::max (result, std::abs (src[i]));
+
+            return result;
+        }
+
+        PFS_TARGET_SSE2 void magnitudes (float* dst, const float* interleavedComplex, int numBins)
+        {
+            int k = 0;
+
+            for (; k + 4 <= numBins; k += 4)
+            {
+                const __m128 a  = _mm_loadu_ps (interleavedComplex + 2 * k);       // r0 i0 r1 i1
+                const __m128 b  = _mm_loadu_ps (interleavedComplex + 2 * k + 4);   // r2 i2 r3 i3
+                const __m128 re = _mm_shuffle_ps (a, b, _MM_SHUFFLE (2, 0, 2, 0));
+                const __m128 im = _mm_shuffle_ps (a, b, _MM_SHUFFLE (3, 1, 3, 1));
+
+                _mm_storeu_ps (dst + k, _mm_sqrt_ps (_mm_add_ps (_mm_mul_ps (re, re), _mm_mul_ps (im, im))));
+            }
+
+            for (; k < numBins; ++k)
+            {
+                const float re = interleavedComplex[2 * k];
+                const float im = interleavedComplex[2 * k + 1];
+                dst[k] = std::sqrt (re * re + im * im);
+            }
+        }
+
+        // Lanes are the four filters, not four consecutive samples — that is what
+        // lets a recursive filter go wide. Coefficients and state stay in registers.
+        PFS_TARGET_SSE2 void filterBankEnergy (const float* src, int numSamples, const BiquadBank4* sections,
+                                               BiquadBank4State* states, int numSections, float* sumsOfSquares)
+        {
+            numSections = std::min (numSections, maxBankSections);
+
+            __m128 b0[maxBankSections], b1[maxBankSections], b2[maxBankSections];
+            __m128 a1[maxBankSections], a2[maxBankSections];
+            __m128 s1[maxBankSections], s2[maxBankSections];
+
+            for (int k = 0; k < numSections; ++k)
+            {
+                b0[k] = _mm_loadu_ps (sections[k].b0);  b1[k] = _mm_loadu_ps (sections[k].b1);
+                b2[k] = _mm_loadu_ps (sections[k].b2);
+                a1[k] = _mm_loadu_ps (sections[k].a1);  a2[k] = _mm_loadu_ps (sections[k].a2);
+                s1[k] = _mm_loadu_ps (states[k].s1);    s2[k] = _mm_loadu_ps (states[k].s2);
+            }
+
+            __m128 acc = _mm_setzero_ps();
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                __m128 x = _mm_set1_ps (src[i]);
+
+                for (int k = 0; k < numSections; ++k)
+                {
+                    const __m128 y = _mm_add_ps (_mm_mul_ps (b0[k], x), s1[k]);
+                    s1[k] = _mm_add_ps (_mm_sub_ps (_mm_mul_ps (b1[k], x), _mm_mul_ps (a1[k], y)), s2[k]);
+                    s2[k] = _mm_sub_ps (_mm_mul_ps (b2[k], x), _mm_mul_ps (a2[k], y));
+                    x = y;
+                }
+
+                acc = _mm_add_ps (acc, _mm_mul_ps (x, x));
+            }
+
+            for (int k = 0; k < numSections; ++k)
+            {
+                _mm_storeu_ps (states[k].s1, s1[k]);
+                _mm_storeu_ps (states[k].s2, s2[k]);
+            }
+
+            _mm_storeu_ps (sumsOfSquares, _mm_add_ps (_mm_loadu_ps (sumsOfSquares), acc));
+        }
+
+        // One channel per lane, so a stereo cascade advances both channels with
+        // each instruction. Unused lanes filter zeros and are never written back.
+        PFS_TARGET_SSE2 void filterBank (float* const* channels, int numChannels, int numSamples,
+                                         const BiquadBank4* sections, BiquadBank4State* states, int numSections)
+        {
+            numChannels = std::min (numChannels, 4);
+            numSections = std::min (numSections, maxBankSections);
+
+            __m128 b0[maxBankSections], b1[maxBankSections], b2[maxBankSections];
+            __m128 a1[maxBankSections], a2[maxBankSections];
+            __m128 s1[maxBankSections], s2[maxBankSections];
+
+            for (int k = 0; k < numSections; ++k)
+            {
+                b0[k] = _mm_loadu_ps (sections[k].b0);  b1[k] = _mm_loadu_ps (sections[k].b1);
+                b2[k] = _mm_loadu_ps (sections[k].b2);
+                a1[k] = _mm_loadu_ps (sections[k].a1);  a2[k] = _mm_loadu_ps (sections[k].a2);
+                s1[k] = _mm_loadu_ps (states[k].s1);    s2[k] = _mm_loadu_ps (states[k].s2);
+            }
+
+            // Channels are interleaved into 4-wide frames a block at a time, so the
+            // recursion loads and stores whole registers (gathering lane by lane
+            // straight into a register would stall on store forwarding).
+            constexpr int blockSize = 64;
+            alignas (16) float in[blockSize * 4] {};
+            alignas (16) float out[blockSize * 4];
+
+            for (int start = 0; start < numSamples; start += blockSize)
+            {
+                const int count = std::min (blockSize, numSamples - start);
+
+                for (int c = 0; c < numChannels; ++c)
+                    for (int i = 0; i < count; ++i)
+                        in[4 * i + c] = channels[c][start + i];
+
+                for (int i = 0; i < count; ++i)
+                {
+                    __m128 x = _mm_load_ps (in + 4 * i);
+
+                    for (int k = 0; k < numSections; ++k)
+                    {
+                        const __m128 y = _mm_add_ps (_mm_mul_ps (b0[k], x), s1[k]);
+                        s1[k] = _mm_add_ps (_mm_sub_ps (_mm_mul_ps (b1[k], x), _mm_mul_ps (a1[k], y)), s2[k]);
+                        s2[k] = _mm_sub_ps (_mm_mul_ps (b2[k], x), _mm_mul_ps (a2[k], y));
+                        x = y;
+                    }
+
+                    _mm_store_ps (out + 4 * i, x);
+                }
+
+                for (int c = 0; c < numChannels; ++c)
+                    for (int i = 0; i < count; ++i)
+                        channels[c][start + i] = out[4 * i + c];
+            }
+
+            // Write back only the lanes that carried a channel
+            for (int k = 0; k < numSections; ++k)
+            {
+                alignas (16) float n1[4], n2[4];
+                _mm_store_ps (n1, s1[k]);
+                _mm_store_ps (n2, s2[k]);
+
+                for (int c = 0; c < numChannels; ++c)
+                {
+                    states[k].s1[c] = n1[c];
+                    states[k].s2[c] = n2[c];
+                }
+            }
+        }
+    }
+
+    //==========================================================================
+    // AVX2 + FMA — 8 lanes
+    //==========================================================================
+
+    namespace avx2
+    {
+        PFS_TARGET_AVX2 inline float horizontalMax (__m256 v)
+        {
+            const __m128 max4 = _mm_max_ps (_mm256_castps256_ps128 (v), _mm256_extractf128_ps (v, 1));
+            return sse2::horizontalMax (max4);
+        }
+
+        PFS_TARGET_AVX2 void mixToMono (float* dst, const float* left, const float* right, int numSamples)
+        {
+            const __m256 half = _mm256_set1_ps (0.5f);
+            int i = 0;
+
+            for (; i + 8 <= numSamples; i += 8)
+                _mm256_storeu_ps (dst + i, _mm256_mul_ps (_mm256_add_ps (_mm256_loadu_ps (left + i), _mm256_loadu_ps (right + i)), half));
+
+            for (; i < numSamples; ++i)
+                dst[i] = (left[i] + right[i]) * 0.5f;
+        }
+
+        PFS_TARGET_AVX2 void addWithGain (float* dst, const float* src, float gain, int numSamples)
+        {
+            const __m256 g = _mm256_set1_ps (gain);
+            int i = 0;
+
+            for (; i + 8 <= numSamples; i += 8)
+                _mm256_storeu_ps (dst + i, _mm256_fmadd_ps (_mm256_loadu_ps (src + i), g, _mm256_loadu_ps (dst + i)));
+
+            for (; i < numSamples; ++i)
+                dst[i] += src[i] * gain;
+        }
+
+        PFS_TARGET_AVX2 void multiplyByGain (float* data, float gain, int numSamples)
+        {
+            const __m256 g = _mm256_set1_ps (gain);
+            int i = 0;
+
+            for (; i + 8 <= numSamples; i += 8)
+                _mm256_storeu_ps (data + i, _mm256_mul_ps (_mm256_loadu_ps (data + i), g));
+
+            for (; i < numSamples; ++i)
+                data[i] *= gain;
+        }
+
+        PFS_TARGET_AVX2 void floatToInt16 (std::int16_t* dst, const float* src, float scale, int numSamples)
+        {
+            const __m256 g  = _mm256_set1_ps (scale);
+            const __m256 lo = _mm256_set1_ps (-32768.0f);
+            const __m256 hi = _mm256_set1_ps (32767.0f);
+            int i = 0;
+
+            for (; i + 16 <= numSamples; i += 16)
+            {
+                const __m256 a = _mm256_min_ps (_mm256_max_ps (_mm256_mul_ps (_mm256_loadu_ps (src + i),     g), lo), hi);
+                const __m256 b = _mm256_min_ps (_mm256_max_ps (_mm256_mul_ps (_mm256_loadu_ps (src + i + 8), g), lo), hi);
+
+                // packs works within each 128-bit half: a0 b0 a1 b1 → a0 a1 b0 b1
+                const __m256i packed = _mm256_packs_epi32 (_mm256_cvtps_epi32 (a), _mm256_cvtps_epi32 (b));
+                _mm256_storeu_si256 (reinterpret_cast<__m256i*> (dst + i), _mm256_permute4x64_epi64 (packed, 0xd8));
+            }
+
+            scalar::floatToInt16 (dst + i, src + i, scale, numSamples - i);
+        }
+
+        PFS_TARGET_AVX2 inline __m256 loadInt16AsFloat (const std::int16_t* src)
+        {
+            return _mm256_cvtepi32_ps (_mm256_cvtepi16_epi32 (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (src))));
+        }
+
+        PFS_TARGET_AVX2 void int16ToFloat (float* dst, const std::int16_t* src, float scale, int numSamples)
+        {
+            const __m256 g = _mm256_set1_ps (scale);
+            int i = 0;
+
+            for (; i + 8 <= numSamples; i += 8)
+                _mm256_storeu_ps (dst + i, _mm256_mul_ps (loadInt16AsFloat (src + i), g));
+
+            for (; i < numSamples; ++i)
+                dst[i] = static_cast<float> (src[i]) * scale;
+        }
+
+        PFS_TARGET_AVX2 void mixInt16ToMono (float* dst, const std::int16_t* left, const std::int16_t* right,
+                                             float scale, int numSamples)
+        {
+            const float  halfScale = scale * 0.5f;
+            const __m256 g = _mm256_set1_ps (halfScale);
+            int i = 0;
+
+            for (; i + 8 <= numSamples; i += 8)
+            {
+                const __m256i l = _mm256_cvtepi16_epi32 (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (left + i)));
+                const __m256i r = _mm256_cvtepi16_epi32 (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (right + i)));
+
+                _mm256_storeu_ps (dst + i, _mm256_mul_ps (_mm256_cvtepi32_ps (_mm256_add_epi32 (l, r)), g));
+            }
+
+            for (; i < numSamples; ++i)
+                dst[i] = static_cast<float> (left[i] + right[i]) * halfScale;
+        }
+
+        PFS_TARGET_AVX2 float peakAbs (const float* src, int numSamples)
+        {
+            const __m256 absMask = _mm256_castsi256_ps (_mm256_set1_epi32 (0x7fffffff));
+            __m256 peak = _mm256_setzero_ps();
+            int i = 0;
+
+            for (; i + 8 <= numSamples; i += 8)
+                peak = _mm256_max_ps (peak, _mm256_and_ps (_mm256_loadu_ps (src + i), absMask));
+
+            float result = horizontalMax (peak);
+
+            for (; i < numSamples; ++i)
+                result = std::max (result, std::abs (src[i]));
+
+            return result;
+        }
+
+        PFS_TARGET_AVX2 void magnitudes (float* dst, const float* interleavedComplex, int numBins)
+        {
+            // Deinterleave across both 128-bit halves, then undo the lane split
+            const __m256i order = _mm256_setr_epi32 (0, 1, 4, 5, 2, 3, 6, 7);
+            int k = 0;
+
+            for (; k + 8 <= numBins; k += 8)
+            {
+                const __m256 a  = _mm256_loadu_ps (interleavedComplex + 2 * k);
+                const __m256 b  = _mm256_loadu_ps (interleavedComplex + 2 * k + 8);
+                const __m256 re = _mm256_shuffle_ps (a, b, _MM_SHUFFLE (2, 0, 2, 0));
+                const __m256 im = _mm256_shuffle_ps (a, b, _MM_SHUFFLE (3, 1, 3, 1));
+                const __m256 m  = _mm256_sqrt_ps (_mm256_fmadd_ps (re, re, _mm256_mul_ps (im, im)));
+
+                _mm256_storeu_ps (dst + k, _mm256_permutevar8x32_ps (m, order));
+            }
+
+            for (; k < numBins; ++k)
+            {
+                const float re = interleavedComplex[2 * k];
+                const float im = interleavedComplex[2 * k + 1];
+                dst[k] = std::sqrt (re * re + im * im);
+            }
+        }
+
+        // Four filter lanes only need 128-bit registers — the AVX2 build gains FMA
+        PFS_TARGET_AVX2 void filterBankEnergy (const float* src, int numSamples, const BiquadBank4* sections,
+                                               BiquadBank4State* states, int numSections, float* sumsOfSquares)
+        {
+            numSections = std::min (numSections, maxBankSections);
+
+            __m128 b0[maxBankSections], b1[maxBankSections], b2[maxBankSections];
+            __m128 a1[maxBankSections], a2[maxBankSections];
+            __m128 s1[maxBankSections], s2[maxBankSections];
+
+            for (int k = 0; k < numSections; ++k)
+            {
+                b0[k] = _mm_loadu_ps (sections[k].b0);  b1[k] = _mm_loadu_ps (sections[k].b1);
+                b2[k] = _mm_loadu_ps (sections[k].b2);
+                a1[k] = _mm_loadu_ps (sections[k].a1);  a2[k] = _mm_loadu_ps (sections[k].a2);
+                s1[k] = _mm_loadu_ps (states[k].s1);    s2[k] = _mm_loadu_ps (states[k].s2);
+            }
+
+            __m128 acc = _mm_setzero_ps();
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                __m128 x = _mm_set1_ps (src[i]);
+
+                for (int k = 0; k < numSections; ++k)
+                {
+                    const __m128 y = _mm_fmadd_ps (b0[k], x, s1[k]);
+                    s1[k] = _mm_fnmadd_ps (a1[k], y, _mm_fmadd_ps (b1[k], x, s2[k]));
+                    s2[k] = _mm_fnmadd_ps (a2[k], y, _mm_mul_ps (b2[k], x));
+                    x = y;
+                }
+
+                acc = _mm_fmadd_ps (x, x, acc);
+            }
+
+            for (int k = 0; k < numSections; ++k)
+            {
+                _mm_storeu_ps (states[k].s1, s1[k]);
+                _mm_storeu_ps (states[k].s2, s2[k]);
+            }
+
+            _mm_storeu_ps (sumsOfSquares, _mm_add_ps (_mm_loadu_ps (sumsOfSquares), acc));
+        }
+
+        PFS_TARGET_AVX2 void filterBank (float* const* channels, int numChannels, int numSamples,
+                                         const BiquadBank4* sections, BiquadBank4State* states, int numSections)
+        {
+            numChannels = std::min (numChannels, 4);
+            numSections = std::min (numSections, maxBankSections);
+
+            __m128 b0[maxBankSections], b1[maxBankSections], b2[maxBankSections];
+            __m128 a1[maxBankSections], a2[maxBankSections];
+            __m128 s1[maxBankSections], s2[maxBankSections];
+
+            for (int k = 0; k < numSections; ++k)
+            {
+                b0[k] = _mm_loadu_ps (sections[k].b0);  b1[k] = _mm_loadu_ps (sections[k].b1);
+                b2[k] = _mm_loadu_ps (sections[k].b2);
+                a1[k] = _mm_loadu_ps (sections[k].a1);  a2[k] = _mm_loadu_ps (sections[k].a2);
+                s1[k] = _mm_loadu_ps (states[k].s1);    s2[k] = _mm_loadu_ps (states[k].s2);
+            }
+
+            // Channels are interleaved into 4-wide frames a block at a time, so the
+            // recursion loads and stores whole registers (gathering lane by lane
+            // straight into a register would stall on store forwarding).
+            constexpr int blockSize = 64;
+            alignas (16) float in[blockSize * 4] {};
+            alignas (16) float out[blockSize * 4];
+
+            for (int start = 0; start < numSamples; start += blockSize)
+            {
+                const int count = std::min (blockSize, numSamples - start);
+
+                for (int c = 0; c < numChannels; ++c)
+                    for (int i = 0; i < count; ++i)
+                        in[4 * i + c] = channels[c][start + i];
+
+                for (int i = 0; i < count; ++i)
+                {
+                    __m128 x = _mm_load_ps (in + 4 * i);
+
+                    for (int k = 0; k < numSections; ++k)
+                    {
+                        const __m128 y = _mm_fmadd_ps (b0[k], x, s1[k]);
+                        s1[k] = _mm_fnmadd_ps (a1[k], y, _mm_fmadd_ps (b1[k], x, s2[k]));
+                        s2[k] = _mm_fnmadd_ps (a2[k], y, _mm_mul_ps (b2[k], x));
+                        x = y;
+                    }
+
+                    _mm_store_ps (out + 4 * i, x);
+                }
+
+                for (int c = 0; c < numChannels; ++c)
+                    for (int i = 0; i < count; ++i)
+                        channels[c][start + i] = out[4 * i + c];
+            }
+
+            // Write back only the lanes that carried a channel
+            for (int k = 0; k < numSections; ++k)
+            {
+                alignas (16) float n1[4], n2[4];
+                _mm_store_ps (n1, s1[k]);
+                _mm_store_ps (n2, s2[k]);
+
+                for (int c = 0; c < numChannels; ++c)
+                {
+                    states[k].s1[c] = n1[c];
+                    states[k].s2[c] = n2[c];
+                }
+            }
+        }
+
+        PFS_TARGET_AVX2 void linearInterpolate (float* dst, const float* src, int srcLength,
+                                                double startPosition, double increment, int numSamples)
+        {
+            if (srcLength <= 1)
+            {
+                scalar::linearInterpolate (dst, src, srcLength, startPosition, increment, numSamples);
+                return;
+            }
+
+            const __m256d laneOffsets = _mm256_setr_pd (0.0, 1.0, 2.0, 3.0);
+            const __m256d start       = _mm256_set1_pd (startPosition);
+            const __m256d step        = _mm256_set1_pd (increment);
+            const __m256d lo          = _mm256_setzero_pd();
+            const __m256d hi          = _mm256_set1_pd (static_cast<double> (srcLength - 1));
+            const __m128i lastIndex   = _mm_set1_epi32 (srcLength - 1);
+            const __m128i one         = _mm_set1_epi32 (1);
+            int i = 0;
+
+            // Positions stay in double so a long sample doesn't lose the fraction
+            for (; i + 4 <= numSamples; i += 4)
+            {
+                const __m256d n     = _mm256_add_pd (_mm256_set1_pd (static_cast<double> (i)), laneOffsets);
+                const __m256d pos   = _mm256_min_pd (_mm256_max_pd (_mm256_add_pd (start, _mm256_mul_pd (n, step)), lo), hi);
+                const __m128i index = _mm256_cvttpd_epi32 (pos);
+                const __m128i next  = _mm_min_epi32 (_mm_add_epi32 (index, one), lastIndex);
+                const __m128  frac  = _mm256_cvtpd_ps (_mm256_sub_pd (pos, _mm256_cvtepi32_pd (index)));
+
+                const __m128 a = _mm_i32gather_ps (src, index, 4);
+                const __m128 b = _mm_i32gather_ps (src, next, 4);
+
+                _mm_storeu_ps (dst + i, _mm_fmadd_ps (_mm_sub_ps (b, a), frac, a));
+            }
+
+            if (i < numSamples)
+                scalar::linearInterpolate (dst + i, src, srcLength,
+                                           startPosition + static_cast<double> (i) * increment,
+                                           increment, numSamples - i);
+        }
+    }
+
+    //==========================================================================
+    // AVX-512F — 16 lanes (conversions, filter banks and the gather in
+    // linearInterpolate reuse the AVX2 versions)
+    //==========================================================================
+
+    namespace avx512
+    {
+        PFS_TARGET_AVX512 void mixToMono (float* dst, const float* left, const float* right, int numSamples)
+        {
+            const __m512 half = _mm512_set1_ps (0.5f);
+            int i = 0;
+
+            for (; i + 16 <= numSamples; i += 16)
+                _mm512_storeu_ps (dst + i, _mm512_mul_ps (_mm512_add_ps (_mm512_loadu_ps (left + i), _mm512_loadu_ps (right + i)), half));
+
+            for (; i < numSamples; ++i)
+                dst[i] = (left[i] + right[i]) * 0.5f;
+        }
+
+        PFS_TARGET_AVX512 void addWithGain (float* dst, const float* src, float gain, int numSamples)
+        {
+            const __m512 g = _mm512_set1_ps (gain);
+            int i = 0;
+
+            for (; i + 16 <= numSamples; i += 16)
+                _mm512_storeu_ps (dst + i, _mm512_fmadd_ps (_mm512_loadu_ps (src + i), g, _mm512_loadu_ps (dst + i)));
+
+            for (; i < numSamples; ++i)
+                dst[i] += src[i] * gain;
+        }
+
+        PFS_TARGET_AVX512 void multiplyByGain (float* data, float gain, int numSamples)
+        {
+            const __m512 g = _mm512_set1_ps (gain);
+            int i = 0;
+
+            for (; i + 16 <= numSamples; i += 16)
+                _mm512_storeu_ps (data + i, _mm512_mul_ps (_mm512_loadu_ps (data + i), g));
+
+            for (; i < numSamples; ++i)
+                data[i] *= gain;
+        }
+
+        PFS_TARGET_AVX512 float peakAbs (const float* src, int numSamples)
+        {
+            __m512 peak = _mm512_setzero_ps();
+            int i = 0;
+
+            for (; i + 16 <= numSamples; i += 16)
+                peak = _mm512_max_ps (peak, _mm512_abs_ps (_mm512_loadu_ps (src + i)));
+
+            float result = _mm512_reduce_max_ps (peak);
+
+            for (; i < numSamples; ++i)
+                result = std::max (result, std::abs (src[i]));
+
+            return result;
+        }
+
+        PFS_TARGET_AVX512 void magnitudes (float* dst, const float* interleavedComplex, int numBins)
+        {
+            const __m512i evenIdx = _mm512_setr_epi32 (0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30);
+            const __m512i oddIdx  = _mm512_setr_epi32 (1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31);
+            int k = 0;
+
+            for (; k + 16 <= numBins; k += 16)
+            {
+                const __m512 a  = _mm512_loadu_ps (interleavedComplex + 2 * k);
+                const __m512 b  = _mm512_loadu_ps (interleavedComplex + 2 * k + 16);
+                const __m512 re = _mm512_permutex2var_ps (a, evenIdx, b);
+                const __m512 im = _mm512_permutex2var_ps (a, oddIdx, b);
+
+                _mm512_storeu_ps (dst + k, _mm512_sqrt_ps (_mm512_fmadd_ps (re, re, _mm512_mul_ps (im, im))));
+            }
+
+            for (; k < numBins; ++k)
+            {
+                const float re = interleavedComplex[2 * k];
+                const float im = interleavedComplex[2 * k + 1];
+                dst[k] = std::sqrt (re * re + im * im);
+            }
+        }
+    }
+
+    //==========================================================================
+    // Tables
+    //==========================================================================
+
+    const KernelTable& sse2Kernels() noexcept
+    {
+        static const KernelTable table {
+            sse2::mixToMono,
+            sse2::addWithGain,
+            sse2::multiplyByGain,
+            sse2::floatToInt16,
+            sse2::int16ToFloat,
+            sse2::mixInt16ToMono,
+            sse2::peakAbs,
+            sse2::magnitudes,
+            sse2::filterBankEnergy,
+            sse2::filterBank,
+            scalar::linearInterpolate
+        };
+        return table;
+    }
+
+    const KernelTable& avx2Kernels() noexcept
+    {
+        static const KernelTable table {
+            avx2::mixToMono,
+            avx2::addWithGain,
+            avx2::multiplyByGain,
+            avx2::floatToInt16,
+            avx2::int16ToFloat,
+            avx2::mixInt16ToMono,
+            avx2::peakAbs,
+            avx2::magnitudes,
+            avx2::filterBankEnergy,
+            avx2::filterBank,
+            avx2::linearInterpolate
+        };
+        return table;
+    }
+
+    const KernelTable& avx512Kernels() noexcept
+    {
+        static const KernelTable table {
+            avx512::mixToMono,
+            avx512::addWithGain,
+            avx512::multiplyByGain,
+            avx2::floatToInt16,
+            avx2::int16ToFloat,
+            avx2::mixInt16ToMono,
+            avx512::peakAbs,
+            avx512::magnitudes,
+            avx2::filterBankEnergy,
+            avx2::filterBank,
+            avx2::linearInterpolate
+        };
+        return table;
+    }
+}
+
+#endif // PFS_DSP_X86
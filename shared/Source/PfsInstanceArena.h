@@ -0,0 +1,152 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+//==============================================================================
+/**
+ * PfsInstanceArena — one contiguous, cache-aligned block per plugin instance
+ *
+ * Holds the plain sample buffers a processor owns (scratch, wet/dry copies,
+ * feedback, capture, window tables) instead of one heap allocation each.
+ * Used from prepareToPlay() in two steps:
+ *
+ *     arena.beginLayout();
+ *     auto wet = arena.reserve<float> (2, samplesPerBlock);
+ *     auto win = arena.reserve<float> (1, windowSize);
+ *     arena.commit();                               // one allocation, zeroed
+ *     arena.attach (wetBuffer, wet);                // AudioBuffer refers into the arena
+ *     windowTable = arena.data<float> (win);
+ *
+ * - Every channel starts on a 64-byte boundary (no false sharing between
+ *   channels, aligned SIMD loads at the start of each channel).
+ * - commit() only reallocates when the new layout is larger than the current
+ *   block, so repeated prepareToPlay() calls at the same or a lower
+ *   rate / block size reuse the same memory instead of fragmenting the heap.
+ *   Pointers handed out before a commit() must be re-fetched after it.
+ * - getFootprintBytes() reports the committed size, for logging/diagnostics.
+ *
+ * DSP objects that manage their own storage (juce::dsp::DelayLine,
+ * Oversampling, DryWetMixer) are not arena-backed.
+ *
+ * Header-only and JUCE-free: attach() works with any AudioBuffer-style
+ * template that offers setDataToReferTo (channels, numChannels, numSamples).
+ */
+namespace pfs
+{
+    class InstanceArena
+    {
+    public:
+        static constexpr size_t alignment   = 64;
+        static constexpr int    maxChannels = 32;
+
+        /** A reserved range: numChannels runs of numSamples, channelStride bytes apart. */
+        struct Region
+        {
+            size_t offset        = 0;
+            size_t channelStride = 0;
+            int    numChannels   = 0;
+            int    numSamples    = 0;
+        };
+
+        InstanceArena() = default;
+        InstanceArena (const InstanceArena&) = delete;
+        InstanceArena& operator= (const InstanceArena&) = delete;
+
+        /** Starts a new layout. The committed block stays valid until the next commit(). */
+        void beginLayout() noexcept
+        {
+            layoutBytes = 0;
+        }
+
+        /** Reserves numChannels × numSamples elements of SampleType in the pending layout. */
+        template <typename SampleType>
+        Region reserve (int numChannels, int numSamples) noexcept
+        {
+            Region region;
+            region.offset        = layoutBytes;
+            region.numChannels   = numChannels > 0 ? numChannels : 0;
+            region.numSamples    = numSamples  > 0 ? numSamples  : 0;
+            region.channelStride = alignUp (sizeof (SampleType) * static_cast<size_t> (region.numSamples));
+
+            layoutBytes += region.channelStride * static_cast<size_t> (region.numChannels);
+            return region;
+        }
+
+        /** Makes the pending layout live: grows the block if needed and zeroes the used range.
+            Returns true if the block was (re)allocated. Not real-time safe. */
+        bool commit()
+        {
+            bool reallocated = false;
+
+            if (layoutBytes > capacity)
+            {
+                // Over-allocate by one line so the base can be aligned by hand
+                // (aligned operator new needs macOS 10.14; we deploy to 10.13)
+                storage  = std::make_unique<std::byte[]> (layoutBytes + alignment);
+                capacity = layoutBytes;
+
+                const auto address = reinterpret_cast<std::uintptr_t> (storage.get());
+                base = storage.get() + (alignUp (address) - address);
+                reallocated = true;
+            }
+
+            if (base != nullptr && layoutBytes > 0)
+                std::memset (base, 0, layoutBytes);
+
+            committedBytes = layoutBytes;
+            return reallocated;
+        }
+
+        /** Frees the block (e.g. from releaseResources()). Regions must be re-reserved. */
+        void release() noexcept
+        {
+            storage.reset();
+            base = nullptr;
+            capacity = committedBytes = layoutBytes = 0;
+        }
+
+        /** First sample of one channel of a committed region. */
+        template <typename SampleType>
+        SampleType* data (const Region& region, int channel = 0) const noexcept
+        {
+            if (base == nullptr || channel < 0 || channel >= region.numChannels)
+                return nullptr;
+
+            return reinterpret_cast<SampleType*> (base + region.offset + region.channelStride * static_cast<size_t> (channel));
+        }
+
+        /** Points an AudioBuffer<SampleType> at a committed region (no copy, buffer doesn't own it). */
+        template <template <typename> class BufferType, typename SampleType>
+        void attach (BufferType<SampleType>& buffer, const Region& region) const noexcept
+        {
+            SampleType* channels[maxChannels] = {};
+            const int numChannels = region.numChannels < maxChannels ? region.numChannels : maxChannels;
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                channels[ch] = data<SampleType> (region, ch);
+
+            buffer.setDataToReferTo (channels, numChannels, region.numSamples);
+        }
+
+        /** Bytes in use by the committed layout. */
+        size_t getFootprintBytes() const noexcept   { return committedBytes; }
+
+        /** Bytes currently allocated (≥ footprint; only grows between release() calls). */
+        size_t getCapacityBytes() const noexcept    { return capacity; }
+
+    private:
+        static constexpr size_t alignUp (size_t value) noexcept
+        {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+
+        std::unique_ptr<std::byte[]> storage;
+        std::byte* base           = nullptr;
+        size_t     capacity       = 0;
+        size_t     layoutBytes    = 0;
+        size_t     committedBytes = 0;
+    };
+}
@@ -0,0 +1,388 @@
+//==============================================================================
+// GrooveScoutBatch — offline GrooveScout analysis over audio files
+//
+// Usage:
+//   GrooveScoutBatch <folder|file> [--out=DIR] [--threads=N] [--recursive]
+//                    [--skip-existing] [--no-midi] [--bpm-multiplier=0.5|1|2]
+//                    [--chroma=map|cq12|cq36]
+//
+// Decodes every WAV/AIFF/FLAC file it finds and runs the same analysis as
+// the plugin's Analyze button (GrooveScoutAnalysisCore): BPM and beat grid,
+// key, and kick/snare/hihat onsets. Each file gets <name>.json plus
+// <name>_kick.mid, _snare.mid, _hihat.mid, _chord.mid and _all.mid (every
+// clip as one format-1 file) in the output folder, which mirrors the input
+// tree. Files are analysed concurrently, one per worker thread; within a
+// file the stages run in turn.
+//==============================================================================
+
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_core/juce_core.h>
+
+#include "GrooveScoutAnalysisCore.h"
+#include "PfsDspKernels.h"
+
+#include <atomic>
+#include <csignal>
+#include <iostream>
+#include <mutex>
+
+namespace
+{
+    std::atomic<bool> quitRequested { false };
+
+    void handleSignal (int) { quitRequested.store (true); }
+
+    //==========================================================================
+    struct BatchOptions
+    {
+        juce::File                                  inputRoot;
+        juce::File                                  outputRoot;
+        groovescout::AnalysisSettings               settings;
+        groovescout::SpectralFrontEnd::ChromaKernel chromaKernel = groovescout::SpectralFrontEnd::ChromaKernel::constantQ36;
+        bool                                        writeMidi    = true;
+        bool                                        skipExisting = false;
+    };
+
+    /** Output path for an input file: same relative folder, same name, new extension/suffix. */
+    juce::File outputFileFor (const BatchOptions& options, const juce::File& input, const juce::String& suffix)
+    {
+        const auto relative = input.getParentDirectory().getRelativePathFrom (options.inputRoot);
+        auto folder = options.outputRoot;
+
+        if (input.getParentDirectory() != options.inputRoot && relative != ".")
+            folder = folder.getChildFile (relative);
+
+        return folder.getChildFile (input.getFileNameWithoutExtension() + suffix);
+    }
+
+    double roundTo (double value, double step) { return std::round (value / step) * step; }
+
+    //==========================================================================
+    /**
+     * Decodes one file through the shared front end and analyses it.
+     * Returns the JSON summary; "error" is set instead of results on failure.
+     */
+    juce::var analyseFile (const BatchOptions& options, const juce::File& file)
+    {
+        auto* summary = new juce::DynamicObject();
+        juce::var json (summary);
+
+        summary->setProperty ("file", file.getRelativePathFrom (options.inputRoot));
+
+        // A manager per file keeps readers fully independent across threads
+        juce::AudioFormatManager formats;
+        formats.registerBasicFormats();
+
+        std::unique_ptr<juce::AudioFormatReader> reader (formats.createReaderFor (file));
+
+        if (reader == nullptr)
+        {
+            summary->setProperty ("error", "unsupported or unreadable audio file");
+            return json;
+        }
+
+        const double sampleRate = reader->sampleRate;
+        const auto   length     = reader->lengthInSamples;
+
+        summary->setProperty ("sampleRate", sampleRate);
+        summary->setProperty ("durationSeconds", roundTo (static_cast<double> (length) / sampleRate, 0.001));
+
+        if (length < static_cast<juce::int64> (sampleRate * groovescout::minimumAnalysisSeconds)
+            || length > std::numeric_limits<int>::max())
+        {
+            summary->setProperty ("error", "length must be at least "
+                                           + juce::String (groovescout::minimumAnalysisSeconds, 0) + " seconds");
+            return json;
+        }
+
+        const double startMs = juce::Time::getMillisecondCounterHiRes();
+
+        // ---------------------------------------------------------------------
+        // Decode a chunk at a time straight into the front end
+        // ---------------------------------------------------------------------
+        groovescout::SpectralFrontEnd spectrum;
+        spectrum.reset (sampleRate, static_cast<int> (length), options.chromaKernel);
+
+        constexpr int chunkSize = 1 << 16;
+        juce::AudioBuffer<float> chunk (2, chunkSize);
+        std::vector<float>       mono (static_cast<size_t> (chunkSize));
+
+        const bool isMono = reader->numChannels == 1;
+
+        for (juce::int64 position = 0; position < length; position += chunkSize)
+        {
+            if (quitRequested.load())
+                return {};
+
+            const int count = static_cast<int> (std::min<juce::int64> (chunkSize, length - position));
+
+            if (! reader->read (&chunk, 0, count, position, true, ! isMono))
+            {
+                summary->setProperty ("error", "decode failed at sample " + juce::String (position));
+                return json;
+            }
+
+            pfs::dsp::mixToMono (mono.data(), chunk.getReadPointer (0),
+                                 chunk.getReadPointer (isMono ? 0 : 1), count);
+            spectrum.push (mono.data(), count);
+        }
+
+        // ---------------------------------------------------------------------
+        // Analysis — stages in turn on this thread; the pool is busy with files
+        // ---------------------------------------------------------------------
+        const auto result = groovescout::runAnalysis (spectrum, options.settings, nullptr, {});
+
+        if (options.settings.analyseBpm)
+            summary->setProperty ("bpm", roundTo (result.bpm, 0.01));
+
+        if (options.settings.analyseKey)
+        {
+            summary->setProperty ("key", result.key);
+
+            if (result.rootChordValid)
+                summary->setProperty ("rootChord", juce::Array<juce::var> { result.rootChordMidi[0],
+                                                                            result.rootChordMidi[1],
+                                                                            result.rootChordMidi[2] });
+        }
+
+        juce::Array<juce::var> beatTimes, beatBpm;
+        for (size_t i = 0; i < result.beats.beatSamples.size(); ++i)
+        {
+            beatTimes.add (roundTo (result.beats.beatSamples[i] / sampleRate, 0.001));
+            beatBpm.add (roundTo (result.beats.beatBpm[i], 0.01));
+        }
+
+        summary->setProperty ("beats", beatTimes);
+        summary->setProperty ("beatBpm", beatBpm);
+
+        // ---------------------------------------------------------------------
+        // Per-drum MIDI, root chord, and all of them as one multi-track file
+        // ---------------------------------------------------------------------
+        auto* onsetCounts = new juce::DynamicObject();
+        auto* midiFiles   = new juce::DynamicObject();
+
+        onsetCounts->setProperty ("kick",  static_cast<int> (result.kickOnsets.size()));
+        onsetCounts->setProperty ("snare", static_cast<int> (result.snareOnsets.size()));
+        onsetCounts->setProperty ("hihat", static_cast<int> (result.hihatOnsets.size()));
+
+        if (options.writeMidi)
+        {
+            using groovescout::MidiClip;
+
+            const float midiTempoBpm = (result.bpm > 0.0f) ? result.bpm : 120.0f;
+            const auto  clips        = groovescout::assembleMidi (result, midiTempoBpm, sampleRate);
+
+            for (auto clip : { MidiClip::kick, MidiClip::snare, MidiClip::hihat, MidiClip::chord, MidiClip::all })
+            {
+                const juce::String name = groovescout::MidiClips::getName (clip);
+                const auto midiFile = outputFileFor (options, file, "_" + name + ".mid");
+
+                if (clips.writeTo (clip, midiFile))
+                    midiFiles->setProperty (name, midiFile.getFileName());
+            }
+        }
+
+        summary->setProperty ("onsets", juce::var (onsetCounts));
+        summary->setProperty ("midi", juce::var (midiFiles));
+        summary->setProperty ("analysisMs", roundTo (juce::Time::getMillisecondCounterHiRes() - startMs, 0.1));
+
+        return json;
+    }
+
+    //==========================================================================
+    juce::Array<juce::File> collectInputs (const juce::File& root, bool recursive)
+    {
+        juce::Array<juce::File> files;
+
+        if (root.existsAsFile())
+        {
+            files.add (root);
+            return files;
+        }
+
+        for (const auto& entry : juce::RangedDirectoryIterator (root, recursive, "*.wav;*.aif;*.aiff;*.flac",
+                                                                juce::File::findFiles))
+            files.add (entry.getFile());
+
+        files.sort();
+        return files;
+    }
+
+    bool parseChromaKernel (const juce::String& name, groovescout::SpectralFrontEnd::ChromaKernel& kernel)
+    {
+        using Kernel = groovescout::SpectralFrontEnd::ChromaKernel;
+
+        if (name == "map")  { kernel = Kernel::pitchClassMap; return true; }
+        if (name == "cq12") { kernel = Kernel::constantQ12;   return true; }
+        if (name == "cq36") { kernel = Kernel::constantQ36;   return true; }
+
+        return false;
+    }
+
+    /** The plugin's BPM Multiplier choices only: 0.5, 1 or 2. */
+    bool parseBpmMultiplier (const juce::String& text, float& multiplier)
+    {
+        if (text.isEmpty() || ! text.containsOnly ("0123456789."))
+            return false;
+
+        const float value = text.getFloatValue();
+
+        if (value != 0.5f && value != 1.0f && value != 2.0f)
+            return false;
+
+        multiplier = value;
+        return true;
+    }
+}
+
+//==============================================================================
+
+int main (int argc, char* argv[])
+{
+    juce::ArgumentList args (argc, argv);
+
+    if (args.size() == 0 || args.containsOption ("--help|-h"))
+    {
+        std::cout << "Usage: GrooveScoutBatch <folder|file> [--out=DIR] [--threads=N] [--recursive]\n"
+                     "                        [--skip-existing] [--no-midi] [--bpm-multiplier=0.5|1|2]\n"
+                     "                        [--chroma=map|cq12|cq36]" << std::endl;
+        return 1;
+    }
+
+    BatchOptions options;
+    options.inputRoot = args[0].resolveAsFile();
+
+    if (! options.inputRoot.exists())
+    {
+        std::cerr << "GrooveScoutBatch: " << options.inputRoot.getFullPathName() << " does not exist" << std::endl;
+        return 1;
+    }
+
+    const auto inputFolder = options.inputRoot.isDirectory() ? options.inputRoot : options.inputRoot.getParentDirectory();
+
+    options.outputRoot   = args.containsOption ("--out")
+                               ? juce::File::getCurrentWorkingDirectory().getChildFile (args.getValueForOption ("--out"))
+                               : inputFolder.getChildFile ("GrooveScout");
+    options.writeMidi    = ! args.containsOption ("--no-midi");
+    options.skipExisting = args.containsOption ("--skip-existing");
+
+    if (args.containsOption ("--bpm-multiplier")
+        && ! parseBpmMultiplier (args.getValueForOption ("--bpm-multiplier"), options.settings.bpmMultiplier))
+    {
+        std::cerr << "GrooveScoutBatch: --bpm-multiplier must be 0.5, 1 or 2" << std::endl;
+        return 1;
+    }
+
+    if (args.containsOption ("--chroma")
+        && ! parseChromaKernel (args.getValueForOption ("--chroma"), options.chromaKernel))
+    {
+        std::cerr << "GrooveScoutBatch: --chroma must be map, cq12 or cq36" << std::endl;
+        return 1;
+    }
+
+    const auto inputs = collectInputs (options.inputRoot, args.containsOption ("--recursive"));
+    options.inputRoot = inputFolder;
+
+    if (inputs.isEmpty())
+    {
+        std::cerr << "GrooveScoutBatch: no WAV/AIFF/FLAC files found" << std::endl;
+        return 1;
+    }
+
+    const int numThreads = args.containsOption ("--threads")
+                               ? juce::jmax (1, args.getValueForOption ("--threads").getIntValue())
+                               : juce::jmax (1, juce::SystemStats::getNumCpus());
+
+    std::cout << "GrooveScoutBatch: " << inputs.size() << " file(s), " << numThreads << " thread(s), DSP kernels = "
+              << pfs::dsp::isaName (pfs::dsp::activeIsa()) << ", output " << options.outputRoot.getFullPathName() << std::endl;
+
+    std::signal (SIGINT,  handleSignal);
+    std::signal (SIGTERM, handleSignal);
+
+    // -------------------------------------------------------------------------
+    // One job per file
+    // -------------------------------------------------------------------------
+    juce::ThreadPool pool (juce::ThreadPoolOptions{}
+                               .withThreadName ("GrooveScoutBatch")
+                               .withNumberOfThreads (numThreads));
+
+    std::mutex        outputLock;
+    std::atomic<int>  numDone    { 0 };
+    std::atomic<int>  numFailed  { 0 };
+    std::atomic<int>  numSkipped { 0 };
+
+    const double startMs = juce::Time::getMillisecondCounterHiRes();
+
+    for (const auto& file : inputs)
+    {
+        pool.addJob ([&, file]
+        {
+            if (quitRequested.load())
+                return;
+
+            const auto jsonFile = outputFileFor (options, file, ".json");
+
+            // A summary that recorded an error is retried rather than skipped
+            if (options.skipExisting && jsonFile.existsAsFile()
+                && ! juce::JSON::parse (jsonFile).hasProperty ("error"))
+            {
+                numSkipped.fetch_add (1);
+                numDone.fetch_add (1);
+                return;
+            }
+
+            jsonFile.getParentDirectory().createDirectory();
+
+            const auto summary = analyseFile (options, file);
+
+            if (summary.isVoid())   // interrupted
+                return;
+
+            const bool failed = summary.hasProperty ("error");
+
+            // Failures get a summary too, so a script can tell them from files never seen
+            jsonFile.replaceWithText (juce::JSON::toString (summary));
+
+            const int done = numDone.fetch_add (1) + 1;
+
+            const std::lock_guard<std::mutex> lock (outputLock);
+
+            if (failed)
+            {
+                numFailed.fetch_add (1);
+                std::cerr << "[" << done << "/" << inputs.size() << "] " << file.getFullPathName()
+                          << ": " << summary["error"].toString() << std::endl;
+            }
+            else
+            {
+                std::cout << "[" << done << "/" << inputs.size() << "] " << summary["file"].toString();
+
+                if (summary.hasProperty ("bpm"))
+                    std::cout << "  " << juce::String (static_cast<double> (summary["bpm"]), 1) << " BPM";
+
+                if (summary.hasProperty ("key"))
+                    std::cout << "  " << summary["key"].toString();
+
+                std::cout << std::endl;
+            }
+        });
+    }
+
+    while (pool.getNumJobs() > 0)
+    {
+        if (quitRequested.load())
+        {
+            std::cerr << "GrooveScoutBatch: interrupted, waiting for files in progress" << std::endl;
+            pool.removeAllJobs (true, 10000);
+            break;
+        }
+
+        juce::Thread::sleep (100);
+    }
+
+    std::cout << "GrooveScoutBatch: " << (numDone.load() - numSkipped.load()) << " analysed, "
+              << numSkipped.load() << " skipped, " << numFailed.load() << " failed in "
+              << juce::String ((juce::Time::getMillisecondCounterHiRes() - startMs) / 1000.0, 1) << " s" << std::endl;
+
+    return (numFailed.load() > 0 || quitRequested.load()) ? 2 : 0;
+}
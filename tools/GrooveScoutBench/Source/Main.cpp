@@ -0,0 +1,737 @@
+//==============================================================================
+// GrooveScoutBench — synthetic ground-truth benchmark for GrooveScout
+//
+// Usage:
+//   GrooveScoutBench [--plugins=DIR] [--drums=Drum808] [--pad=LushPad]
+//                    [--seconds=N] [--rate=HZ] [--threads=N] [--runs=N]
+//                    [--chroma=map|cq12|cq36] [--json=FILE] [--wav=DIR]
+//                    [--isa=scalar|sse2|avx2|avx512] [--check-kernels]
+//
+// Renders a fixed corpus of loops offline through the built Drum808 and
+// LushPad plugins: every tempo × swing × pattern combination, each over a
+// chord progression in a known key. Because the corpus is generated from
+// MIDI, the BPM, key and every kick/snare/hihat hit time are known exactly.
+// Each loop is run through GrooveScoutAnalysisCore (the plugin's Analyze)
+// and scored:
+//   - BPM:    within 2% of the truth (and, separately, of 1/3, 1/2, 2× or 3×)
+//   - key:    exact match, plus the MIREX weighted score
+//   - onsets: F-measure per band, hits matched within ±50 ms
+//   - speed:  analysis wall time per minute of audio (fastest of --runs)
+// Nothing is random, so two runs on the same build give the same scores.
+//
+// Before rendering, every pfs_dsp ISA the host supports is checked against
+// the scalar kernels, and the bench stops if one disagrees. --check-kernels
+// runs only that check. --isa forces the kernels the analysis uses, so the
+// same corpus can be scored per ISA.
+//==============================================================================
+
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <juce_events/juce_events.h>
+
+#include "GrooveScoutAnalysisCore.h"
+#include "PfsDspKernels.h"
+
+#include <iomanip>
+#include <iostream>
+
+namespace
+{
+    //==========================================================================
+    // Corpus
+    //==========================================================================
+
+    /** One bar of 16ths; each entry is a velocity (0 = rest). */
+    struct DrumPattern
+    {
+        const char* name;
+        juce::uint8 kick[16];
+        juce::uint8 snare[16];
+        juce::uint8 hihat[16];
+    };
+
+    const DrumPattern patterns[] =
+    {
+        { "four",
+          { 120, 0, 0, 0, 120, 0, 0, 0, 120, 0, 0, 0, 120, 0, 0, 0 },
+          {   0, 0, 0, 0, 110, 0, 0, 0,   0, 0, 0, 0, 110, 0, 0, 0 },
+          {   0, 0, 90, 0,  0, 0, 90, 0,  0, 0, 90, 0,  0, 0, 90, 0 } },
+
+        { "break",
+          { 120, 0, 0, 0,   0, 0, 100, 0,   0, 0, 115, 0,   0, 0, 0, 0 },
+          {   0, 0, 0, 0, 110, 0,   0, 0,   0, 0,   0, 0, 110, 0, 0, 70 },
+          {  90, 50, 70, 50, 90, 50, 70, 50, 90, 50, 70, 50, 90, 50, 70, 50 } },
+    };
+
+    const float tempos[]  = { 84.0f, 96.0f, 110.0f, 124.0f, 140.0f, 172.0f };
+    const float swings[]  = { 50.0f, 58.0f, 66.0f };   // MPC-style: 50 = straight, 66 ≈ triplet
+
+    const char* const noteNames[12] = { "C", "C#", "D", "D#", "E", "F", "F#", "G", "G#", "A", "A#", "B" };
+
+    struct LoopSpec
+    {
+        juce::String       name;
+        float              bpm;
+        float              swing;
+        const DrumPattern* pattern;
+        int                keyRoot;   ///< Pitch class, 0 = C
+        bool               minor;
+
+        juce::String getKeyName() const   { return juce::String (noteNames[keyRoot]) + (minor ? " minor" : " major"); }
+    };
+
+    /** Every tempo × swing × pattern, with the key stepping round the circle of
+        fifths and alternating mode so all 24 keys come up in the first 24 loops. */
+    std::vector<LoopSpec> buildCorpus()
+    {
+        std::vector<LoopSpec> corpus;
+
+        for (const auto& pattern : patterns)
+            for (auto bpm : tempos)
+                for (auto swing : swings)
+                {
+                    const int index = static_cast<int> (corpus.size());
+
+                    LoopSpec spec;
+                    spec.bpm     = bpm;
+                    spec.swing   = swing;
+                    spec.pattern = &pattern;
+                    spec.keyRoot = (index / 2 * 7) % 12;
+                    spec.minor   = (index % 2) == 1;
+                    spec.name    = juce::String (pattern.name) + "_" + juce::String (juce::roundToInt (bpm))
+                                 + "_sw" + juce::String (juce::roundToInt (swing));
+
+                    corpus.push_back (spec);
+                }
+
+        return corpus;
+    }
+
+    //==========================================================================
+    // Rendering
+    //==========================================================================
+
+    struct GroundTruth
+    {
+        std::vector<int> kick, snare, hihat;   ///< Note-on samples, ascending
+    };
+
+    /**
+     * The loop as MIDI at sample positions. Drums use the GM notes GrooveScout
+     * exports (36/38/42). The pad plays I–IV–V–I (major) or i–iv–V–i (minor),
+     * one chord per bar, released just before the bar line so note-off and the
+     * next note-on never share a timestamp.
+     */
+    void buildMidi (const LoopSpec& spec, double sampleRate, int numSamples,
+                    juce::MidiMessageSequence& drums, juce::MidiMessageSequence& pad, GroundTruth& truth)
+    {
+        const double sixteenth   = sampleRate * 60.0 / spec.bpm / 4.0;
+        const double swingDelay  = sixteenth * (2.0 * spec.swing / 100.0 - 1.0);
+        const int    noteLength  = static_cast<int> (sampleRate * 0.01);
+        const int    numBars     = static_cast<int> (std::ceil (numSamples / (sixteenth * 16.0)));
+
+        auto addHit = [&] (int note, juce::uint8 velocity, int position, std::vector<int>& hits)
+        {
+            if (velocity == 0 || position >= numSamples)
+                return;
+
+            drums.addEvent (juce::MidiMessage::noteOn (10, note, velocity), position);
+            drums.addEvent (juce::MidiMessage::noteOff (10, note), position + noteLength);
+            hits.push_back (position);
+        };
+
+        for (int bar = 0; bar < numBars; ++bar)
+        {
+            for (int step = 0; step < 16; ++step)
+            {
+                const double time     = (bar * 16 + step) * sixteenth + ((step & 1) != 0 ? swingDelay : 0.0);
+                const int    position = static_cast<int> (std::round (time));
+
+                addHit (36, spec.pattern->kick[step],  position, truth.kick);
+                addHit (38, spec.pattern->snare[step], position, truth.snare);
+                addHit (42, spec.pattern->hihat[step], position, truth.hihat);
+            }
+
+            // Progression degree (semitones above the tonic) and chord quality
+            static constexpr int degrees[4] = { 0, 5, 7, 0 };
+            const int  degree     = degrees[bar % 4];
+            const bool minorChord = spec.minor && degree != 7;   // harmonic minor: V stays major
+
+            const int root      = 48 + (spec.keyRoot + degree) % 12;
+            const int chord[3]  = { root, root + (minorChord ? 3 : 4), root + 7 };
+            const int barStart  = static_cast<int> (std::round (bar * 16 * sixteenth));
+            const int barEnd    = juce::jmin (numSamples, static_cast<int> (std::round ((bar + 1) * 16 * sixteenth)) - noteLength);
+
+            if (barStart >= numSamples)
+                break;
+
+            for (auto note : chord)
+            {
+                pad.addEvent (juce::MidiMessage::noteOn (1, note, (juce::uint8) 90), barStart);
+                pad.addEvent (juce::MidiMessage::noteOff (1, note), barEnd);
+            }
+        }
+
+        drums.sort();
+        pad.sort();
+    }
+
+    /**
+     * Plays a MIDI sequence through an instrument and adds its stereo output
+     * into out. Blocks are cut at every event, so each message is delivered at
+     * offset 0. Plugins that apply MIDI at the top of the block are then still
+     * sample-accurate, and the ground truth holds for any plugin.
+     */
+    void renderInstrument (juce::AudioPluginInstance& plugin, const juce::MidiMessageSequence& events,
+                           juce::AudioBuffer<float>& out, int maxBlockSize, float gain)
+    {
+        const int numChannels = juce::jmax (2, plugin.getTotalNumInputChannels(), plugin.getTotalNumOutputChannels());
+        const int numSamples  = out.getNumSamples();
+
+        juce::AudioBuffer<float> block (numChannels, maxBlockSize);
+        juce::MidiBuffer         midi;
+        int                      nextEvent = 0;
+
+        for (int position = 0; position < numSamples;)
+        {
+            midi.clear();
+
+            while (nextEvent < events.getNumEvents() && events.getEventTime (nextEvent) <= position)
+                midi.addEvent (events.getEventPointer (nextEvent++)->message, 0);
+
+            int end = juce::jmin (numSamples, position + maxBlockSize);
+
+            if (nextEvent < events.getNumEvents())
+                end = juce::jmin (end, static_cast<int> (events.getEventTime (nextEvent)));
+
+            const int count = end - position;
+            juce::AudioBuffer<float> view (block.getArrayOfWritePointers(), numChannels, count);
+            view.clear();
+
+            plugin.processBlock (view, midi);
+
+            for (int ch = 0; ch < 2; ++ch)
+                out.addFrom (ch, position, view, juce::jmin (ch, plugin.getTotalNumOutputChannels() - 1), 0, count, gain);
+
+            position = end;
+        }
+    }
+
+    //==========================================================================
+    // Scoring
+    //==========================================================================
+
+    /** Hits matched one-to-one within ±tolerance (both lists ascending, greedy in time). */
+    struct OnsetScore
+    {
+        int truePositives = 0, numDetected = 0, numReference = 0;
+
+        double precision() const   { return numDetected  > 0 ? (double) truePositives / numDetected  : 0.0; }
+        double recall() const      { return numReference > 0 ? (double) truePositives / numReference : 0.0; }
+
+        double fMeasure() const
+        {
+            const auto p = precision(), r = recall();
+            return (p + r) > 0.0 ? 2.0 * p * r / (p + r) : 0.0;
+        }
+
+        void add (const OnsetScore& other)
+        {
+            truePositives += other.truePositives;
+            numDetected   += other.numDetected;
+            numReference  += other.numReference;
+        }
+    };
+
+    OnsetScore scoreOnsets (const std::vector<int>& reference, const std::vector<groovescout::OnsetEvent>& detected,
+                            int toleranceSamples)
+    {
+        OnsetScore score;
+        score.numReference = static_cast<int> (reference.size());
+        score.numDetected  = static_cast<int> (detected.size());
+
+        size_t d = 0;
+
+        for (auto hit : reference)
+        {
+            while (d < detected.size() && detected[d].sampleOffset < hit - toleranceSamples)
+                ++d;
+
+            if (d < detected.size() && detected[d].sampleOffset <= hit + toleranceSamples)
+            {
+                ++score.truePositives;
+                ++d;
+            }
+        }
+
+        return score;
+    }
+
+    bool bpmMatches (float estimate, float truth, float tolerance = 0.02f)
+    {
+        return truth > 0.0f && std::abs (estimate - truth) <= tolerance * truth;
+    }
+
+    /** MIREX Acc2: also accepts the usual metrical-level confusions. */
+    bool bpmMatchesAnyOctave (float estimate, float truth)
+    {
+        for (auto factor : { 1.0f, 2.0f, 0.5f, 3.0f, 1.0f / 3.0f })
+            if (bpmMatches (estimate, truth * factor))
+                return true;
+
+        return false;
+    }
+
+    /** MIREX key score: 1 exact, 0.5 fifth, 0.3 relative, 0.2 parallel, else 0. */
+    double keyScore (const juce::String& estimate, const LoopSpec& truth)
+    {
+        const bool estimateMinor = estimate.endsWith (" minor");
+        int estimateRoot = -1;
+
+        for (int pc = 0; pc < 12; ++pc)
+            if (estimate.upToFirstOccurrenceOf (" ", false, false) == noteNames[pc])
+                estimateRoot = pc;
+
+        if (estimateRoot < 0)
+            return 0.0;
+
+        const int interval = (estimateRoot - truth.keyRoot + 12) % 12;
+
+        if (estimateMinor == truth.minor)
+        {
+            if (interval == 0)                 return 1.0;
+            if (interval == 7 || interval == 5) return 0.5;
+            return 0.0;
+        }
+
+        if (interval == 0)                                   return 0.2;
+        if (! truth.minor && estimateMinor && interval == 9) return 0.3;   // C major → A minor
+        if (truth.minor && ! estimateMinor && interval == 3) return 0.3;   // A minor → C major
+        return 0.0;
+    }
+
+    //==========================================================================
+    // Analysis
+    //==========================================================================
+
+    struct BenchOptions
+    {
+        groovescout::AnalysisSettings               settings;
+        groovescout::SpectralFrontEnd::ChromaKernel chromaKernel = groovescout::SpectralFrontEnd::ChromaKernel::constantQ36;
+        juce::ThreadPool*                           pool = nullptr;
+        int                                         runs = 3;
+    };
+
+    /** Front end + runAnalysis, as Analyze does it offline. Returns the fastest run's wall time. */
+    double analyse (const juce::AudioBuffer<float>& audio, double sampleRate, const BenchOptions& options,
+                    groovescout::AnalysisResult& result)
+    {
+        double fastestMs = std::numeric_limits<double>::max();
+
+        for (int run = 0; run < options.runs; ++run)
+        {
+            const double startMs = juce::Time::getMillisecondCounterHiRes();
+
+            groovescout::SpectralFrontEnd spectrum;
+            spectrum.reset (sampleRate, audio.getNumSamples(), options.chromaKernel);
+            groovescout::buildSpectrum (spectrum, audio, audio.getNumSamples(), 0, {});
+
+            result = groovescout::runAnalysis (spectrum, options.settings, options.pool, {});
+
+            fastestMs = juce::jmin (fastestMs, juce::Time::getMillisecondCounterHiRes() - startMs);
+        }
+
+        return fastestMs;
+    }
+
+    //==========================================================================
+    // Plugin loading (same lookup as PluginRack)
+    //==========================================================================
+
+    /** Resolves "Drum808" → <pluginDirectory>/Drum808.vst3, or accepts a full path. */
+    juce::File resolvePluginFile (const juce::String& nameOrPath, const juce::File& pluginDirectory)
+    {
+        if (juce::File::isAbsolutePath (nameOrPath))
+            return juce::File (nameOrPath);
+
+        for (auto* extension : { ".vst3", ".component" })
+        {
+            auto candidate = pluginDirectory.getChildFile (nameOrPath + extension);
+            if (candidate.exists())
+                return candidate;
+        }
+
+        return pluginDirectory.getChildFile (nameOrPath + ".vst3");
+    }
+
+    std::unique_ptr<juce::AudioPluginInstance> loadPlugin (juce::AudioPluginFormatManager& formats,
+                                                           const juce::File& file,
+                                                           double sampleRate,
+                                                           int blockSize,
+                                                           juce::String& error)
+    {
+        for (auto* format : formats.getFormats())
+        {
+            if (! format->fileMightContainThisPluginType (file.getFullPathName()))
+                continue;
+
+            juce::OwnedArray<juce::PluginDescription> types;
+            format->findAllTypesForFile (types, file.getFullPathName());
+
+            if (types.isEmpty())
+                continue;
+
+            return formats.createPluginInstance (*types.getFirst(), sampleRate, blockSize, error);
+        }
+
+        error = "no plugin format recognises " + file.getFullPathName();
+        return nullptr;
+    }
+
+    bool parseChromaKernel (const juce::String& name, groovescout::SpectralFrontEnd::ChromaKernel& kernel)
+    {
+        using Kernel = groovescout::SpectralFrontEnd::ChromaKernel;
+
+        if (name == "map")  { kernel = Kernel::pitchClassMap; return true; }
+        if (name == "cq12") { kernel = Kernel::constantQ12;   return true; }
+        if (name == "cq36") { kernel = Kernel::constantQ36;   return true; }
+
+        return false;
+    }
+
+    double roundTo (double value, double step) { return std::round (value / step) * step; }
+
+    //==========================================================================
+    // DSP kernels
+    //==========================================================================
+
+    bool parseIsa (const juce::String& name, pfs::dsp::Isa& isa)
+    {
+        for (auto candidate : { pfs::dsp::Isa::scalar, pfs::dsp::Isa::sse2, pfs::dsp::Isa::avx2, pfs::dsp::Isa::avx512 })
+        {
+            if (name == pfs::dsp::isaName (candidate))
+            {
+                isa = candidate;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /** Every wide ISA this host runs, against the scalar reference. */
+    bool checkKernels()
+    {
+        bool allAgree = true;
+        std::cout << "DSP kernels vs scalar:";
+
+        for (auto isa : { pfs::dsp::Isa::sse2, pfs::dsp::Isa::avx2, pfs::dsp::Isa::avx512 })
+        {
+            if (isa > pfs::dsp::detectIsa())
+                break;
+
+            const char* failed = pfs::dsp::checkAgainstScalar (isa);
+            std::cout << " " << pfs::dsp::isaName (isa) << (failed == nullptr ? " ok" : " FAILED");
+
+            if (failed != nullptr)
+            {
+                std::cerr << "\nGrooveScoutBench: " << pfs::dsp::isaName (isa) << " " << failed
+                          << " differs from the scalar kernel";
+                allAgree = false;
+            }
+        }
+
+        std::cout << (pfs::dsp::detectIsa() == pfs::dsp::Isa::scalar ? " (scalar only on this CPU)" : "") << std::endl;
+        return allAgree;
+    }
+}
+
+//==============================================================================
+
+int main (int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    juce::ArgumentList args (argc, argv);
+
+    if (args.containsOption ("--help|-h"))
+    {
+        std::cout << "Usage: GrooveScoutBench [--plugins=DIR] [--drums=Drum808] [--pad=LushPad]\n"
+                     "                        [--seconds=N] [--rate=HZ] [--threads=N] [--runs=N]\n"
+                     "                        [--chroma=map|cq12|cq36] [--json=FILE] [--wav=DIR]\n"
+                     "                        [--isa=scalar|sse2|avx2|avx512] [--check-kernels]" << std::endl;
+        return 1;
+    }
+
+    // -------------------------------------------------------------------------
+    // DSP kernels — verify every supported ISA, then pick the one to score
+    // -------------------------------------------------------------------------
+    if (! checkKernels())
+        return 1;
+
+    if (args.containsOption ("--check-kernels"))
+        return 0;
+
+    if (args.containsOption ("--isa"))
+    {
+        auto requested = pfs::dsp::Isa::scalar;
+
+        if (! parseIsa (args.getValueForOption ("--isa"), requested))
+        {
+            std::cerr << "GrooveScoutBench: --isa must be scalar, sse2, avx2 or avx512" << std::endl;
+            return 1;
+        }
+
+        if (pfs::dsp::forceIsa (requested) != requested)
+            std::cerr << "GrooveScoutBench: " << pfs::dsp::isaName (requested) << " is not supported here, using "
+                      << pfs::dsp::isaName (pfs::dsp::activeIsa()) << std::endl;
+    }
+
+    const juce::String pluginDirName = args.containsOption ("--plugins") ? args.getValueForOption ("--plugins")
+                                                                         : juce::String ("~/Library/Audio/Plug-Ins/VST3");
+    const juce::File   pluginDirectory = juce::File::getCurrentWorkingDirectory().getChildFile (
+                           pluginDirName.replace ("~", juce::File::getSpecialLocation (juce::File::userHomeDirectory).getFullPathName()));
+
+    const double sampleRate   = args.containsOption ("--rate") ? args.getValueForOption ("--rate").getDoubleValue() : 44100.0;
+    const double seconds      = args.containsOption ("--seconds") ? args.getValueForOption ("--seconds").getDoubleValue() : 20.0;
+    const int    numThreads   = args.containsOption ("--threads") ? juce::jmax (0, args.getValueForOption ("--threads").getIntValue()) : 0;
+    const int    maxBlockSize = 512;
+
+    BenchOptions options;
+    options.runs = args.containsOption ("--runs") ? juce::jmax (1, args.getValueForOption ("--runs").getIntValue()) : 3;
+
+    if (args.containsOption ("--chroma")
+        && ! parseChromaKernel (args.getValueForOption ("--chroma"), options.chromaKernel))
+    {
+        std::cerr << "GrooveScoutBench: --chroma must be map, cq12 or cq36" << std::endl;
+        return 1;
+    }
+
+    if (sampleRate < 8000.0 || seconds < groovescout::minimumAnalysisSeconds)
+    {
+        std::cerr << "GrooveScoutBench: need --rate >= 8000 and --seconds >= "
+                  << groovescout::minimumAnalysisSeconds << std::endl;
+        return 1;
+    }
+
+    const int numSamples = static_cast<int> (seconds * sampleRate);
+
+    // -------------------------------------------------------------------------
+    // Instruments
+    // -------------------------------------------------------------------------
+    juce::AudioPluginFormatManager formats;
+    formats.addDefaultFormats();
+
+    std::unique_ptr<juce::AudioPluginInstance> instruments[2];
+    const juce::String instrumentNames[2] = { args.containsOption ("--drums") ? args.getValueForOption ("--drums") : juce::String ("Drum808"),
+                                              args.containsOption ("--pad")   ? args.getValueForOption ("--pad")   : juce::String ("LushPad") };
+
+    for (int i = 0; i < 2; ++i)
+    {
+        juce::String error;
+        instruments[i] = loadPlugin (formats, resolvePluginFile (instrumentNames[i], pluginDirectory),
+                                     sampleRate, maxBlockSize, error);
+
+        if (instruments[i] == nullptr)
+        {
+            std::cerr << "GrooveScoutBench: failed to load " << instrumentNames[i] << ": " << error << std::endl;
+            return 1;
+        }
+
+        instruments[i]->enableAllBuses();
+        instruments[i]->setNonRealtime (true);
+    }
+
+    std::unique_ptr<juce::ThreadPool> pool;
+
+    if (numThreads > 0)
+    {
+        pool = std::make_unique<juce::ThreadPool> (juce::ThreadPoolOptions{}
+                                                       .withThreadName ("GrooveScoutBench")
+                                                       .withNumberOfThreads (numThreads));
+        options.pool = pool.get();
+    }
+
+    const juce::File wavFolder = args.containsOption ("--wav")
+                                     ? juce::File::getCurrentWorkingDirectory().getChildFile (args.getValueForOption ("--wav"))
+                                     : juce::File();
+
+    if (wavFolder != juce::File())
+        wavFolder.createDirectory();
+
+    const auto corpus = buildCorpus();
+
+    std::cout << "GrooveScoutBench: " << corpus.size() << " loops x " << seconds << " s at " << sampleRate
+              << " Hz, DSP kernels = " << pfs::dsp::isaName (pfs::dsp::activeIsa())
+              << ", stages " << (numThreads > 0 ? "on " + juce::String (numThreads) + " thread(s)" : juce::String ("in turn"))
+              << ", fastest of " << options.runs << " run(s)\n" << std::endl;
+
+    std::cout << std::left << std::setw (16) << "loop" << std::setw (14) << "key"
+              << std::right << std::setw (8) << "bpm" << std::setw (10) << "key est"
+              << std::setw (8) << "F kick" << std::setw (8) << "F snare" << std::setw (8) << "F hihat"
+              << std::setw (9) << "ms" << std::endl;
+
+    // -------------------------------------------------------------------------
+    // Render → analyse → score, one loop at a time
+    // -------------------------------------------------------------------------
+    const int toleranceSamples = static_cast<int> (0.05 * sampleRate);
+
+    juce::Array<juce::var> loopReports;
+    OnsetScore totals[3];
+    int        bpmCorrect = 0, bpmOctaveCorrect = 0, keyCorrect = 0;
+    double     keyScoreSum = 0.0, fSum[3] {}, analysisMsSum = 0.0, renderMsSum = 0.0;
+
+    for (const auto& spec : corpus)
+    {
+        juce::MidiMessageSequence drumEvents, padEvents;
+        GroundTruth truth;
+        buildMidi (spec, sampleRate, numSamples, drumEvents, padEvents, truth);
+
+        const double renderStartMs = juce::Time::getMillisecondCounterHiRes();
+
+        juce::AudioBuffer<float> audio (2, numSamples);
+        audio.clear();
+
+        const juce::MidiMessageSequence* events[2] = { &drumEvents, &padEvents };
+        const float gains[2] = { 1.0f, 0.5f };
+
+        for (int i = 0; i < 2; ++i)
+        {
+            // Re-prepare so every loop starts from silence, with no tails or voices left over
+            auto& plugin = *instruments[i];
+            plugin.releaseResources();
+            plugin.setPlayConfigDetails (plugin.getTotalNumInputChannels() > 0 ? 2 : 0, 2, sampleRate, maxBlockSize);
+            plugin.prepareToPlay (sampleRate, maxBlockSize);
+
+            renderInstrument (plugin, *events[i], audio, maxBlockSize, gains[i]);
+        }
+
+        renderMsSum += juce::Time::getMillisecondCounterHiRes() - renderStartMs;
+
+        if (wavFolder != juce::File())
+        {
+            const auto wavFile = wavFolder.getChildFile (spec.name + ".wav");
+            wavFile.deleteFile();
+
+            juce::WavAudioFormat wav;
+            std::unique_ptr<juce::OutputStream> stream (wavFile.createOutputStream());
+
+            if (stream != nullptr)
+                if (std::unique_ptr<juce::AudioFormatWriter> writer { wav.createWriterFor (stream.get(), sampleRate, 2, 24, {}, 0) })
+                {
+                    stream.release();
+                    writer->writeFromAudioSampleBuffer (audio, 0, numSamples);
+                }
+        }
+
+        // ---------------------------------------------------------------------
+        groovescout::AnalysisResult result;
+        const double analysisMs = analyse (audio, sampleRate, options, result);
+
+        const bool   bpmOk       = bpmMatches (result.bpm, spec.bpm);
+        const bool   bpmOctaveOk = bpmMatchesAnyOctave (result.bpm, spec.bpm);
+        const double keyPoints   = keyScore (result.key, spec);
+
+        const OnsetScore bands[3] = { scoreOnsets (truth.kick,  result.kickOnsets,  toleranceSamples),
+                                      scoreOnsets (truth.snare, result.snareOnsets, toleranceSamples),
+                                      scoreOnsets (truth.hihat, result.hihatOnsets, toleranceSamples) };
+
+        bpmCorrect       += bpmOk ? 1 : 0;
+        bpmOctaveCorrect += bpmOctaveOk ? 1 : 0;
+        keyCorrect       += keyPoints == 1.0 ? 1 : 0;
+        keyScoreSum      += keyPoints;
+        analysisMsSum    += analysisMs;
+
+        for (int b = 0; b < 3; ++b)
+        {
+            totals[b].add (bands[b]);
+            fSum[b] += bands[b].fMeasure();
+        }
+
+        std::cout << std::left << std::setw (16) << spec.name << std::setw (14) << spec.getKeyName()
+                  << std::right << std::fixed << std::setprecision (1)
+                  << std::setw (7) << result.bpm << (bpmOk ? " " : (bpmOctaveOk ? "~" : "x"))
+                  << std::setw (10) << (keyPoints == 1.0 ? "ok" : result.key.toStdString())
+                  << std::setprecision (2)
+                  << std::setw (8) << bands[0].fMeasure() << std::setw (8) << bands[1].fMeasure() << std::setw (8) << bands[2].fMeasure()
+                  << std::setprecision (1) << std::setw (9) << analysisMs << std::endl;
+
+        auto* report = new juce::DynamicObject();
+        report->setProperty ("name", spec.name);
+        report->setProperty ("bpm", spec.bpm);
+        report->setProperty ("swing", spec.swing);
+        report->setProperty ("key", spec.getKeyName());
+        report->setProperty ("bpmEstimate", roundTo (result.bpm, 0.01));
+        report->setProperty ("keyEstimate", result.key);
+        report->setProperty ("keyScore", keyPoints);
+
+        auto* onsets = new juce::DynamicObject();
+        const char* bandNames[3] = { "kick", "snare", "hihat" };
+
+        for (int b = 0; b < 3; ++b)
+        {
+            auto* band = new juce::DynamicObject();
+            band->setProperty ("reference", bands[b].numReference);
+            band->setProperty ("detected", bands[b].numDetected);
+            band->setProperty ("matched", bands[b].truePositives);
+            band->setProperty ("f", roundTo (bands[b].fMeasure(), 0.001));
+            onsets->setProperty (bandNames[b], juce::var (band));
+        }
+
+        report->setProperty ("onsets", juce::var (onsets));
+        report->setProperty ("analysisMs", roundTo (analysisMs, 0.01));
+        loopReports.add (juce::var (report));
+    }
+
+    for (auto& instrument : instruments)
+        instrument->releaseResources();
+
+    // -------------------------------------------------------------------------
+    // Summary
+    // -------------------------------------------------------------------------
+    const double numLoops       = static_cast<double> (corpus.size());
+    const double audioMinutes   = numLoops * seconds / 60.0;
+    const double msPerMinute    = analysisMsSum / audioMinutes;
+
+    std::cout << "\nBPM      " << std::setprecision (1) << 100.0 * bpmCorrect / numLoops << "% within 2%, "
+              << 100.0 * bpmOctaveCorrect / numLoops << "% allowing 1/3, 1/2, 2x, 3x\n"
+              << "Key      " << 100.0 * keyCorrect / numLoops << "% exact, MIREX score "
+              << std::setprecision (3) << keyScoreSum / numLoops << "\n"
+              << "Onsets   F (mean / pooled):  kick " << fSum[0] / numLoops << " / " << totals[0].fMeasure()
+              << ",  snare " << fSum[1] / numLoops << " / " << totals[1].fMeasure()
+              << ",  hihat " << fSum[2] / numLoops << " / " << totals[2].fMeasure() << "\n"
+              << "Speed    " << std::setprecision (1) << msPerMinute << " ms of analysis per minute of audio ("
+              << audioMinutes << " min rendered in " << renderMsSum / 1000.0 << " s)" << std::endl;
+
+    if (args.containsOption ("--json"))
+    {
+        auto* summary = new juce::DynamicObject();
+        summary->setProperty ("bpmAccuracy", roundTo (bpmCorrect / numLoops, 0.001));
+        summary->setProperty ("bpmAccuracyAnyOctave", roundTo (bpmOctaveCorrect / numLoops, 0.001));
+        summary->setProperty ("keyAccuracy", roundTo (keyCorrect / numLoops, 0.001));
+        summary->setProperty ("keyScore", roundTo (keyScoreSum / numLoops, 0.001));
+        summary->setProperty ("kickF", roundTo (fSum[0] / numLoops, 0.001));
+        summary->setProperty ("snareF", roundTo (fSum[1] / numLoops, 0.001));
+        summary->setProperty ("hihatF", roundTo (fSum[2] / numLoops, 0.001));
+        summary->setProperty ("analysisMsPerMinute", roundTo (msPerMinute, 0.1));
+
+        auto* json = new juce::DynamicObject();
+        json->setProperty ("isa", pfs::dsp::isaName (pfs::dsp::activeIsa()));
+        json->setProperty ("sampleRate", sampleRate);
+        json->setProperty ("secondsPerLoop", seconds);
+        json->setProperty ("threads", numThreads);
+        json->setProperty ("runs", options.runs);
+        json->setProperty ("summary", juce::var (summary));
+        json->setProperty ("loops", loopReports);
+
+        const auto jsonFile = juce::File::getCurrentWorkingDirectory().getChildFile (args.getValueForOption ("--json"));
+
+        if (! jsonFile.replaceWithText (juce::JSON::toString (juce::var (json))))
+        {
+            std::cerr << "GrooveScoutBench: could not write " << jsonFile.getFullPathName() << std::endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
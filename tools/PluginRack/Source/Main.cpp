@@ -0,0 +1,283 @@
+//==============================================================================
+// PluginRack — standalone live-rig host
+//
+// Usage:
+//   PluginRack <rack.json> [--seconds=N] [--threads=N] [--list]
+//
+// Loads the plugins named in the rack description in-process, wires them as a
+// DAG (see Racks/*.json), opens the default audio device and runs until
+// Ctrl-C (or for --seconds=N). Independent branches are processed in parallel
+// every callback by RackScheduler.
+//==============================================================================
+
+#include <juce_audio_devices/juce_audio_devices.h>
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <juce_events/juce_events.h>
+
+#include "RackGraph.h"
+#include "RackScheduler.h"
+
+#include <csignal>
+#include <iostream>
+
+namespace
+{
+    std::atomic<bool> quitRequested { false };
+
+    void handleSignal (int) { quitRequested.store (true); }
+
+    //==========================================================================
+    /** Resolves "GainKnob" → <pluginDirectory>/GainKnob.vst3, or accepts a full path. */
+    juce::File resolvePluginFile (const juce::String& nameOrPath, const juce::File& pluginDirectory)
+    {
+        if (juce::File::isAbsolutePath (nameOrPath))
+            return juce::File (nameOrPath);
+
+        for (auto* extension : { ".vst3", ".component" })
+        {
+            auto candidate = pluginDirectory.getChildFile (nameOrPath + extension);
+            if (candidate.exists())
+                return candidate;
+        }
+
+        return pluginDirectory.getChildFile (nameOrPath + ".vst3");
+    }
+
+    std::unique_ptr<juce::AudioPluginInstance> loadPlugin (juce::AudioPluginFormatManager& formats,
+                                                           const juce::File& file,
+                                                           double sampleRate,
+                                                           int blockSize,
+                                                           juce::String& error)
+    {
+        for (auto* format : formats.getFormats())
+        {
+            if (! format->fileMightContainThisPluginType (file.getFullPathName()))
+                continue;
+
+            juce::OwnedArray<juce::PluginDescription> types;
+            format->findAllTypesForFile (types, file.getFullPathName());
+
+            if (types.isEmpty())
+                continue;
+
+            return formats.createPluginInstance (*types.getFirst(), sampleRate, blockSize, error);
+        }
+
+        error = "no plugin format recognises " + file.getFullPathName();
+        return nullptr;
+    }
+
+    //==========================================================================
+    /** Device callback — splits oversized device blocks so the graph never exceeds its prepared size. */
+    class RackCallback : public juce::AudioIODeviceCallback
+    {
+    public:
+        RackCallback (RackGraph& g, RackScheduler& s, juce::MidiMessageCollector& m, int maxBlock)
+            : graph (g), scheduler (s), midiCollector (m), maxBlockSize (maxBlock)
+        {
+            midiBlock.ensureSize (4096);
+        }
+
+        void audioDeviceIOCallbackWithContext (const float* const* inputChannelData,
+                                               int numInputChannels,
+                                               float* const* outputChannelData,
+                                               int numOutputChannels,
+                                               int numSamples,
+                                               const juce::AudioIODeviceCallbackContext&) override
+        {
+            juce::ScopedNoDenormals noDenormals;
+
+            numInputChannels  = juce::jmin (numInputChannels,  maxChannels);
+            numOutputChannels = juce::jmin (numOutputChannels, maxChannels);
+
+            for (int offset = 0; offset < numSamples; offset += maxBlockSize)
+            {
+                const int chunk = juce::jmin (maxBlockSize, numSamples - offset);
+
+                for (int ch = 0; ch < numInputChannels; ++ch)
+                    inputChunk[ch] = inputChannelData[ch] != nullptr ? inputChannelData[ch] + offset : nullptr;
+
+                for (int ch = 0; ch < numOutputChannels; ++ch)
+                    outputChunk[ch] = outputChannelData[ch] != nullptr ? outputChannelData[ch] + offset : nullptr;
+
+                midiCollector.removeNextBlockOfMessages (midiBlock, chunk);
+
+                graph.setDeviceInput (inputChunk, numInputChannels);
+                graph.setDeviceMidi (midiBlock);
+                scheduler.runCycle (chunk);
+                graph.mixSinksInto (outputChunk, numOutputChannels, chunk);
+            }
+        }
+
+        void audioDeviceAboutToStart (juce::AudioIODevice*) override {}
+        void audioDeviceStopped() override {}
+
+    private:
+        static constexpr int maxChannels = 32;
+
+        RackGraph&                  graph;
+        RackScheduler&              scheduler;
+        juce::MidiMessageCollector& midiCollector;
+        const int                   maxBlockSize;
+
+        juce::MidiBuffer midiBlock;
+        const float*     inputChunk[maxChannels]  {};
+        float*           outputChunk[maxChannels] {};
+    };
+}
+
+//==============================================================================
+
+int main (int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    juce::ArgumentList args (argc, argv);
+
+    if (args.size() == 0 || args.containsOption ("--help|-h"))
+    {
+        std::cout << "Usage: PluginRack <rack.json> [--seconds=N] [--threads=N] [--list]" << std::endl;
+        return 1;
+    }
+
+    const juce::File rackFile = args[0].resolveAsExistingFile();
+    const juce::var  rack     = juce::JSON::parse (rackFile);
+
+    if (! rack.isObject())
+    {
+        std::cerr << "PluginRack: could not parse " << rackFile.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    // -------------------------------------------------------------------------
+    // Audio device — opened first so plugins are created at the real rate/size
+    // -------------------------------------------------------------------------
+    juce::AudioDeviceManager deviceManager;
+    const auto deviceError = deviceManager.initialiseWithDefaultDevices (2, 2);
+
+    auto* device = deviceManager.getCurrentAudioDevice();
+    if (deviceError.isNotEmpty() || device == nullptr)
+    {
+        std::cerr << "PluginRack: no audio device (" << deviceError << ")" << std::endl;
+        return 1;
+    }
+
+    const double sampleRate = device->getCurrentSampleRate();
+    const int    blockSize  = device->getCurrentBufferSizeSamples();
+
+    // -------------------------------------------------------------------------
+    // Plugins → graph nodes
+    // -------------------------------------------------------------------------
+    juce::AudioPluginFormatManager formats;
+    formats.addDefaultFormats();
+
+    const juce::String defaultPluginDir = rack.getProperty ("pluginDirectory", "~/Library/Audio/Plug-Ins/VST3").toString();
+    const juce::File   pluginDirectory  = juce::File (defaultPluginDir.replace ("~", juce::File::getSpecialLocation (juce::File::userHomeDirectory).getFullPathName()));
+
+    RackGraph graph;
+
+    if (auto* nodeList = rack["nodes"].getArray())
+    {
+        for (const auto& nodeDesc : *nodeList)
+        {
+            const juce::String id         = nodeDesc["id"].toString();
+            const juce::File   pluginFile = resolvePluginFile (nodeDesc["plugin"].toString(), pluginDirectory);
+
+            juce::String error;
+            auto plugin = loadPlugin (formats, pluginFile, sampleRate, blockSize, error);
+
+            if (plugin == nullptr)
+            {
+                std::cerr << "PluginRack: failed to load '" << id << "': " << error << std::endl;
+                return 1;
+            }
+
+            // Optional initial parameter values, by parameter name → normalised value
+            if (auto* params = nodeDesc["parameters"].getDynamicObject())
+                for (auto* param : plugin->getParameters())
+                    if (params->hasProperty (param->getName (64)))
+                        param->setValueNotifyingHost (static_cast<float> (params->getProperty (param->getName (64))));
+
+            graph.addNode (id, std::move (plugin));
+        }
+    }
+
+    if (auto* connections = rack["connections"].getArray())
+    {
+        for (const auto& edge : *connections)
+        {
+            if (! graph.connect (edge[0].toString(), edge[1].toString()))
+            {
+                std::cerr << "PluginRack: invalid connection " << edge[0].toString()
+                          << " -> " << edge[1].toString() << " (unknown node or cycle)" << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    if (graph.getNumNodes() == 0)
+    {
+        std::cerr << "PluginRack: rack has no nodes" << std::endl;
+        return 1;
+    }
+
+    // -------------------------------------------------------------------------
+    // Prepare graph + scheduler
+    // -------------------------------------------------------------------------
+    const int defaultThreads = juce::jmin (graph.getNumNodes() - 1,
+                                           juce::jmax (0, juce::SystemStats::getNumPhysicalCpus() - 1));
+    const int numThreads     = args.containsOption ("--threads")
+                                   ? juce::jmax (0, args.getValueForOption ("--threads").getIntValue())
+                                   : static_cast<int> (rack.getProperty ("threads", defaultThreads));
+
+    graph.prepare (sampleRate, blockSize, 2);
+
+    RackScheduler scheduler (graph);
+    scheduler.prepare (numThreads);
+
+    std::cout << "PluginRack: " << device->getName() << " @ " << sampleRate << " Hz, "
+              << blockSize << " samples, " << numThreads << " helper thread(s), "
+              << graph.getNumBufferSlots() << " buffer slot(s)" << std::endl
+              << graph.describe() << std::endl;
+
+    if (args.containsOption ("--list"))
+        return 0;
+
+    // -------------------------------------------------------------------------
+    // MIDI in → every node that accepts MIDI (e.g. Drum808, LushPad)
+    // -------------------------------------------------------------------------
+    juce::MidiMessageCollector midiCollector;
+    midiCollector.reset (sampleRate);
+
+    for (const auto& midiInput : juce::MidiInput::getAvailableDevices())
+        deviceManager.setMidiInputDeviceEnabled (midiInput.identifier, true);
+
+    deviceManager.addMidiInputDeviceCallback ({}, &midiCollector);
+
+    RackCallback callback (graph, scheduler, midiCollector, blockSize);
+    deviceManager.addAudioCallback (&callback);
+
+    // -------------------------------------------------------------------------
+    // Run until Ctrl-C or --seconds elapses
+    // -------------------------------------------------------------------------
+    std::signal (SIGINT,  handleSignal);
+    std::signal (SIGTERM, handleSignal);
+
+    const double runSeconds = args.getValueForOption ("--seconds").getDoubleValue();
+    const auto   startTime  = juce::Time::getMillisecondCounterHiRes();
+
+    while (! quitRequested.load())
+    {
+        juce::MessageManager::getInstance()->runDispatchLoopUntil (100);
+
+        if (runSeconds > 0.0 && juce::Time::getMillisecondCounterHiRes() - startTime > runSeconds * 1000.0)
+            break;
+    }
+
+    deviceManager.removeAudioCallback (&callback);
+    deviceManager.removeMidiInputDeviceCallback ({}, &midiCollector);
+    scheduler.shutdown();
+    graph.release();
+
+    return 0;
+}
@@ -0,0 +1,238 @@
+#include "RackGraph.h"
+
+#include <algorithm>
+
+//==============================================================================
+// Topology building — message thread only
+//==============================================================================
+
+int RackGraph::addNode (const juce::String& nodeId, std::unique_ptr<juce::AudioPluginInstance> plugin)
+{
+    jassert (findNode (nodeId) < 0);
+
+    Node node;
+    node.id     = nodeId;
+    node.plugin = std::move (plugin);
+    nodes.push_back (std::move (node));
+    return static_cast<int> (nodes.size()) - 1;
+}
+
+int RackGraph::findNode (const juce::String& nodeId) const
+{
+    for (size_t i = 0; i < nodes.size(); ++i)
+        if (nodes[i].id == nodeId)
+            return static_cast<int> (i);
+
+    return -1;
+}
+
+bool RackGraph::reaches (int from, int to) const
+{
+    // Depth-first walk along outputs — graphs here are a handful of nodes
+    std::vector<int> stack { from };
+    std::vector<bool> seen (nodes.size(), false);
+
+    while (! stack.empty())
+    {
+        const int n = stack.back();
+        stack.pop_back();
+
+        if (n == to)
+            return true;
+
+        if (seen[(size_t) n])
+            continue;
+
+        seen[(size_t) n] = true;
+
+        for (int next : nodes[(size_t) n].outputs)
+            stack.push_back (next);
+    }
+
+    return false;
+}
+
+bool RackGraph::connect (const juce::String& sourceId, const juce::String& destId)
+{
+    const int src = findNode (sourceId);
+    const int dst = findNode (destId);
+
+    if (src < 0 || dst < 0 || src == dst)
+        return false;
+
+    // Reject edges that would close a cycle (dst already reaches src)
+    if (reaches (dst, src))
+        return false;
+
+    auto& outs = nodes[(size_t) src].outputs;
+    if (std::find (outs.begin(), outs.end(), dst) != outs.end())
+        return true;  // duplicate edge — already connected
+
+    outs.push_back (dst);
+    nodes[(size_t) dst].inputs.push_back (src);
+    return true;
+}
+
+//==============================================================================
+// Prepare / release
+//==============================================================================
+
+void RackGraph::prepare (double sampleRate, int maxBlockSize, int numChannels)
+{
+    channels = numChannels;
+
+    // Kahn topological order — slot assignment must see sources before consumers
+    std::vector<int> pending (nodes.size());
+    std::vector<int> order;
+    order.reserve (nodes.size());
+
+    for (size_t i = 0; i < nodes.size(); ++i)
+    {
+        pending[i] = static_cast<int> (nodes[i].inputs.size());
+        if (pending[i] == 0)
+            order.push_back (static_cast<int> (i));
+    }
+
+    for (size_t head = 0; head < order.size(); ++head)
+        for (int next : nodes[(size_t) order[head]].outputs)
+            if (--pending[(size_t) next] == 0)
+                order.push_back (next);
+
+    jassert (order.size() == nodes.size());  // connect() rejects cycles
+
+    // Assign buffer slots — alias the source slot wherever the hand-off is 1:1
+    int numSlots = 0;
+
+    for (int index : order)
+    {
+        auto& node = nodes[(size_t) index];
+
+        if (node.inputs.size() == 1
+            && nodes[(size_t) node.inputs.front()].outputs.size() == 1)
+        {
+            node.slot    = nodes[(size_t) node.inputs.front()].slot;
+            node.inPlace = true;
+        }
+        else
+        {
+            node.slot    = numSlots++;
+            node.inPlace = false;
+        }
+    }
+
+    slots.clear();
+    slots.resize ((size_t) numSlots);
+    for (auto& slot : slots)
+        slot.setSize (channels, maxBlockSize, false, true, false);
+
+    for (auto& node : nodes)
+    {
+        node.plugin->setPlayConfigDetails (node.plugin->getTotalNumInputChannels() > 0 ? channels : 0,
+                                           channels, sampleRate, maxBlockSize);
+        node.plugin->prepareToPlay (sampleRate, maxBlockSize);
+        node.midi.ensureSize (4096);
+    }
+}
+
+void RackGraph::release()
+{
+    for (auto& node : nodes)
+        node.plugin->releaseResources();
+}
+
+//==============================================================================
+// Audio thread
+//==============================================================================
+
+void RackGraph::setDeviceInput (const float* const* input, int numInputChannels)
+{
+    deviceInput         = input;
+    deviceInputChannels = numInputChannels;
+}
+
+void RackGraph::processNode (int nodeIndex, int numSamples)
+{
+    auto& node = nodes[(size_t) nodeIndex];
+    auto& slot = slots[(size_t) node.slot];
+
+    if (node.inputs.empty())
+    {
+        // Root — start from the device input
+        for (int ch = 0; ch < channels; ++ch)
+        {
+            if (deviceInput != nullptr && ch < deviceInputChannels && deviceInput[ch] != nullptr)
+                slot.copyFrom (ch, 0, deviceInput[ch], numSamples);
+            else
+                slot.clear (ch, 0, numSamples);
+        }
+    }
+    else if (! node.inPlace)
+    {
+        // Fan-in or fan-out source — gather into our own slot
+        const auto& first = slots[(size_t) nodes[(size_t) node.inputs.front()].slot];
+        for (int ch = 0; ch < channels; ++ch)
+            slot.copyFrom (ch, 0, first, ch, 0, numSamples);
+
+        for (size_t i = 1; i < node.inputs.size(); ++i)
+        {
+            const auto& other = slots[(size_t) nodes[(size_t) node.inputs[i]].slot];
+            for (int ch = 0; ch < channels; ++ch)
+                slot.addFrom (ch, 0, other, ch, 0, numSamples);
+        }
+    }
+    // else: in place — the source already left its output in our slot
+
+    node.midi.clear();
+    if (deviceMidi != nullptr && node.plugin->acceptsMidi())
+        node.midi.addEvents (*deviceMidi, 0, numSamples, 0);
+
+    // Non-owning view over the slot: the referencing constructor uses the
+    // buffer's inline channel table, so no allocation happens here.
+    juce::AudioBuffer<float> view (slot.getArrayOfWritePointers(), channels, numSamples);
+
+    if (node.plugin->isSuspended())
+        view.clear();
+    else
+        node.plugin->processBlock (view, node.midi);
+}
+
+void RackGraph::mixSinksInto (float* const* output, int numOutputChannels, int numSamples) const
+{
+    for (int ch = 0; ch < numOutputChannels; ++ch)
+        if (output[ch] != nullptr)
+            juce::FloatVectorOperations::clear (output[ch], numSamples);
+
+    for (const auto& node : nodes)
+    {
+        if (! node.outputs.empty())
+            continue;
+
+        const auto& slot = slots[(size_t) node.slot];
+        for (int ch = 0; ch < juce::jmin (numOutputChannels, channels); ++ch)
+            if (output[ch] != nullptr)
+                juce::FloatVectorOperations::add (output[ch], slot.getReadPointer (ch), numSamples);
+    }
+}
+
+//==============================================================================
+
+juce::String RackGraph::describe() const
+{
+    juce::String text;
+
+    for (const auto& node : nodes)
+    {
+        text << node.id << " (" << node.plugin->getName() << ") slot " << node.slot
+             << (node.inPlace ? " [in place]" : "") << " ->";
+
+        if (node.outputs.empty())
+            text << " OUT";
+
+        for (int out : node.outputs)
+            text << " " << nodes[(size_t) out].id;
+
+        text << juce::newLine;
+    }
+
+    return text;
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+
+#include <atomic>
+#include <vector>
+
+//==============================================================================
+/**
+ * RackGraph — a fixed DAG of hosted plugin instances
+ *
+ * Built once on the message thread from a rack description, then prepared
+ * for a given sample rate / block size. After prepare() the topology is
+ * frozen: processNode() never allocates and may be called from any thread,
+ * as long as every input of a node has finished before the node runs
+ * (RackScheduler guarantees that ordering).
+ *
+ * Buffer plan (zero-copy hand-off):
+ *   - A node with exactly one input, whose source feeds nobody else,
+ *     processes in place on its source's buffer slot — no copy at all.
+ *   - A node with several inputs owns a slot and sums its inputs into it.
+ *   - A node whose source fans out to several consumers owns a slot and
+ *     copies the source once (the source slot must stay intact for siblings).
+ *   - Root nodes (no inputs) read the device input; sink nodes (no outputs)
+ *     are summed into the device output by the caller via mixSinksInto().
+ */
+class RackGraph
+{
+public:
+    RackGraph() = default;
+
+    /** Adds a hosted plugin as a node. Returns the node index. */
+    int addNode (const juce::String& nodeId, std::unique_ptr<juce::AudioPluginInstance> plugin);
+
+    /** Connects source → destination. Returns false on unknown ids, self-loops or cycles. */
+    bool connect (const juce::String& sourceId, const juce::String& destId);
+
+    /** Sizes all buffer slots and prepares every plugin. Message thread only. */
+    void prepare (double sampleRate, int maxBlockSize, int numChannels);
+    void release();
+
+    //==========================================================================
+    // Audio-thread API (no allocation, no locks)
+    //==========================================================================
+
+    /** Latches the device input pointers for this callback. */
+    void setDeviceInput (const float* const* input, int numInputChannels);
+
+    /** Latches the device MIDI for this callback; copied into every node that accepts MIDI. */
+    void setDeviceMidi (const juce::MidiBuffer& midi) { deviceMidi = &midi; }
+
+    /** Runs one node. All of its inputs must already have been processed. */
+    void processNode (int nodeIndex, int numSamples);
+
+    /** Sums all sink node outputs into the device output (clears it first). */
+    void mixSinksInto (float* const* output, int numOutputChannels, int numSamples) const;
+
+    //==========================================================================
+    // Topology queries (valid after prepare())
+    //==========================================================================
+
+    int getNumNodes() const                                 { return static_cast<int> (nodes.size()); }
+    int getNumInputs (int nodeIndex) const                  { return static_cast<int> (nodes[(size_t) nodeIndex].inputs.size()); }
+    const std::vector<int>& getOutputs (int nodeIndex) const { return nodes[(size_t) nodeIndex].outputs; }
+    int getNumBufferSlots() const                           { return static_cast<int> (slots.size()); }
+    juce::String describe() const;
+
+private:
+    struct Node
+    {
+        juce::String                               id;
+        std::unique_ptr<juce::AudioPluginInstance> plugin;
+        std::vector<int>                           inputs;
+        std::vector<int>                           outputs;
+        int                                        slot      = -1;
+        bool                                       inPlace   = false;  ///< aliases its single source's slot
+        juce::MidiBuffer                           midi;
+    };
+
+    int  findNode (const juce::String& nodeId) const;
+    bool reaches (int from, int to) const;
+
+    std::vector<Node>                      nodes;
+    std::vector<juce::AudioBuffer<float>>  slots;
+    int                                    channels = 2;
+
+    const float* const* deviceInput   = nullptr;
+    int                 deviceInputChannels = 0;
+    const juce::MidiBuffer* deviceMidi = nullptr;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RackGraph)
+};
@@ -0,0 +1,205 @@
+#include "RackScheduler.h"
+
+#include <thread>
+
+//==============================================================================
+// Worker — sleeps between callbacks, helps drain the graph when woken
+//==============================================================================
+
+class RackScheduler::Worker : public juce::Thread
+{
+public:
+    Worker (RackScheduler& s, int index)
+        : juce::Thread ("PluginRack worker " + juce::String (index)), scheduler (s), workerIndex (index)
+    {
+    }
+
+    ~Worker() override
+    {
+        stop();
+    }
+
+    void wake()
+    {
+        wakeEvent.signal();
+    }
+
+    void stop()
+    {
+        signalThreadShouldExit();
+        wakeEvent.signal();
+        stopThread (2000);
+    }
+
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            wakeEvent.wait (-1);
+
+            if (threadShouldExit())
+                break;
+
+            scheduler.workUntilCycleDone (workerIndex);
+        }
+    }
+
+private:
+    RackScheduler&      scheduler;
+    const int           workerIndex;
+    juce::WaitableEvent wakeEvent;
+};
+
+//==============================================================================
+// ReadyDeque — fixed-capacity ring, owner works the back, thieves take the front
+//==============================================================================
+
+void RackScheduler::ReadyDeque::reset (int capacity)
+{
+    items.assign ((size_t) juce::jmax (1, capacity), -1);
+    head  = 0;
+    count = 0;
+}
+
+void RackScheduler::ReadyDeque::pushBack (int nodeIndex)
+{
+    const juce::SpinLock::ScopedLockType sl (lock);
+    jassert (count < (int) items.size());
+
+    items[(size_t) ((head + count) % (int) items.size())] = nodeIndex;
+    ++count;
+}
+
+bool RackScheduler::ReadyDeque::popBack (int& nodeIndex)
+{
+    const juce::SpinLock::ScopedLockType sl (lock);
+    if (count == 0)
+        return false;
+
+    --count;
+    nodeIndex = items[(size_t) ((head + count) % (int) items.size())];
+    return true;
+}
+
+bool RackScheduler::ReadyDeque::stealFront (int& nodeIndex)
+{
+    const juce::SpinLock::ScopedTryLockType sl (lock);
+    if (! sl.isLocked() || count == 0)
+        return false;
+
+    nodeIndex = items[(size_t) head];
+    head = (head + 1) % (int) items.size();
+    --count;
+    return true;
+}
+
+//==============================================================================
+// Scheduler
+//==============================================================================
+
+RackScheduler::RackScheduler (RackGraph& graphToRun)
+    : graph (graphToRun)
+{
+}
+
+RackScheduler::~RackScheduler()
+{
+    shutdown();
+}
+
+void RackScheduler::prepare (int numWorkerThreads)
+{
+    shutdown();
+
+    const int numNodes = graph.getNumNodes();
+
+    pendingInputs = std::make_unique<std::atomic<int>[]> ((size_t) juce::jmax (1, numNodes));
+
+    deques.clear();
+    for (int i = 0; i <= numWorkerThreads; ++i)
+    {
+        deques.push_back (std::make_unique<ReadyDeque>());
+        deques.back()->reset (numNodes);
+    }
+
+    for (int i = 1; i <= numWorkerThreads; ++i)
+    {
+        workers.push_back (std::make_unique<Worker> (*this, i));
+        workers.back()->startThread (juce::Thread::Priority::highest);
+    }
+}
+
+void RackScheduler::shutdown()
+{
+    for (auto& worker : workers)
+        worker->stop();
+
+    workers.clear();
+}
+
+void RackScheduler::runCycle (int numSamples)
+{
+    const int numNodes = graph.getNumNodes();
+    if (numNodes == 0)
+        return;
+
+    cycleSamples.store (numSamples, std::memory_order_relaxed);
+
+    for (int i = 0; i < numNodes; ++i)
+        pendingInputs[(size_t) i].store (graph.getNumInputs (i), std::memory_order_relaxed);
+
+    nodesRemaining.store (numNodes, std::memory_order_release);
+
+    // Seed the roots round-robin so independent chains start on different cores
+    int target = 0;
+    for (int i = 0; i < numNodes; ++i)
+    {
+        if (graph.getNumInputs (i) == 0)
+        {
+            deques[(size_t) target]->pushBack (i);
+            target = (target + 1) % (int) deques.size();
+        }
+    }
+
+    for (auto& worker : workers)
+        worker->wake();
+
+    // The audio thread is worker 0 — it never just waits for the helpers
+    workUntilCycleDone (0);
+}
+
+bool RackScheduler::takeWork (int workerIndex, int& nodeIndex)
+{
+    if (deques[(size_t) workerIndex]->popBack (nodeIndex))
+        return true;
+
+    const int numDeques = (int) deques.size();
+    for (int offset = 1; offset < numDeques; ++offset)
+        if (deques[(size_t) ((workerIndex + offset) % numDeques)]->stealFront (nodeIndex))
+            return true;
+
+    return false;
+}
+
+void RackScheduler::workUntilCycleDone (int workerIndex)
+{
+    while (nodesRemaining.load (std::memory_order_acquire) > 0)
+    {
+        int nodeIndex = -1;
+
+        if (! takeWork (workerIndex, nodeIndex))
+        {
+            // Nothing ready yet — an upstream node is still running elsewhere
+            std::this_thread::yield();
+            continue;
+        }
+
+        graph.processNode (nodeIndex, cycleSamples.load (std::memory_order_relaxed));
+
+        for (int next : graph.getOutputs (nodeIndex))
+            if (pendingInputs[(size_t) next].fetch_sub (1, std::memory_order_acq_rel) == 1)
+                deques[(size_t) workerIndex]->pushBack (next);
+
+        nodesRemaining.fetch_sub (1, std::memory_order_acq_rel);
+    }
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "RackGraph.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+//==============================================================================
+/**
+ * RackScheduler — per-callback parallel execution of a RackGraph
+ *
+ * Work-stealing pool:
+ *   - Every worker (plus the audio thread itself, as worker 0) owns a small
+ *     fixed-capacity deque of ready node indices.
+ *   - A worker pops from the back of its own deque; when that is empty it
+ *     steals from the front of another worker's deque.
+ *   - When a node finishes, each successor's pending-input counter is
+ *     decremented; a successor that reaches zero is pushed onto the finishing
+ *     worker's own deque, so a straight chain stays on one core (cache-hot)
+ *     while independent branches spread out through stealing.
+ *
+ * Real-time contract for runCycle():
+ *   - No allocation: deques, counters and worker events are sized in prepare().
+ *   - Deque access is guarded by juce::SpinLock held for a handful of
+ *     instructions only.
+ *   - runCycle() returns only after every node has been processed, so the
+ *     caller can read the sink buffers immediately.
+ */
+class RackScheduler
+{
+public:
+    explicit RackScheduler (RackGraph& graphToRun);
+    ~RackScheduler();
+
+    /** Sizes queues for the graph and starts numWorkerThreads helpers (0 = serial). */
+    void prepare (int numWorkerThreads);
+
+    /** Stops and joins all helper threads. */
+    void shutdown();
+
+    /** Processes the whole graph for one audio callback. Audio thread only. */
+    void runCycle (int numSamples);
+
+private:
+    class Worker;
+
+    struct ReadyDeque
+    {
+        juce::SpinLock   lock;
+        std::vector<int> items;   ///< ring storage, capacity == number of nodes
+        int              head  = 0;
+        int              count = 0;
+
+        void reset (int capacity);
+        void pushBack (int nodeIndex);
+        bool popBack (int& nodeIndex);
+        bool stealFront (int& nodeIndex);
+    };
+
+    /** Executes ready nodes until the cycle is complete. Shared by the audio thread and workers. */
+    void workUntilCycleDone (int workerIndex);
+    bool takeWork (int workerIndex, int& nodeIndex);
+
+    RackGraph& graph;
+
+    std::vector<std::unique_ptr<ReadyDeque>> deques;        ///< index 0 = audio thread
+    std::vector<std::unique_ptr<Worker>>     workers;       ///< helper threads 1..N
+    std::unique_ptr<std::atomic<int>[]>      pendingInputs; ///< per node, reset each cycle
+
+    std::atomic<int> nodesRemaining { 0 };
+    std::atomic<int> cycleSamples   { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RackScheduler)
+};